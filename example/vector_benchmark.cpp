@@ -0,0 +1,152 @@
+/*!
+  \file vector_benchmark.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+// Standard C++ library
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+// Zisc
+#include "zisc/utility.hpp"
+// Zinvul
+#include "zinvul/cppcl/types.hpp"
+#include "zinvul/cppcl/vector.hpp"
+#include "zinvul/cppcl/vector_simd.hpp"
+
+namespace {
+
+using zinvul::cl::Vector;
+using zinvul::cl::VectorSimd;
+using zinvul::cl::SimdOperation;
+
+constexpr std::size_t kNumOfElements = 4096;
+constexpr std::size_t kNumOfIterations = 2000;
+
+/*!
+  \details The same operations as the arithmetic and relational parts of the
+  vector test kernels
+  */
+template <typename Type, zinvul::cl::size_t kN>
+void computeVector(const std::vector<Vector<Type, kN>>& a,
+                   const std::vector<Vector<Type, kN>>& b,
+                   std::vector<Vector<Type, kN>>* c) noexcept
+{
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    auto v = (*c)[i];
+    v += a[i] * b[i];
+    v -= a[i] / b[i];
+    const auto mask = (a[i] < v) || (b[i] == v);
+    (*c)[i] = (mask.x != 0) ? v : v + a[i];
+  }
+}
+
+/*!
+  \details Element-wise reference of computeVector
+  */
+template <typename Type, zinvul::cl::size_t kN>
+void computeScalar(const std::vector<Vector<Type, kN>>& a,
+                   const std::vector<Vector<Type, kN>>& b,
+                   std::vector<Vector<Type, kN>>* c) noexcept
+{
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    auto v = (*c)[i];
+    for (zinvul::cl::size_t j = 0; j < kN; ++j) {
+      v[j] += a[i][j] * b[i][j];
+      v[j] -= a[i][j] / b[i][j];
+    }
+    const bool mask = (a[i][0] < v[0]) || (b[i][0] == v[0]);
+    if (!mask) {
+      for (zinvul::cl::size_t j = 0; j < kN; ++j)
+        v[j] += a[i][j];
+    }
+    (*c)[i] = v;
+  }
+}
+
+/*!
+  */
+template <typename Function>
+double measure(Function&& function) noexcept
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < kNumOfIterations; ++i)
+    function();
+  const auto end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double, std::nano> elapsed = end - start;
+  const double ns = elapsed.count() /
+                    zisc::cast<double>(kNumOfIterations * kNumOfElements);
+  return ns;
+}
+
+/*!
+  */
+template <typename Type, zinvul::cl::size_t kN>
+void benchmark(const std::string& name) noexcept
+{
+  using VectorT = Vector<Type, kN>;
+  std::vector<VectorT> a, b, c1, c2;
+  a.reserve(kNumOfElements);
+  b.reserve(kNumOfElements);
+  for (std::size_t i = 0; i < kNumOfElements; ++i) {
+    VectorT v;
+    for (zinvul::cl::size_t j = 0; j < kN; ++j)
+      v[j] = zisc::cast<Type>(1 + (i + j) % 7);
+    a.emplace_back(v);
+    b.emplace_back(v + zisc::cast<Type>(1));
+  }
+  c1.resize(kNumOfElements, VectorT{zisc::cast<Type>(0)});
+  c2.resize(kNumOfElements, VectorT{zisc::cast<Type>(0)});
+
+  const double simd_time = measure([&a, &b, &c1]() noexcept
+  {
+    computeVector(a, b, &c1);
+  });
+  const double scalar_time = measure([&a, &b, &c2]() noexcept
+  {
+    computeScalar(a, b, &c2);
+  });
+
+  bool is_same = true;
+  for (std::size_t i = 0; (i < kNumOfElements) && is_same; ++i) {
+    for (zinvul::cl::size_t j = 0; j < kN; ++j)
+      is_same = is_same && (c1[i][j] == c2[i][j]);
+  }
+
+  using Simd = VectorSimd<Type, kN>;
+  const bool is_simd = Simd::isEnabled(SimdOperation::kAddition);
+  std::cout << std::setw(8) << name
+            << "  simd: " << std::setw(5) << (is_simd ? "on" : "off")
+            << "  vector: " << std::setw(8) << simd_time << " ns"
+            << "  scalar: " << std::setw(8) << scalar_time << " ns"
+            << "  speedup: " << std::setw(6) << (scalar_time / simd_time)
+            << "  result: " << (is_same ? "same" : "different") << std::endl;
+}
+
+} // namespace
+
+int main(int /* argc */, char** /* argv */)
+{
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "Time per element of " << kNumOfElements << " elements x "
+            << kNumOfIterations << " iterations." << std::endl;
+  benchmark<float, 3>("float3");
+  benchmark<float, 4>("float4");
+  benchmark<zinvul::int32b, 4>("int4");
+  benchmark<zinvul::uint32b, 4>("uint4");
+  benchmark<double, 2>("double2");
+  benchmark<double, 4>("double4");
+  return 0;
+}
@@ -25,6 +25,7 @@
 // Zinvul
 #include "zinvul_config.hpp"
 #include "utility/id_data.hpp"
+#include "utility/mapped_memory.hpp"
 #include "utility/zinvul_object.hpp"
 
 namespace zinvul {
@@ -84,6 +85,36 @@ void Buffer<T>::initialize(ZinvulObject::SharedPtr&& parent,
   initData();
 }
 
+/*!
+  \details The memory is mapped in place without any copy.
+  An empty memory is returned if the buffer isn't host visible
+
+  \return No description
+  */
+template <typename T> inline
+auto Buffer<T>::mapMemory() noexcept -> MappedMemory<Type>
+{
+  using MappedMem = MappedMemory<Type>;
+  typename MappedMem::ConstBufferP p = isHostVisible() ? this : nullptr;
+  MappedMem memory{p};
+  return memory;
+}
+
+/*!
+  \details The memory is mapped in place without any copy.
+  An empty memory is returned if the buffer isn't host visible
+
+  \return No description
+  */
+template <typename T> inline
+auto Buffer<T>::mapMemory() const noexcept -> MappedMemory<ConstType>
+{
+  using MappedMem = MappedMemory<ConstType>;
+  typename MappedMem::ConstBufferP p = isHostVisible() ? this : nullptr;
+  MappedMem memory{p};
+  return memory;
+}
+
 /*!
   \details No detailed description
 
@@ -25,10 +25,15 @@
 // Zinvul
 #include "zinvul_config.hpp"
 #include "utility/id_data.hpp"
+#include "utility/mapped_memory.hpp"
 #include "utility/zinvul_object.hpp"
 
 namespace zinvul {
 
+// Forward declaration
+class CommandList;
+class Fence;
+
 /*!
   \brief No brief description
 
@@ -59,9 +64,19 @@ class Buffer : public ZinvulObject
   //! Destroy the buffer
   void destroy() noexcept;
 
+  //! Return the number of elements which the buffer can hold without reallocation
+  virtual std::size_t capacity() const noexcept = 0;
+
   //! Clear the contents of the buffer
   void clear() noexcept;
 
+  //! Copy the elements of the buffer to the dst buffer on the queue
+  virtual Fence copyTo(Buffer* dst,
+                       const std::size_t count,
+                       const std::size_t src_offset,
+                       const std::size_t dst_offset,
+                       const uint32b queue_index) const = 0;
+
   //! Initialize the buffer
   void initialize(ZinvulObject::SharedPtr&& parent,
                   WeakPtr&& own,
@@ -79,15 +94,49 @@ class Buffer : public ZinvulObject
   //! Check if the buffer can be mapped for the host access
   virtual bool isHostVisible() const noexcept = 0;
 
-  //! Change the number of elements
+  //! Map the buffer memory to the host
+  MappedMemory<Type> mapMemory() noexcept;
+
+  //! Map the buffer memory to the host
+  MappedMemory<ConstType> mapMemory() const noexcept;
+
+  //! Read the elements of the buffer to the host memory
+  virtual void read(Pointer data,
+                    const std::size_t count,
+                    const std::size_t offset,
+                    const uint32b queue_index) const = 0;
+
+  //! Reserve the memory for at least the given number of elements
+  virtual void reserve(const std::size_t s) = 0;
+
+  //! Record a copy of the elements of the buffer to the dst buffer in the list
+  virtual void recordCopyTo(CommandList* command_list,
+                            Buffer* dst,
+                            const std::size_t count,
+                            const std::size_t src_offset,
+                            const std::size_t dst_offset) const = 0;
+
+  //! Change the number of elements without initializing the new elements
   virtual void setSize(const std::size_t s) = 0;
 
+  //! Release the memory which isn't used by the elements
+  virtual void shrinkToFit() = 0;
+
   //! Return the number of elements
   virtual std::size_t size() const noexcept = 0;
 
+  //! Return the sub-platform type of the buffer
+  virtual SubPlatformType type() const noexcept = 0;
+
   //! Return the buffer usage flag
   BufferUsage usage() const noexcept;
 
+  //! Write the elements of the host memory to the buffer
+  virtual void write(ConstPointer data,
+                     const std::size_t count,
+                     const std::size_t offset,
+                     const uint32b queue_index) = 0;
+
  protected:
   //! Clear the contents of the buffer
   virtual void destroyData() noexcept = 0;
@@ -96,6 +145,17 @@ class Buffer : public ZinvulObject
   virtual void initData() = 0;
 
  private:
+  friend MappedMemory<Type>;
+  friend MappedMemory<ConstType>;
+
+
+  //! Return the pointer to the mapped memory of the buffer
+  virtual Pointer mappedMemory() const noexcept = 0;
+
+  //! Release the mapped memory of the buffer
+  virtual void unmapMemory(const bool is_written) const noexcept = 0;
+
+
   BufferUsage buffer_usage_;
 };
 
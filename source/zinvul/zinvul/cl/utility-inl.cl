@@ -295,6 +295,35 @@ uint32b getGroupIdZ() noexcept
   return id;
 }
 
+/*!
+  \details The CPU backend processes adjacent work-items of x dimension in an
+  invocation if the kernel is launched in lock-step. Otherwise the size is 1
+  */
+inline
+uint32b getLaneSize() noexcept
+{
+#if defined(ZINVUL_CPU)
+  const uint32b size = get_lane_size();
+#else // ZINVUL_CPU
+  const uint32b size = 1;
+#endif // ZINVUL_CPU
+  return size;
+}
+
+/*!
+  \details All lanes have the same ID if the lane size is 1
+  */
+inline
+uint4 getGlobalLaneIdX() noexcept
+{
+#if defined(ZINVUL_CPU)
+  const uint4 id = get_global_lane_id(0);
+#else // ZINVUL_CPU
+  const uint4 id = makeUInt4(getGlobalIdX());
+#endif // ZINVUL_CPU
+  return id;
+}
+
 namespace inner {
 
 template <typename Type>
@@ -100,6 +100,12 @@ uint32b getGroupIdY() noexcept;
 //! Return the work-group ID of z dimension
 uint32b getGroupIdZ() noexcept;
 
+//! Return the number of work-items which are processed by an invocation
+uint32b getLaneSize() noexcept;
+
+//! Return the global work-item IDs of x dimension of the lanes
+uint4 getGlobalLaneIdX() noexcept;
+
 // Type utilities
 
 //! Make a value
@@ -0,0 +1,97 @@
+/*!
+  \file command_list-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_COMMAND_LIST_INL_HPP
+#define ZINVUL_COMMAND_LIST_INL_HPP
+
+#include "command_list.hpp"
+// Standard C++ library
+#include <array>
+#include <cstddef>
+// Zinvul
+#include "buffer.hpp"
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const Fence& CommandList::fence() const noexcept
+{
+  return fence_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool CommandList::isClosed() const noexcept
+{
+  return is_closed_;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type No description.
+  \param [in] src No description.
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  */
+template <typename Type> inline
+void CommandList::recordCopy(const Buffer<Type>& src,
+                             Buffer<Type>* dst,
+                             const std::size_t count,
+                             const std::size_t src_offset,
+                             const std::size_t dst_offset)
+{
+  if (isRecordable() && (0 < count))
+    src.recordCopyTo(this, dst, count, src_offset, dst_offset);
+}
+
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \tparam FuncArgTypes No description.
+  \tparam ArgTypes No description.
+  \param [in] kernel No description.
+  \param [in] work_size No description.
+  \param [in] args No description.
+  */
+template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+inline
+void CommandList::recordKernel(Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+                               const std::array<uint32b, kDimension>& work_size,
+                               Buffer<ArgTypes>&... args)
+{
+  if (isRecordable()) {
+    auto options = kernel->makeOptions();
+    options.setWorkSize(work_size);
+    kernel->record(this, args..., options);
+  }
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_COMMAND_LIST_INL_HPP
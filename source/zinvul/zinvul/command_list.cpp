@@ -0,0 +1,120 @@
+/*!
+  \file command_list.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "command_list.hpp"
+// Standard C++ library
+#include <cstdio>
+#include <utility>
+// Zinvul
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+#include "utility/id_data.hpp"
+#include "utility/zinvul_object.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] id No description.
+  */
+CommandList::CommandList(IdData&& id) noexcept : ZinvulObject(std::move(id))
+{
+}
+
+/*!
+  \details No detailed description
+  */
+CommandList::~CommandList() noexcept
+{
+}
+
+/*!
+  \details The last replay is completed before the commands are removed
+  */
+void CommandList::clear() noexcept
+{
+  waitForCompletion();
+  clearCommands();
+  fence_ = Fence{};
+  is_closed_ = false;
+}
+
+/*!
+  \details No detailed description
+  */
+void CommandList::destroy() noexcept
+{
+  waitForCompletion();
+  destroyData();
+  fence_ = Fence{};
+  is_closed_ = false;
+  destroyObject();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] parent No description.
+  \param [in] own No description.
+  */
+void CommandList::initialize(ZinvulObject::SharedPtr&& parent, WeakPtr&& own)
+{
+  //! Clear the previous device data first
+  destroy();
+
+  initObject(std::move(parent), std::move(own));
+  initData();
+}
+
+/*!
+  \details The commands are executed after the commands which were submitted
+  to the queue before. A list can be replayed again before the previous
+  replay is completed
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+Fence CommandList::replay(const uint32b queue_index)
+{
+  is_closed_ = true;
+  fence_ = (0 < numOfCommands()) ? replayCommands(queue_index) : Fence{};
+  return fence_;
+}
+
+/*!
+  \details No detailed description
+  */
+void CommandList::waitForCompletion() const noexcept
+{
+  if (fence_)
+    fence_.wait();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool CommandList::isRecordable() const noexcept
+{
+  const bool result = !isClosed();
+  if (!result) {
+    //! \todo Handle exception
+    printf("[Warning]: The command list is closed. Clear it before recording.\n");
+  }
+  return result;
+}
+
+} // namespace zinvul
@@ -0,0 +1,131 @@
+/*!
+  \file command_list.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_COMMAND_LIST_HPP
+#define ZINVUL_COMMAND_LIST_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <memory>
+// Zinvul
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+#include "utility/id_data.hpp"
+#include "utility/zinvul_object.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+template <typename Type> class Buffer;
+template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+class Kernel;
+
+/*!
+  \brief A sequence of kernel launches and copies which is replayed at once
+
+  The commands are prepared once when they are recorded, so a replay submits
+  the whole sequence to a queue without rebuilding the launch of each
+  command. The recorded commands are executed in the recorded order.
+  The list is closed by the first replay, and commands can be recorded again
+  after the list is cleared. The buffers must not be resized and the kernels
+  and buffers must be alive while the commands are recorded.
+  */
+class CommandList : public ZinvulObject
+{
+ public:
+  // Type aliases
+  using SharedPtr = std::shared_ptr<CommandList>;
+  using WeakPtr = std::weak_ptr<CommandList>;
+
+
+  //! Initialize the command list
+  CommandList(IdData&& id) noexcept;
+
+  //! Finalize the command list
+  virtual ~CommandList() noexcept;
+
+
+  //! Remove all recorded commands
+  void clear() noexcept;
+
+  //! Destroy the command list
+  void destroy() noexcept;
+
+  //! Return the fence of the last replay
+  const Fence& fence() const noexcept;
+
+  //! Initialize the command list
+  void initialize(ZinvulObject::SharedPtr&& parent, WeakPtr&& own);
+
+  //! Check if the list is closed by a replay
+  bool isClosed() const noexcept;
+
+  //! Return the number of recorded commands
+  virtual std::size_t numOfCommands() const noexcept = 0;
+
+  //! Record a copy of the elements of the src buffer to the dst buffer
+  template <typename Type>
+  void recordCopy(const Buffer<Type>& src,
+                  Buffer<Type>* dst,
+                  const std::size_t count,
+                  const std::size_t src_offset,
+                  const std::size_t dst_offset);
+
+  //! Record a launch of the kernel
+  template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+  void recordKernel(Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+                    const std::array<uint32b, kDimension>& work_size,
+                    Buffer<ArgTypes>&... args);
+
+  //! Submit the recorded commands to the queue
+  Fence replay(const uint32b queue_index);
+
+  //! Return the sub-platform type of the command list
+  virtual SubPlatformType type() const noexcept = 0;
+
+  //! Wait this thread until the last replay is completed
+  void waitForCompletion() const noexcept;
+
+ protected:
+  //! Remove all recorded commands of the device
+  virtual void clearCommands() noexcept = 0;
+
+  //! Clear the contents of the command list
+  virtual void destroyData() noexcept = 0;
+
+  //! Initialize the command list
+  virtual void initData() = 0;
+
+  //! Submit the recorded commands of the device to the queue
+  virtual Fence replayCommands(const uint32b queue_index) = 0;
+
+ private:
+  //! Check if a command can be recorded
+  bool isRecordable() const noexcept;
+
+
+  Fence fence_;
+  bool is_closed_ = false;
+};
+
+// Type aliases
+using SharedCommandList = CommandList::SharedPtr;
+using WeakCommandList = CommandList::WeakPtr;
+
+} // namespace zinvul
+
+#include "command_list-inl.hpp"
+
+#endif // ZINVUL_COMMAND_LIST_HPP
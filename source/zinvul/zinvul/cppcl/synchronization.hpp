@@ -12,6 +12,7 @@
 
 // Zinvul
 #include "types.hpp"
+#include "utility.hpp"
 #include "zinvul/zinvul_config.hpp"
 
 namespace zinvul {
@@ -30,9 +31,12 @@ enum cl_mem_fence_flags
 // Forward declaration
 void barrier(const int32b /* flags */) noexcept;
 
-//! Dummy function
+//! Wait until all work-items in the work-group reach the barrier
 inline
-void barrier(const int32b /* flags */) noexcept {}
+void barrier(const int32b /* flags */) noexcept
+{
+  inner::WorkGroup::barrier();
+}
 
 } // namespace cl
 
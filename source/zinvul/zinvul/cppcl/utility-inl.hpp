@@ -33,49 +33,232 @@ namespace cl {
 namespace inner {
 
 /*!
-  \brief No brief description
+  \brief The state of the work-item which is executed on the current thread
 
-  No detailed description.
+  The state is packed into a context, so that a query reads one thread-local
+  object and the address of the context is computed once in a loop over
+  work-groups. The global offset of the work-group is computed when the
+  work-group is changed, and the ids of the consecutive work-groups of a
+  batch are advanced incrementally instead of being expanded from a linear id.
   */
 class WorkGroup
 {
  public:
+  // Type aliases
+  using BarrierCallback = void (*)(void* data);
+
+
+  //! Synchronize the work-items in the work-group
+  static void barrier() noexcept
+  {
+    if (context_.barrier_callback_ != nullptr)
+      context_.barrier_callback_(context_.barrier_data_);
+  }
+
+  //! Return the global work-item id
+  static uint32b getGlobalWorkId(const uint32b dimension) noexcept
+  {
+    const uint32b id = zisc::isInBounds(dimension, 0u, get_work_dim())
+        ? context_.group_offset_[dimension] + context_.local_work_id_[dimension]
+        : 0u;
+    return id;
+  }
+
+  //! Return the global id of the first work-item of the launch
+  static uint32b getGlobalOffset(const uint32b dimension) noexcept
+  {
+    const uint32b offset = zisc::isInBounds(dimension, 0u, get_work_dim())
+        ? context_.global_offset_[dimension]
+        : 0u;
+    return offset;
+  }
+
+  //! Return the global id of the first work-item of the work-group
+  static uint32b getGroupOffset(const uint32b dimension) noexcept
+  {
+    const uint32b offset = zisc::isInBounds(dimension, 0u, get_work_dim())
+        ? context_.group_offset_[dimension]
+        : 0u;
+    return offset;
+  }
+
+  //! Return the local work-item id
+  static uint32b getLocalWorkId(const uint32b dimension) noexcept
+  {
+    const uint32b id = zisc::isInBounds(dimension, 0u, get_work_dim())
+        ? context_.local_work_id_[dimension]
+        : 0u;
+    return id;
+  }
+
+  //! Return the local work-group size
+  static uint32b getLocalWorkSize(const uint32b dimension) noexcept
+  {
+    const uint32b size = zisc::isInBounds(dimension, 0u, get_work_dim())
+        ? context_.local_work_size_[dimension]
+        : 1u;
+    return size;
+  }
+
   //! Return the work-group id
   static uint32b getWorkGroupId(const uint32b dimension) noexcept
   {
     const size_t id = zisc::isInBounds(dimension, 0u, get_work_dim())
-        ? work_group_id_[dimension]
+        ? context_.work_group_id_[dimension]
         : 0u;
     return id;
   }
 
+  //! Return the number of work-items which are processed by an invocation
+  static uint32b getLaneSize() noexcept
+  {
+    return context_.lane_size_;
+  }
+
+  //! Return the local memory which is shared in the work-group
+  static void* getLocalMemory() noexcept
+  {
+    return context_.local_memory_;
+  }
+
   //! Return the work-group size
   static size_t getWorkGroupSize(const uint32b dimension) noexcept
   {
     const size_t size = zisc::isInBounds(dimension, 0u, get_work_dim())
-        ? work_group_size_[dimension]
+        ? context_.work_group_size_[dimension]
         : 1u;
     return size;
   }
+
+  //! Return the number of lanes of a lock-step invocation
+  static constexpr uint32b lockStepLaneSize() noexcept
+  {
+    return 4;
+  }
+
+  //! Advance the work-group id to the next one in row-major order
+  static void nextWorkGroupId() noexcept
+  {
+    auto& c = context_;
+    ++c.work_group_id_[0];
+    c.group_offset_[0] += c.local_work_size_[0];
+    if (c.work_group_id_[0] == c.work_group_size_[0]) {
+      c.work_group_id_[0] = 0;
+      c.group_offset_[0] = c.global_offset_[0];
+      ++c.work_group_id_[1];
+      c.group_offset_[1] += c.local_work_size_[1];
+      if (c.work_group_id_[1] == c.work_group_size_[1]) {
+        c.work_group_id_[1] = 0;
+        c.group_offset_[1] = c.global_offset_[1];
+        ++c.work_group_id_[2];
+        c.group_offset_[2] += c.local_work_size_[2];
+      }
+    }
+  }
+
+  //! Set a callback which is invoked at a barrier
+  static void setBarrierCallback(BarrierCallback callback, void* data) noexcept
+  {
+    context_.barrier_callback_ = callback;
+    context_.barrier_data_ = data;
+  }
+
+  //! Set the global id of the first work-item of the launch
+  static void setGlobalOffset(const std::array<uint32b, 3>& offset) noexcept
+  {
+    context_.global_offset_ = offset;
+    updateGroupOffset();
+  }
+
+  //! Set the number of work-items which are processed by an invocation
+  static void setLaneSize(const uint32b size) noexcept
+  {
+    context_.lane_size_ = size;
+  }
+
+  //! Set the local memory which is shared in the work-group
+  static void setLocalMemory(void* memory) noexcept
+  {
+    context_.local_memory_ = memory;
+  }
+
+  //! Set a local work-item id
+  static void setLocalWorkId(const uint32b id) noexcept
+  {
+    auto& c = context_;
+    if (c.lane_size_ == 1) {
+      c.local_work_id_ = expandId(id, c.local_work_size_);
+    }
+    else {
+      // The id is of an invocation which processes adjacent x work-items
+      std::array<uint32b, 3> size = c.local_work_size_;
+      size[0] = size[0] / c.lane_size_;
+      c.local_work_id_ = expandId(id, size);
+      c.local_work_id_[0] = c.local_work_id_[0] * c.lane_size_;
+    }
+  }
+
+  //! Set a local work-group size
+  static void setLocalWorkSize(const std::array<uint32b, 3>& size) noexcept
+  {
+    context_.local_work_size_ = size;
+    updateGroupOffset();
+  }
+
   //! Set a work-group id
   static void setWorkGroupId(const uint32b id) noexcept
   {
-    work_group_id_[0] = id % work_group_size_[0];
-    work_group_id_[1] = (id / work_group_size_[0]) % work_group_size_[1];
-    work_group_id_[2] = id / (work_group_size_[0] * work_group_size_[1]);
-    ZISC_ASSERT(work_group_id_[2] < work_group_size_[2],
-                "The workgroup ID is invalid: ID=", id);
+    context_.work_group_id_ = expandId(id, context_.work_group_size_);
+    updateGroupOffset();
   }
 
   //! Set a work-group size
   static void setWorkGroupSize(const std::array<uint32b, 3>& size) noexcept
   {
-    work_group_size_ = size;
+    context_.work_group_size_ = size;
   }
 
  private:
-  static thread_local std::array<uint32b, 3> work_group_id_;
-  static thread_local std::array<uint32b, 3> work_group_size_;
+  /*!
+    \brief The packed state of a work-item
+    */
+  struct alignas(64) Context
+  {
+    std::array<uint32b, 3> group_offset_{{0, 0, 0}}; //!< global_offset_ + work_group_id_ * local_work_size_
+    std::array<uint32b, 3> global_offset_{{0, 0, 0}};
+    std::array<uint32b, 3> local_work_id_{{0, 0, 0}};
+    std::array<uint32b, 3> local_work_size_{{1, 1, 1}};
+    std::array<uint32b, 3> work_group_id_{{0, 0, 0}};
+    std::array<uint32b, 3> work_group_size_{{1, 1, 1}};
+    uint32b lane_size_ = 1;
+    BarrierCallback barrier_callback_ = nullptr;
+    void* barrier_data_ = nullptr;
+    void* local_memory_ = nullptr;
+  };
+
+
+  //! Convert a linear id to a 3d id
+  static std::array<uint32b, 3> expandId(const uint32b id,
+                                         const std::array<uint32b, 3>& size) noexcept
+  {
+    const std::array<uint32b, 3> id3d{{id % size[0],
+                                       (id / size[0]) % size[1],
+                                       id / (size[0] * size[1])}};
+    ZISC_ASSERT(id3d[2] < size[2], "The ID is invalid: ID=", id);
+    return id3d;
+  }
+
+  //! Compute the global offset of the current work-group
+  static void updateGroupOffset() noexcept
+  {
+    auto& c = context_;
+    for (std::size_t i = 0; i < c.group_offset_.size(); ++i)
+      c.group_offset_[i] = c.global_offset_[i] +
+                           c.work_group_id_[i] * c.local_work_size_[i];
+  }
+
+
+  static thread_local Context context_;
 };
 
 } // namespace inner
@@ -93,16 +276,25 @@ void printf(const char* format, const Type& value) noexcept
 inline
 size_t get_global_id(const uint32b dimension) noexcept
 {
-  const auto id = get_group_id(dimension);
+  return inner::WorkGroup::getGlobalWorkId(dimension);
+}
+
+/*!
+  */
+inline
+uint4 get_global_lane_id(const uint32b dimension) noexcept
+{
+  const uint4 offset{inner::WorkGroup::getGroupOffset(dimension)};
+  const uint4 id = offset + get_local_lane_id(dimension);
   return id;
 }
 
 /*!
   */
 inline
-constexpr size_t get_global_offset(const uint32b /* dimension */) noexcept
+size_t get_global_offset(const uint32b dimension) noexcept
 {
-  return 0;
+  return inner::WorkGroup::getGlobalOffset(dimension);
 }
 
 /*!
@@ -110,7 +302,8 @@ constexpr size_t get_global_offset(const uint32b /* dimension */) noexcept
 inline
 size_t get_global_size(const uint32b dimension) noexcept
 {
-  return get_num_groups(dimension);
+  const size_t size = get_num_groups(dimension) * get_local_size(dimension);
+  return size;
 }
 
 /*!
@@ -124,17 +317,32 @@ size_t get_group_id(const uint32b dimension) noexcept
 /*!
   */
 inline
-constexpr size_t get_local_id(const uint32b /* dimension */) noexcept
+size_t get_local_id(const uint32b dimension) noexcept
 {
-  return 0;
+  return inner::WorkGroup::getLocalWorkId(dimension);
 }
 
 /*!
+  \details The lanes of an invocation are the adjacent work-items of x dimension.
+  All lanes have the same ID if the invocation doesn't run in lock-step
   */
 inline
-constexpr size_t get_local_size(const uint32b /* dimension */) noexcept
+uint4 get_local_lane_id(const uint32b dimension) noexcept
 {
-  return 1;
+  static_assert(uint4::size() == inner::WorkGroup::lockStepLaneSize(),
+                "The lane size doesn't match the size of uint4.");
+  uint4 id{get_local_id(dimension)};
+  if ((dimension == 0) && (1 < get_lane_size()))
+    id = id + uint4{0, 1, 2, 3};
+  return id;
+}
+
+/*!
+  */
+inline
+size_t get_local_size(const uint32b dimension) noexcept
+{
+  return inner::WorkGroup::getLocalWorkSize(dimension);
 }
 
 /*!
@@ -153,6 +361,14 @@ constexpr uint32b get_work_dim() noexcept
   return 3;
 }
 
+/*!
+  */
+inline
+uint32b get_lane_size() noexcept
+{
+  return inner::WorkGroup::getLaneSize();
+}
+
 namespace inner {
 
 /*!
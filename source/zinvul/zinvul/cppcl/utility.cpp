@@ -24,8 +24,7 @@ namespace cl {
 
 namespace inner {
 
-thread_local std::array<zinvul::uint32b, 3> WorkGroup::work_group_id_;
-thread_local std::array<zinvul::uint32b, 3> WorkGroup::work_group_size_;
+thread_local WorkGroup::Context WorkGroup::context_;
 
 } // namespace inner
 
@@ -31,7 +31,7 @@ void printf(const char* format, const Type& value) noexcept;
 size_t get_global_id(const uint32b dimension) noexcept;
 
 //! Return the offset values
-constexpr size_t get_global_offset(const uint32b dimension) noexcept;
+size_t get_global_offset(const uint32b dimension) noexcept;
 
 //! Return the number of global work-items
 size_t get_global_size(const uint32b dimension) noexcept;
@@ -40,10 +40,10 @@ size_t get_global_size(const uint32b dimension) noexcept;
 size_t get_group_id(const uint32b dimension) noexcept;
 
 //! Return the unique local work-item ID
-constexpr size_t get_local_id(const uint32b dimension) noexcept;
+size_t get_local_id(const uint32b dimension) noexcept;
 
 //! Return the number of local work-item
-constexpr size_t get_local_size(const uint32b dimension) noexcept;
+size_t get_local_size(const uint32b dimension) noexcept;
 
 //! Return the number of work-groups that will execute a kernel
 size_t get_num_groups(const uint32b dimension) noexcept;
@@ -51,6 +51,17 @@ size_t get_num_groups(const uint32b dimension) noexcept;
 //! Return the number of dimensions in use
 constexpr uint32b get_work_dim() noexcept;
 
+// Lock-step execution functions (Zinvul extension)
+
+//! Return the number of work-items which are processed by an invocation
+uint32b get_lane_size() noexcept;
+
+//! Return the global work-item IDs of the lanes of the invocation
+uint4 get_global_lane_id(const uint32b dimension) noexcept;
+
+//! Return the local work-item IDs of the lanes of the invocation
+uint4 get_local_lane_id(const uint32b dimension) noexcept;
+
 //! Convert to a char value
 template <typename Type>
 int8b convert_char(Type&& value) noexcept;
@@ -20,6 +20,7 @@
 #include "zisc/utility.hpp"
 // Zinvul
 #include "types.hpp"
+#include "vector_simd.hpp"
 #include "zinvul/zinvul_config.hpp"
 
 namespace zinvul {
@@ -465,9 +466,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator+(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] + rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kAddition)) {
+    result = Simd::add(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] + rhs[index];
+  }
   return result;
 }
 
@@ -477,9 +484,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator+(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs + rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kAddition)) {
+    result = Simd::add(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs + rhs[index];
+  }
   return result;
 }
 
@@ -499,9 +512,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator-(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] - rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kSubtraction)) {
+    result = Simd::sub(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] - rhs[index];
+  }
   return result;
 }
 
@@ -511,9 +530,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator-(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs - rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kSubtraction)) {
+    result = Simd::sub(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs - rhs[index];
+  }
   return result;
 }
 
@@ -533,9 +558,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator*(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] * rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kMultiplication)) {
+    result = Simd::mul(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] * rhs[index];
+  }
   return result;
 }
 
@@ -545,9 +576,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator*(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs * rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kMultiplication)) {
+    result = Simd::mul(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs * rhs[index];
+  }
   return result;
 }
 
@@ -567,9 +604,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator/(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] / rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kDivision)) {
+    result = Simd::div(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] / rhs[index];
+  }
   return result;
 }
 
@@ -579,9 +622,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator/(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs / rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kDivision)) {
+    result = Simd::div(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs / rhs[index];
+  }
   return result;
 }
 
@@ -591,9 +640,15 @@ template <typename Type, size_t kN> inline
 Vector<Type, kN> operator/(const Vector<Type, kN>& lhs,
                            const Type& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] / rhs;
+  if constexpr (Simd::isEnabled(SimdOperation::kDivision)) {
+    result = Simd::div(lhs, Vector<Type, kN>{rhs});
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] / rhs;
+  }
   return result;
 }
 
@@ -655,9 +710,15 @@ Vector<Type, kN> operator&(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] & rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseAnd)) {
+    result = Simd::bitAnd(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] & rhs[index];
+  }
   return result;
 }
 
@@ -668,9 +729,15 @@ Vector<Type, kN> operator&(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs & rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseAnd)) {
+    result = Simd::bitAnd(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs & rhs[index];
+  }
   return result;
 }
 
@@ -692,9 +759,15 @@ Vector<Type, kN> operator|(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] | rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseOr)) {
+    result = Simd::bitOr(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] | rhs[index];
+  }
   return result;
 }
 
@@ -705,9 +778,15 @@ Vector<Type, kN> operator|(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs | rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseOr)) {
+    result = Simd::bitOr(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs | rhs[index];
+  }
   return result;
 }
 
@@ -729,9 +808,15 @@ Vector<Type, kN> operator^(const Vector<Type, kN>& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs[index] ^ rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseXor)) {
+    result = Simd::bitXor(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs[index] ^ rhs[index];
+  }
   return result;
 }
 
@@ -742,9 +827,15 @@ Vector<Type, kN> operator^(const Type& lhs,
                            const Vector<Type, kN>& rhs) noexcept
 {
   static_assert(std::is_integral_v<Type>, "The Type isn't integer type.");
+  using Simd = VectorSimd<Type, kN>;
   Vector<Type, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = lhs ^ rhs[index];
+  if constexpr (Simd::isEnabled(SimdOperation::kBitwiseXor)) {
+    result = Simd::bitXor(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = lhs ^ rhs[index];
+  }
   return result;
 }
 
@@ -850,11 +941,17 @@ Vector<Config::ComparisonResultType<Type>, kN> operator==(
     const Vector<Type, kN>& lhs,
     const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Config::ComparisonResultType<Type>, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = (lhs[index] == rhs[index])
-        ? Config::vecResultTrue<Type>() 
-        : Config::vecResultFalse<Type>();
+  if constexpr (Simd::isEnabled(SimdOperation::kEqual)) {
+    result = Simd::equal(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = (lhs[index] == rhs[index])
+          ? Config::vecResultTrue<Type>() 
+          : Config::vecResultFalse<Type>();
+  }
   return result;
 }
 
@@ -865,11 +962,17 @@ Vector<Config::ComparisonResultType<Type>, kN> operator==(
     const Type& lhs,
     const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Config::ComparisonResultType<Type>, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = (lhs == rhs[index])
-        ? Config::vecResultTrue<Type>() 
-        : Config::vecResultFalse<Type>();
+  if constexpr (Simd::isEnabled(SimdOperation::kEqual)) {
+    result = Simd::equal(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = (lhs == rhs[index])
+          ? Config::vecResultTrue<Type>() 
+          : Config::vecResultFalse<Type>();
+  }
   return result;
 }
 
@@ -924,11 +1027,17 @@ Vector<Config::ComparisonResultType<Type>, kN> operator<(
     const Vector<Type, kN>& lhs,
     const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Config::ComparisonResultType<Type>, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = (lhs[index] < rhs[index])
-        ? Config::vecResultTrue<Type>() 
-        : Config::vecResultFalse<Type>();
+  if constexpr (Simd::isEnabled(SimdOperation::kLess)) {
+    result = Simd::less(lhs, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = (lhs[index] < rhs[index])
+          ? Config::vecResultTrue<Type>() 
+          : Config::vecResultFalse<Type>();
+  }
   return result;
 }
 
@@ -939,11 +1048,17 @@ Vector<Config::ComparisonResultType<Type>, kN> operator<(
     const Type& lhs,
     const Vector<Type, kN>& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Config::ComparisonResultType<Type>, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = (lhs < rhs[index])
-        ? Config::vecResultTrue<Type>() 
-        : Config::vecResultFalse<Type>();
+  if constexpr (Simd::isEnabled(SimdOperation::kLess)) {
+    result = Simd::less(Vector<Type, kN>{lhs}, rhs);
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = (lhs < rhs[index])
+          ? Config::vecResultTrue<Type>() 
+          : Config::vecResultFalse<Type>();
+  }
   return result;
 }
 
@@ -954,11 +1069,17 @@ Vector<Config::ComparisonResultType<Type>, kN> operator<(
     const Vector<Type, kN>& lhs,
     const Type& rhs) noexcept
 {
+  using Simd = VectorSimd<Type, kN>;
   Vector<Config::ComparisonResultType<Type>, kN> result;
-  for (size_t index = 0; index < kN; ++index)
-    result[index] = (lhs[index] < rhs)
-        ? Config::vecResultTrue<Type>() 
-        : Config::vecResultFalse<Type>();
+  if constexpr (Simd::isEnabled(SimdOperation::kLess)) {
+    result = Simd::less(lhs, Vector<Type, kN>{rhs});
+  }
+  else {
+    for (size_t index = 0; index < kN; ++index)
+      result[index] = (lhs[index] < rhs)
+          ? Config::vecResultTrue<Type>() 
+          : Config::vecResultFalse<Type>();
+  }
   return result;
 }
 
@@ -969,7 +1090,12 @@ Vector<Config::ComparisonResultType<Type>, kN> operator<=(
     const Vector<Type, kN>& lhs,
     const Vector<Type, kN>& rhs) noexcept
 {
-  const auto result = (lhs == rhs) || (lhs < rhs);
+  using Simd = VectorSimd<Type, kN>;
+  Vector<Config::ComparisonResultType<Type>, kN> result;
+  if constexpr (Simd::isEnabled(SimdOperation::kLessEqual))
+    result = Simd::lessEqual(lhs, rhs);
+  else
+    result = (lhs == rhs) || (lhs < rhs);
   return result;
 }
 
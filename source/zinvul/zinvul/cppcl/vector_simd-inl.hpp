@@ -0,0 +1,427 @@
+/*!
+  \file vector_simd-inl.hpp
+  \author Sho Ikeda
+
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CL_VECTOR_SIMD_INL_HPP
+#define ZINVUL_CL_VECTOR_SIMD_INL_HPP
+
+#include "vector_simd.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+// Zisc
+#include "zisc/utility.hpp"
+// Zinvul
+#include "types.hpp"
+#include "vector.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+namespace cl {
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+constexpr bool VectorSimd<Type, kN>::isEnabled(const SimdOperation operation)
+    noexcept
+{
+  using Op = SimdOperation;
+  bool result = false;
+  if constexpr (isFloat4() || isDouble2() || isDouble4()) {
+    result = (operation != Op::kBitwiseAnd) &&
+             (operation != Op::kBitwiseOr) &&
+             (operation != Op::kBitwiseXor);
+  }
+  else if constexpr (isInt4()) {
+#if defined(ZINVUL_CPPCL_SSE4_1)
+    constexpr bool has_mul = true;
+#else // ZINVUL_CPPCL_SSE4_1
+    constexpr bool has_mul = false;
+#endif // ZINVUL_CPPCL_SSE4_1
+    result = (operation != Op::kDivision) &&
+             ((operation != Op::kMultiplication) || has_mul);
+  }
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::add(const VectorType& lhs,
+                               const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4())
+    result = store(_mm_add_ps(load(lhs), load(rhs)));
+  else if constexpr (isInt4())
+    result = store(_mm_add_epi32(load(lhs), load(rhs)));
+  else if constexpr (isDouble2())
+    result = store(_mm_add_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4())
+    result = store(_mm256_add_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::bitAnd(const VectorType& lhs,
+                                  const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isInt4())
+    result = store(_mm_and_si128(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::bitOr(const VectorType& lhs,
+                                 const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isInt4())
+    result = store(_mm_or_si128(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::bitXor(const VectorType& lhs,
+                                  const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isInt4())
+    result = store(_mm_xor_si128(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::div(const VectorType& lhs,
+                               const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4())
+    result = store(_mm_div_ps(load(lhs), load(rhs)));
+  else if constexpr (isDouble2())
+    result = store(_mm_div_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4())
+    result = store(_mm256_div_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::equal(const VectorType& lhs,
+                                 const VectorType& rhs) noexcept -> ResultVector
+{
+  ResultVector result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4())
+    result = storeMask(_mm_castps_si128(_mm_cmpeq_ps(load(lhs), load(rhs))));
+  else if constexpr (isInt4())
+    result = storeMask(_mm_cmpeq_epi32(load(lhs), load(rhs)));
+  else if constexpr (isDouble2())
+    result = storeMask(_mm_castpd_si128(_mm_cmpeq_pd(load(lhs), load(rhs))));
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4()) {
+    const __m256d mask = _mm256_cmp_pd(load(lhs), load(rhs), _CMP_EQ_OQ);
+    result = storeMask(_mm256_castpd_si256(mask));
+  }
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::less(const VectorType& lhs,
+                                const VectorType& rhs) noexcept -> ResultVector
+{
+  ResultVector result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4()) {
+    result = storeMask(_mm_castps_si128(_mm_cmplt_ps(load(lhs), load(rhs))));
+  }
+  else if constexpr (isInt4()) {
+    const __m128i l = toSigned(load(lhs));
+    const __m128i r = toSigned(load(rhs));
+    result = storeMask(_mm_cmplt_epi32(l, r));
+  }
+  else if constexpr (isDouble2()) {
+    result = storeMask(_mm_castpd_si128(_mm_cmplt_pd(load(lhs), load(rhs))));
+  }
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4()) {
+    const __m256d mask = _mm256_cmp_pd(load(lhs), load(rhs), _CMP_LT_OQ);
+    result = storeMask(_mm256_castpd_si256(mask));
+  }
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::lessEqual(const VectorType& lhs,
+                                     const VectorType& rhs) noexcept
+    -> ResultVector
+{
+  ResultVector result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4()) {
+    result = storeMask(_mm_castps_si128(_mm_cmple_ps(load(lhs), load(rhs))));
+  }
+  else if constexpr (isInt4()) {
+    // There is no integer 'less equal' instruction, so compute !(lhs > rhs)
+    const __m128i l = toSigned(load(lhs));
+    const __m128i r = toSigned(load(rhs));
+    const __m128i greater = _mm_cmpgt_epi32(l, r);
+    result = storeMask(_mm_xor_si128(greater, _mm_set1_epi32(-1)));
+  }
+  else if constexpr (isDouble2()) {
+    result = storeMask(_mm_castpd_si128(_mm_cmple_pd(load(lhs), load(rhs))));
+  }
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4()) {
+    const __m256d mask = _mm256_cmp_pd(load(lhs), load(rhs), _CMP_LE_OQ);
+    result = storeMask(_mm256_castpd_si256(mask));
+  }
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::mul(const VectorType& lhs,
+                               const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4())
+    result = store(_mm_mul_ps(load(lhs), load(rhs)));
+  else if constexpr (isDouble2())
+    result = store(_mm_mul_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_SSE4_1)
+  if constexpr (isInt4())
+    result = store(_mm_mullo_epi32(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE4_1
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4())
+    result = store(_mm256_mul_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::sub(const VectorType& lhs,
+                               const VectorType& rhs) noexcept -> VectorType
+{
+  VectorType result;
+#if defined(ZINVUL_CPPCL_SSE2)
+  if constexpr (isFloat4())
+    result = store(_mm_sub_ps(load(lhs), load(rhs)));
+  else if constexpr (isInt4())
+    result = store(_mm_sub_epi32(load(lhs), load(rhs)));
+  else if constexpr (isDouble2())
+    result = store(_mm_sub_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_SSE2
+#if defined(ZINVUL_CPPCL_AVX)
+  if constexpr (isDouble4())
+    result = store(_mm256_sub_pd(load(lhs), load(rhs)));
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+constexpr bool VectorSimd<Type, kN>::isDouble4() noexcept
+{
+#if defined(ZINVUL_CPPCL_AVX)
+  constexpr bool result = std::is_same_v<double, Type> &&
+                          ((kN == 3) || (kN == 4));
+#else // ZINVUL_CPPCL_AVX
+  constexpr bool result = false;
+#endif // ZINVUL_CPPCL_AVX
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+constexpr bool VectorSimd<Type, kN>::isDouble2() noexcept
+{
+#if defined(ZINVUL_CPPCL_SSE2)
+  constexpr bool result = std::is_same_v<double, Type> && (kN == 2);
+#else // ZINVUL_CPPCL_SSE2
+  constexpr bool result = false;
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+constexpr bool VectorSimd<Type, kN>::isFloat4() noexcept
+{
+#if defined(ZINVUL_CPPCL_SSE2)
+  constexpr bool result = std::is_same_v<float, Type> &&
+                          ((kN == 3) || (kN == 4));
+#else // ZINVUL_CPPCL_SSE2
+  constexpr bool result = false;
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+constexpr bool VectorSimd<Type, kN>::isInt4() noexcept
+{
+#if defined(ZINVUL_CPPCL_SSE2)
+  constexpr bool result = (std::is_same_v<int32b, Type> ||
+                           std::is_same_v<uint32b, Type>) &&
+                          ((kN == 3) || (kN == 4));
+#else // ZINVUL_CPPCL_SSE2
+  constexpr bool result = false;
+#endif // ZINVUL_CPPCL_SSE2
+  return result;
+}
+
+#if defined(ZINVUL_CPPCL_SSE2)
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::load(const VectorType& v) noexcept
+{
+  if constexpr (isFloat4())
+    return _mm_load_ps(zisc::treatAs<const float*>(&v));
+  else if constexpr (isInt4())
+    return _mm_load_si128(zisc::treatAs<const __m128i*>(&v));
+  else if constexpr (isDouble2())
+    return _mm_load_pd(zisc::treatAs<const double*>(&v));
+#if defined(ZINVUL_CPPCL_AVX)
+  else if constexpr (isDouble4())
+    return _mm256_load_pd(zisc::treatAs<const double*>(&v));
+#endif // ZINVUL_CPPCL_AVX
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+__m128i VectorSimd<Type, kN>::toSigned(const __m128i v) noexcept
+{
+  __m128i result = v;
+  if constexpr (std::is_unsigned_v<Type>) {
+    const __m128i sign = _mm_set1_epi32(std::numeric_limits<int32b>::min());
+    result = _mm_xor_si128(v, sign);
+  }
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::store(const __m128 v) noexcept -> VectorType
+{
+  VectorType result;
+  _mm_store_ps(zisc::treatAs<float*>(&result), v);
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::store(const __m128i v) noexcept -> VectorType
+{
+  VectorType result;
+  _mm_store_si128(zisc::treatAs<__m128i*>(&result), v);
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::store(const __m128d v) noexcept -> VectorType
+{
+  VectorType result;
+  _mm_store_pd(zisc::treatAs<double*>(&result), v);
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::storeMask(const __m128i v) noexcept -> ResultVector
+{
+  ResultVector result;
+  _mm_store_si128(zisc::treatAs<__m128i*>(&result), v);
+  return result;
+}
+
+#endif // ZINVUL_CPPCL_SSE2
+
+#if defined(ZINVUL_CPPCL_AVX)
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::store(const __m256d v) noexcept -> VectorType
+{
+  VectorType result;
+  _mm256_store_pd(zisc::treatAs<double*>(&result), v);
+  return result;
+}
+
+/*!
+  */
+template <typename Type, size_t kN> inline
+auto VectorSimd<Type, kN>::storeMask(const __m256i v) noexcept -> ResultVector
+{
+  ResultVector result;
+  _mm256_store_si256(zisc::treatAs<__m256i*>(&result), v);
+  return result;
+}
+
+#endif // ZINVUL_CPPCL_AVX
+
+} // namespace cl
+
+} // namespace zinvul
+
+#endif // ZINVUL_CL_VECTOR_SIMD_INL_HPP
@@ -0,0 +1,165 @@
+/*!
+  \file vector_simd.hpp
+  \author Sho Ikeda
+
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CL_VECTOR_SIMD_HPP
+#define ZINVUL_CL_VECTOR_SIMD_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <type_traits>
+// Zinvul
+#include "types.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+#if defined(ZINVUL_ENABLE_CPPCL_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (2 <= _M_IX86_FP))
+#define ZINVUL_CPPCL_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(ZINVUL_CPPCL_SSE2) && (defined(__SSE4_1__) || defined(__AVX__))
+#define ZINVUL_CPPCL_SSE4_1 1
+#include <smmintrin.h>
+#endif
+#if defined(ZINVUL_CPPCL_SSE2) && defined(__AVX__)
+#define ZINVUL_CPPCL_AVX 1
+#include <immintrin.h>
+#endif
+#endif // ZINVUL_ENABLE_CPPCL_SIMD
+
+namespace zinvul {
+
+namespace cl {
+
+// Forward declaration
+template <typename Type, size_t kN> struct Vector;
+
+/*!
+  \brief Element-wise operations of vectors
+  */
+enum class SimdOperation : uint32b
+{
+  kAddition = 0,
+  kSubtraction,
+  kMultiplication,
+  kDivision,
+  kBitwiseAnd,
+  kBitwiseOr,
+  kBitwiseXor,
+  kEqual,
+  kLess,
+  kLessEqual
+};
+
+/*!
+  \brief Perform vector operations with SIMD instructions
+
+  The instruction sets are selected at compile time. float3, float4,
+  (u)int3, (u)int4 and double2 use 128bit registers and double3 and double4
+  use 256bit registers if AVX is available. The padding element of
+  3-component vectors is computed as an ordinary element. The operations
+  which aren't enabled fall back on the element-wise loops.
+  */
+template <typename Type, size_t kN>
+class VectorSimd
+{
+ public:
+  using VectorType = Vector<Type, kN>;
+  using ResultVector = Vector<Config::ComparisonResultType<Type>, kN>;
+
+
+  //! Check if the given operation is performed with SIMD instructions
+  static constexpr bool isEnabled(const SimdOperation operation) noexcept;
+
+
+  //! Perform element-wise addition
+  static VectorType add(const VectorType& lhs, const VectorType& rhs) noexcept;
+
+  //! Perform element-wise bitwise and
+  static VectorType bitAnd(const VectorType& lhs,
+                           const VectorType& rhs) noexcept;
+
+  //! Perform element-wise bitwise or
+  static VectorType bitOr(const VectorType& lhs,
+                          const VectorType& rhs) noexcept;
+
+  //! Perform element-wise bitwise xor
+  static VectorType bitXor(const VectorType& lhs,
+                           const VectorType& rhs) noexcept;
+
+  //! Perform element-wise division
+  static VectorType div(const VectorType& lhs, const VectorType& rhs) noexcept;
+
+  //! Perform element-wise equality comparison
+  static ResultVector equal(const VectorType& lhs,
+                            const VectorType& rhs) noexcept;
+
+  //! Perform element-wise less than comparison
+  static ResultVector less(const VectorType& lhs,
+                           const VectorType& rhs) noexcept;
+
+  //! Perform element-wise less than or equal comparison
+  static ResultVector lessEqual(const VectorType& lhs,
+                                const VectorType& rhs) noexcept;
+
+  //! Perform element-wise multiplication
+  static VectorType mul(const VectorType& lhs, const VectorType& rhs) noexcept;
+
+  //! Perform element-wise subtraction
+  static VectorType sub(const VectorType& lhs, const VectorType& rhs) noexcept;
+
+ private:
+  //! Check if the vector is packed into a 256bit double register
+  static constexpr bool isDouble4() noexcept;
+
+  //! Check if the vector is packed into a 128bit double register
+  static constexpr bool isDouble2() noexcept;
+
+  //! Check if the vector is packed into a 128bit float register
+  static constexpr bool isFloat4() noexcept;
+
+  //! Check if the vector is packed into a 128bit integer register
+  static constexpr bool isInt4() noexcept;
+
+#if defined(ZINVUL_CPPCL_SSE2)
+  //! Load a vector into a register
+  static auto load(const VectorType& v) noexcept;
+
+  //! Flip the sign bits of unsigned integers for signed comparison
+  static __m128i toSigned(const __m128i v) noexcept;
+
+  //! Store a register into a vector
+  static VectorType store(const __m128 v) noexcept;
+
+  //! Store a register into a vector
+  static VectorType store(const __m128i v) noexcept;
+
+  //! Store a register into a vector
+  static VectorType store(const __m128d v) noexcept;
+
+  //! Store a comparison mask into a vector
+  static ResultVector storeMask(const __m128i v) noexcept;
+#endif // ZINVUL_CPPCL_SSE2
+
+#if defined(ZINVUL_CPPCL_AVX)
+  //! Store a register into a vector
+  static VectorType store(const __m256d v) noexcept;
+
+  //! Store a comparison mask into a vector
+  static ResultVector storeMask(const __m256i v) noexcept;
+#endif // ZINVUL_CPPCL_AVX
+};
+
+} // namespace cl
+
+} // namespace zinvul
+
+#include "vector_simd-inl.hpp"
+
+#endif // ZINVUL_CL_VECTOR_SIMD_HPP
@@ -17,16 +17,23 @@
 
 #include "cpu_buffer.hpp"
 // Standard C++ library
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 // Zisc
+#include "zisc/error.hpp"
 #include "zisc/std_memory_resource.hpp"
 #include "zisc/utility.hpp"
 // Zinvul
+#include "cpu_command_list.hpp"
 #include "cpu_device.hpp"
+#include "utility/default_init_allocator.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/sub_platform.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -57,7 +64,7 @@ CpuBuffer<T>::~CpuBuffer() noexcept
   \return No description
   */
 template <typename T> inline
-auto CpuBuffer<T>::buffer() noexcept -> zisc::pmr::vector<Type>&
+auto CpuBuffer<T>::buffer() noexcept -> BufferImpl&
 {
   return *buffer_;
 }
@@ -68,11 +75,80 @@ auto CpuBuffer<T>::buffer() noexcept -> zisc::pmr::vector<Type>&
   \return No description
   */
 template <typename T> inline
-auto CpuBuffer<T>::buffer() const noexcept -> const zisc::pmr::vector<Type>&
+auto CpuBuffer<T>::buffer() const noexcept -> const BufferImpl&
 {
   return *buffer_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+std::size_t CpuBuffer<T>::capacity() const noexcept
+{
+  const std::size_t cap = (buffer_) ? buffer().capacity() : 0;
+  return cap;
+}
+
+/*!
+  \details The copy is executed asynchronously after the commands which were
+  submitted to the queue before. Both buffers must be alive until the
+  returned fence is signaled
+
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  \param [in] queue_index No description.
+  \return No description
+  */
+template <typename T> inline
+Fence CpuBuffer<T>::copyTo(Buffer<T>* dst,
+                           const std::size_t count,
+                           const std::size_t src_offset,
+                           const std::size_t dst_offset,
+                           const uint32b queue_index) const
+{
+  ZISC_ASSERT(dst->type() == SubPlatformType::kCpu,
+              "The dst buffer isn't a cpu buffer.");
+  ZISC_ASSERT((src_offset + count) <= size(), "The src range is out of bounds.");
+  ZISC_ASSERT((dst_offset + count) <= dst->size(), "The dst range is out of bounds.");
+  auto dst_buffer = zisc::cast<CpuBuffer*>(dst);
+  auto command = [src = data() + src_offset,
+                  d = dst_buffer->data() + dst_offset,
+                  count]() noexcept
+  {
+    copyData(src, count, d);
+  };
+  auto& device = const_cast<CpuDevice&>(parentImpl());
+  const auto fence = device.submit(queue_index, std::move(command));
+  return fence;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+auto CpuBuffer<T>::data() noexcept -> Pointer
+{
+  return buffer().data();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+auto CpuBuffer<T>::data() const noexcept -> ConstPointer
+{
+  return buffer().data();
+}
+
 /*!
   \details No detailed description
 
@@ -118,7 +194,79 @@ bool CpuBuffer<T>::isHostVisible() const noexcept
 }
 
 /*!
-  \details No detailed description
+  \details The elements are copied directly since the buffer is on the host
+  memory. The kernels which write to the buffer must be completed
+
+  \param [out] data No description.
+  \param [in] count No description.
+  \param [in] offset No description.
+  \param [in] queue_index No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::read(Pointer data,
+                        const std::size_t count,
+                        const std::size_t offset,
+                        const uint32b /* queue_index */) const
+{
+  ZISC_ASSERT((offset + count) <= size(), "The range is out of bounds.");
+  copyData(this->data() + offset, count, data);
+}
+
+/*!
+  \details The pointers to the elements are recorded, so the buffers must not
+  be resized until the command list is cleared
+
+  \param [in,out] command_list No description.
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::recordCopyTo(CommandList* command_list,
+                                Buffer<T>* dst,
+                                const std::size_t count,
+                                const std::size_t src_offset,
+                                const std::size_t dst_offset) const
+{
+  ZISC_ASSERT(command_list->type() == SubPlatformType::kCpu,
+              "The command list isn't a cpu command list.");
+  ZISC_ASSERT(dst->type() == SubPlatformType::kCpu,
+              "The dst buffer isn't a cpu buffer.");
+  ZISC_ASSERT((src_offset + count) <= size(), "The src range is out of bounds.");
+  ZISC_ASSERT((dst_offset + count) <= dst->size(), "The dst range is out of bounds.");
+  auto list = zisc::cast<CpuCommandList*>(command_list);
+  auto dst_buffer = zisc::cast<CpuBuffer*>(dst);
+  auto command = [src = data() + src_offset,
+                  d = dst_buffer->data() + dst_offset,
+                  count]() noexcept
+  {
+    copyData(src, count, d);
+  };
+  list->addCommand(std::move(command));
+}
+
+/*!
+  \details The elements are kept
+
+  \param [in] s No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::reserve(const std::size_t s)
+{
+  if (capacity() < s) {
+    prepareBuffer();
+    const std::size_t prev_cap = capacity();
+    buffer().reserve(s);
+    notifyOfCapacityChange(prev_cap);
+  }
+}
+
+/*!
+  \details The memory is reallocated only if the size exceeds the capacity,
+  so shrinking the buffer doesn't release the memory.
+  The new elements are default-initialized, so the elements of a trivial
+  type are left uninitialized
 
   \param [in] s No description.
   */
@@ -128,16 +276,22 @@ void CpuBuffer<T>::setSize(const std::size_t s)
   const std::size_t prev_size = size();
   if (s != prev_size) {
     prepareBuffer();
-    const std::size_t prev_cap = buffer().capacity();
+    const std::size_t prev_cap = capacity();
     buffer().resize(s);
-    const std::size_t cap = buffer().capacity();
-    if (cap != prev_cap) {
-      auto& device = parentImpl();
-      const std::size_t prev_mem_size = sizeof(Type) * prev_cap;
-      device.notifyDeallocation(prev_mem_size);
-      const std::size_t mem_size = sizeof(Type) * cap;
-      device.notifyAllocation(mem_size);
-    }
+    notifyOfCapacityChange(prev_cap);
+  }
+}
+
+/*!
+  \details The elements are kept
+  */
+template <typename T> inline
+void CpuBuffer<T>::shrinkToFit()
+{
+  if (size() < capacity()) {
+    const std::size_t prev_cap = capacity();
+    buffer().shrink_to_fit();
+    notifyOfCapacityChange(prev_cap);
   }
 }
 
@@ -155,11 +309,46 @@ std::size_t CpuBuffer<T>::size() const noexcept
 
 /*!
   \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+SubPlatformType CpuBuffer<T>::type() const noexcept
+{
+  return SubPlatformType::kCpu;
+}
+
+/*!
+  \details The elements are copied directly since the buffer is on the host
+  memory. The kernels which access to the buffer must be completed
+
+  \param [in] data No description.
+  \param [in] count No description.
+  \param [in] offset No description.
+  \param [in] queue_index No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::write(ConstPointer data,
+                         const std::size_t count,
+                         const std::size_t offset,
+                         const uint32b /* queue_index */)
+{
+  ZISC_ASSERT((offset + count) <= size(), "The range is out of bounds.");
+  copyData(data, count, this->data() + offset);
+}
+
+/*!
+  \details The memory is released from the memory usage of the device
   */
 template <typename T> inline
 void CpuBuffer<T>::destroyData() noexcept
 {
-  buffer_.reset();
+  if (buffer_) {
+    auto& device = parentImpl();
+    device.notifyDeallocation(sizeof(Type) * capacity());
+    device.memoryRegistry().remove(Buffer<T>::id());
+    buffer_.reset();
+  }
 }
 
 /*!
@@ -171,6 +360,58 @@ void CpuBuffer<T>::initData()
   prepareBuffer();
 }
 
+/*!
+  \details Trivially copyable elements are copied with memcpy
+
+  \param [in] src No description.
+  \param [in] count No description.
+  \param [out] dst No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::copyData(ConstPointer src,
+                            const std::size_t count,
+                            Pointer dst) noexcept
+{
+  if constexpr (std::is_trivially_copyable_v<Type>) {
+    if (0 < count)
+      std::memcpy(dst, src, sizeof(Type) * count);
+  }
+  else {
+    std::copy_n(src, count, dst);
+  }
+}
+
+/*!
+  \details The buffer memory is host memory, so it's accessed directly
+
+  \return No description
+  */
+template <typename T> inline
+auto CpuBuffer<T>::mappedMemory() const noexcept -> Pointer
+{
+  Pointer d = const_cast<Pointer>(data());
+  return d;
+}
+
+/*!
+  \details The memory of a cpu buffer is in the heap 0 of the memory type 0
+
+  \param [in] prev_cap No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::notifyOfCapacityChange(const std::size_t prev_cap) noexcept
+{
+  const std::size_t cap = capacity();
+  if (cap != prev_cap) {
+    auto& device = parentImpl();
+    const std::size_t prev_mem_size = sizeof(Type) * prev_cap;
+    device.notifyDeallocation(prev_mem_size);
+    const std::size_t mem_size = sizeof(Type) * cap;
+    device.notifyAllocation(mem_size);
+    device.memoryRegistry().update(Buffer<T>::id(), mem_size, Buffer<T>::usage(), 0, 0);
+  }
+}
+
 /*!
   \details No detailed description
 
@@ -196,7 +437,10 @@ const CpuDevice& CpuBuffer<T>::parentImpl() const noexcept
 }
 
 /*!
-  \details No detailed description
+  \details The data is allocated with the buffer memory resource of the
+  device, which places the pages on NUMA nodes. The data is aligned to the
+  buffer alignment of the device, so kernels can use aligned loads and the
+  data of different buffers never share a cache line
   */
 template <typename T> inline
 void CpuBuffer<T>::prepareBuffer() noexcept
@@ -204,13 +448,26 @@ void CpuBuffer<T>::prepareBuffer() noexcept
   if (!buffer_) {
     auto mem_resource = Buffer<T>::memoryResource();
     using BufferImplType = typename decltype(buffer_)::element_type;
-    typename BufferImplType::allocator_type alloc{mem_resource};
+    auto& device = parentImpl();
+    typename BufferImplType::allocator_type alloc{device.bufferMemoryResource(),
+                                                  device.bufferAlignment()};
     BufferImplType buffer{alloc};
     buffer_ = zisc::pmr::allocateUnique<BufferImplType>(mem_resource,
                                                         std::move(buffer));
   }
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] is_written No description.
+  */
+template <typename T> inline
+void CpuBuffer<T>::unmapMemory(const bool is_written) const noexcept
+{
+  static_cast<void>(is_written);
+}
+
 // Device
 
 /*!
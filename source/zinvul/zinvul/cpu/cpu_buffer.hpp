@@ -22,13 +22,16 @@
 // Zisc
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
+#include "utility/default_init_allocator.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
 
 namespace zinvul {
 
 // Forward declaration
+class CommandList;
 class CpuDevice;
 
 /*!
@@ -47,6 +50,7 @@ class CpuBuffer : public Buffer<T>
   using ConstType = typename Buffer<T>::ConstType;
   using Pointer = typename Buffer<T>::Pointer;
   using ConstPointer = typename Buffer<T>::ConstPointer;
+  using BufferImpl = std::vector<Type, DefaultInitAllocator<Type>>;
 
 
   //! Initialize the buffer
@@ -57,10 +61,26 @@ class CpuBuffer : public Buffer<T>
 
 
   //! Return the buffer data
-  zisc::pmr::vector<Type>& buffer() noexcept;
+  BufferImpl& buffer() noexcept;
 
   //! Return the buffer data
-  const zisc::pmr::vector<Type>& buffer() const noexcept;
+  const BufferImpl& buffer() const noexcept;
+
+  //! Return the number of elements which the buffer can hold without reallocation
+  std::size_t capacity() const noexcept override;
+
+  //! Copy the elements of the buffer to the dst buffer on the queue
+  Fence copyTo(Buffer<T>* dst,
+               const std::size_t count,
+               const std::size_t src_offset,
+               const std::size_t dst_offset,
+               const uint32b queue_index) const override;
+
+  //! Return the pointer to the first element
+  Pointer data() noexcept;
+
+  //! Return the pointer to the first element
+  ConstPointer data() const noexcept;
 
   //! Check if the buffer is the most efficient for the device access
   bool isDeviceLocal() const noexcept override;
@@ -74,12 +94,40 @@ class CpuBuffer : public Buffer<T>
   //! Check if the buffer can be mapped for the host access
   bool isHostVisible() const noexcept override;
 
-  //! Change the number of elements
+  //! Read the elements of the buffer to the host memory
+  void read(Pointer data,
+            const std::size_t count,
+            const std::size_t offset,
+            const uint32b queue_index) const override;
+
+  //! Record a copy of the elements of the buffer to the dst buffer in the list
+  void recordCopyTo(CommandList* command_list,
+                    Buffer<T>* dst,
+                    const std::size_t count,
+                    const std::size_t src_offset,
+                    const std::size_t dst_offset) const override;
+
+  //! Reserve the memory for at least the given number of elements
+  void reserve(const std::size_t s) override;
+
+  //! Change the number of elements without initializing the new elements
   void setSize(const std::size_t s) override;
 
+  //! Release the memory which isn't used by the elements
+  void shrinkToFit() override;
+
   //! Return the number of elements
   std::size_t size() const noexcept override;
 
+  //! Return the sub-platform type of the buffer
+  SubPlatformType type() const noexcept override;
+
+  //! Write the elements of the host memory to the buffer
+  void write(ConstPointer data,
+             const std::size_t count,
+             const std::size_t offset,
+             const uint32b queue_index) override;
+
  protected:
   //! Clear the contents of the buffer
   void destroyData() noexcept override;
@@ -88,6 +136,17 @@ class CpuBuffer : public Buffer<T>
   void initData() override;
 
  private:
+  //! Copy elements from the src to the dst
+  static void copyData(ConstPointer src,
+                       const std::size_t count,
+                       Pointer dst) noexcept;
+
+  //! Return the pointer to the mapped memory of the buffer
+  Pointer mappedMemory() const noexcept override;
+
+  //! Notify the device of the change of the capacity
+  void notifyOfCapacityChange(const std::size_t prev_cap) noexcept;
+
   //! Return the device
   CpuDevice& parentImpl() noexcept;
 
@@ -97,8 +156,11 @@ class CpuBuffer : public Buffer<T>
   //! Prepare a buffer for use
   void prepareBuffer() noexcept;
 
+  //! Release the mapped memory of the buffer
+  void unmapMemory(const bool is_written) const noexcept override;
+
 
-  zisc::pmr::unique_ptr<zisc::pmr::vector<Type>> buffer_;
+  zisc::pmr::unique_ptr<BufferImpl> buffer_;
 };
 
 } // namespace zinvul
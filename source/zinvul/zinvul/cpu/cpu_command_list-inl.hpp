@@ -0,0 +1,239 @@
+/*!
+  \file cpu_command_list-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CPU_COMMAND_LIST_INL_HPP
+#define ZINVUL_CPU_COMMAND_LIST_INL_HPP
+
+#include "cpu_command_list.hpp"
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "cpu_device.hpp"
+#include "utility/work_layout.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \tparam Function No description.
+  \param [in] command No description.
+  */
+template <typename Function> inline
+void CpuCommandList::addCommand(Function&& command)
+{
+  Entry entry;
+  entry.closure_ = makeClosure<Command>(std::forward<Function>(command));
+  entry_list_->emplace_back(entry);
+}
+
+/*!
+  \details The local work-group size is decided in the same way as
+  CpuDevice::submitBatch
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] lane_size No description.
+  \param [in] kernel_id No description.
+  \param [in] command No description.
+  */
+template <std::size_t kDimension, typename Function> inline
+void CpuCommandList::addBatchKernel(
+    const std::array<uint32b, kDimension>& work_size,
+    const uint32b lane_size,
+    const void* kernel_id,
+    Function&& command)
+{
+  addBatchKernel(work_size, lane_size, kernel_id, WorkLayout{},
+                 std::forward<Function>(command));
+}
+
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] lane_size No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  */
+template <std::size_t kDimension, typename Function> inline
+void CpuCommandList::addBatchKernel(
+    const std::array<uint32b, kDimension>& work_size,
+    const uint32b lane_size,
+    const void* kernel_id,
+    const WorkLayout& work_layout,
+    Function&& command)
+{
+  Entry entry;
+  entry.closure_ = makeClosure<BatchCommand>(std::forward<Function>(command));
+  entry.work_size_ = {{1, 1, 1}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    entry.work_size_[i] = work_size[i];
+  entry.local_work_size_ = {{lane_size, 1, 1}};
+  entry.kernel_id_ = kernel_id;
+  entry.work_layout_ = work_layout;
+  entry.lane_size_ = lane_size;
+  entry_list_->emplace_back(entry);
+}
+
+/*!
+  \details The local work-group size is decided in the same way as
+  CpuDevice::submit and CpuDevice::submitLockStep
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] kernel_id No description.
+  \param [in] lock_step_enabled No description.
+  \param [in] command No description.
+  */
+template <std::size_t kDimension, typename Function> inline
+void CpuCommandList::addKernel(const std::array<uint32b, kDimension>& work_size,
+                               const std::size_t local_memory_size,
+                               const void* kernel_id,
+                               const bool lock_step_enabled,
+                               Function&& command)
+{
+  addKernel(work_size, local_memory_size, kernel_id, lock_step_enabled,
+            WorkLayout{}, std::forward<Function>(command));
+}
+
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] kernel_id No description.
+  \param [in] lock_step_enabled No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  */
+template <std::size_t kDimension, typename Function> inline
+void CpuCommandList::addKernel(const std::array<uint32b, kDimension>& work_size,
+                               const std::size_t local_memory_size,
+                               const void* kernel_id,
+                               const bool lock_step_enabled,
+                               const WorkLayout& work_layout,
+                               Function&& command)
+{
+  const auto& device = parentImpl();
+  Entry entry;
+  entry.closure_ = makeClosure<Command>(std::forward<Function>(command));
+  entry.work_size_ = {{1, 1, 1}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    entry.work_size_[i] = work_size[i];
+  entry.local_work_size_ = lock_step_enabled
+      ? device.lockStepLocalWorkSize<kDimension>()
+      : device.localWorkSize<kDimension>();
+  entry.local_memory_size_ = local_memory_size;
+  entry.kernel_id_ = kernel_id;
+  entry.work_layout_ = work_layout;
+  entry.lane_size_ = lock_step_enabled
+      ? cl::inner::WorkGroup::lockStepLaneSize()
+      : 1;
+  entry_list_->emplace_back(entry);
+}
+
+/*!
+  \details No detailed description
+
+  \tparam CommandT No description.
+  \tparam Function No description.
+  \param [in] function No description.
+  \return No description
+  */
+template <typename CommandT, typename Function> inline
+auto CpuCommandList::makeClosure(Function&& function) -> Closure*
+{
+  using ClosureT = FunctionClosure<std::decay_t<Function>, CommandT>;
+  zisc::pmr::polymorphic_allocator<ClosureT> alloc{memoryResource()};
+  ClosureT* closure = alloc.allocate(1);
+  ::new (closure) ClosureT{std::forward<Function>(function)};
+  return closure;
+}
+
+/*!
+  \details The reference is built from the function once
+
+  \param [in] function No description.
+  */
+template <typename Function, typename CommandT> inline
+CpuCommandList::FunctionClosure<Function, CommandT>::FunctionClosure(
+    Function function) noexcept : function_{std::move(function)},
+                                  command_{function_}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \return Null if the closure isn't a batch command
+  */
+template <typename Function, typename CommandT> inline
+auto CpuCommandList::FunctionClosure<Function, CommandT>::batchCommand()
+    const noexcept -> const BatchCommand*
+{
+  const BatchCommand* c = nullptr;
+  if constexpr (std::is_same_v<BatchCommand, CommandT>)
+    c = std::addressof(command_);
+  return c;
+}
+
+/*!
+  \details No detailed description
+
+  \return Null if the closure is a batch command
+  */
+template <typename Function, typename CommandT> inline
+auto CpuCommandList::FunctionClosure<Function, CommandT>::command()
+    const noexcept -> const Command*
+{
+  const Command* c = nullptr;
+  if constexpr (std::is_same_v<Command, CommandT>)
+    c = std::addressof(command_);
+  return c;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+template <typename Function, typename CommandT> inline
+void CpuCommandList::FunctionClosure<Function, CommandT>::release(
+    zisc::pmr::memory_resource* mem_resource) noexcept
+{
+  zisc::pmr::polymorphic_allocator<FunctionClosure> alloc{mem_resource};
+  this->~FunctionClosure();
+  alloc.deallocate(this, 1);
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_CPU_COMMAND_LIST_INL_HPP
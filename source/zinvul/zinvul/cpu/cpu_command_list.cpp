@@ -0,0 +1,201 @@
+/*!
+  \file cpu_command_list.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "cpu_command_list.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <memory>
+#include <utility>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "cpu_device.hpp"
+#include "zinvul/command_list.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/utility/id_data.hpp"
+#include "zinvul/utility/zinvul_object.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] id No description.
+  */
+CpuCommandList::CpuCommandList(IdData&& id) noexcept :
+    CommandList(std::move(id))
+{
+}
+
+/*!
+  \details No detailed description
+  */
+CpuCommandList::~CpuCommandList() noexcept
+{
+  destroy();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t CpuCommandList::numOfCommands() const noexcept
+{
+  const std::size_t n = entry_list_ ? entry_list_->size() : 0;
+  return n;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+SubPlatformType CpuCommandList::type() const noexcept
+{
+  return SubPlatformType::kCpu;
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuCommandList::clearCommands() noexcept
+{
+  if (entry_list_) {
+    for (auto& entry : *entry_list_)
+      entry.closure_->release(memoryResource());
+    entry_list_->clear();
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuCommandList::destroyData() noexcept
+{
+  clearCommands();
+  entry_list_.reset();
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuCommandList::initData()
+{
+  auto mem_resource = memoryResource();
+  using EntryList = decltype(entry_list_)::element_type;
+  EntryList entry_list{EntryList::allocator_type{mem_resource}};
+  zisc::pmr::polymorphic_allocator<EntryList> alloc{mem_resource};
+  entry_list_ = zisc::pmr::allocateUnique(alloc, std::move(entry_list));
+}
+
+/*!
+  \details The whole list is a single command of the queue
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+Fence CpuCommandList::replayCommands(const uint32b queue_index)
+{
+  auto& device = parentImpl();
+  auto command = [this]() noexcept
+  {
+    execute();
+  };
+  const auto fence = device.submit(queue_index, std::move(command));
+  return fence;
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuCommandList::execute() noexcept
+{
+  auto& device = parentImpl();
+  for (const auto& entry : *entry_list_) {
+    const Closure& closure = *entry.closure_;
+    if (const BatchCommand* batch_command = closure.batchCommand()) {
+      device.execute(entry.work_size_,
+                     entry.lane_size_,
+                     entry.kernel_id_,
+                     entry.work_layout_,
+                     *batch_command);
+    }
+    else if (0 < entry.lane_size_) {
+      device.execute(entry.work_size_,
+                     entry.local_work_size_,
+                     entry.local_memory_size_,
+                     entry.lane_size_,
+                     entry.kernel_id_,
+                     entry.work_layout_,
+                     *closure.command());
+    }
+    else {
+      (*closure.command())();
+    }
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+CpuDevice& CpuCommandList::parentImpl() noexcept
+{
+  auto p = getParent();
+  return *zisc::treatAs<CpuDevice*>(p);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+const CpuDevice& CpuCommandList::parentImpl() const noexcept
+{
+  const auto p = getParent();
+  return *zisc::treatAs<const CpuDevice*>(p);
+}
+
+/*!
+  \details No detailed description
+  */
+CpuCommandList::Closure::~Closure() noexcept
+{
+}
+
+// Device
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+SharedCommandList CpuDevice::makeCommandList() noexcept
+{
+  zisc::pmr::polymorphic_allocator<CpuCommandList> alloc{memoryResource()};
+  std::shared_ptr<CpuCommandList> list =
+      std::allocate_shared<CpuCommandList>(alloc, issueId());
+
+  ZinvulObject::SharedPtr parent{getOwn()};
+  WeakCommandList own{list};
+  list->initialize(std::move(parent), std::move(own));
+
+  return list;
+}
+
+} // namespace zinvul
@@ -0,0 +1,191 @@
+/*!
+  \file cpu_command_list.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CPU_COMMAND_LIST_HPP
+#define ZINVUL_CPU_COMMAND_LIST_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "cpu_device.hpp"
+#include "utility/work_layout.hpp"
+#include "zinvul/command_list.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/utility/id_data.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief A command list of a cpu device
+
+  The kernel commands are recorded as closures with their launch parameters,
+  which are built once. A replay submits one command which executes the
+  closures in order with the worker threads of the device.
+  */
+class CpuCommandList : public CommandList
+{
+ public:
+  // Type aliases
+  using Command = CpuDevice::Command;
+  using BatchCommand = CpuDevice::BatchCommand;
+
+
+  //! Initialize the command list
+  CpuCommandList(IdData&& id) noexcept;
+
+  //! Finalize the command list
+  ~CpuCommandList() noexcept override;
+
+
+  //! Record a host command
+  template <typename Function>
+  void addCommand(Function&& command);
+
+  //! Record a kernel command
+  template <std::size_t kDimension, typename Function>
+  void addKernel(const std::array<uint32b, kDimension>& work_size,
+                 const std::size_t local_memory_size,
+                 const void* kernel_id,
+                 const bool lock_step_enabled,
+                 Function&& command);
+
+  //! Record a kernel command in the work layout
+  template <std::size_t kDimension, typename Function>
+  void addKernel(const std::array<uint32b, kDimension>& work_size,
+                 const std::size_t local_memory_size,
+                 const void* kernel_id,
+                 const bool lock_step_enabled,
+                 const WorkLayout& work_layout,
+                 Function&& command);
+
+  //! Record a kernel command which processes a range of work-groups at once
+  template <std::size_t kDimension, typename Function>
+  void addBatchKernel(const std::array<uint32b, kDimension>& work_size,
+                      const uint32b lane_size,
+                      const void* kernel_id,
+                      Function&& command);
+
+  //! Record a batch kernel command in the work layout
+  template <std::size_t kDimension, typename Function>
+  void addBatchKernel(const std::array<uint32b, kDimension>& work_size,
+                      const uint32b lane_size,
+                      const void* kernel_id,
+                      const WorkLayout& work_layout,
+                      Function&& command);
+
+  //! Return the number of recorded commands
+  std::size_t numOfCommands() const noexcept override;
+
+  //! Return the sub-platform type of the command list
+  SubPlatformType type() const noexcept override;
+
+ protected:
+  //! Remove all recorded commands of the device
+  void clearCommands() noexcept override;
+
+  //! Clear the contents of the command list
+  void destroyData() noexcept override;
+
+  //! Initialize the command list
+  void initData() override;
+
+  //! Submit the recorded commands of the device to the queue
+  Fence replayCommands(const uint32b queue_index) override;
+
+ private:
+  /*!
+    \brief A recorded function object
+    */
+  class Closure
+  {
+   public:
+    //! Finalize the closure
+    virtual ~Closure() noexcept;
+
+    //! Return the reference to the function of a batch command
+    virtual const BatchCommand* batchCommand() const noexcept = 0;
+
+    //! Return the reference to the function of a work-item or host command
+    virtual const Command* command() const noexcept = 0;
+
+    //! Destroy the closure and deallocate the memory
+    virtual void release(zisc::pmr::memory_resource* mem_resource) noexcept = 0;
+  };
+
+  /*!
+    \brief A closure which holds a function object
+    */
+  template <typename Function, typename CommandT>
+  class FunctionClosure : public Closure
+  {
+   public:
+    //! Create a closure
+    FunctionClosure(Function function) noexcept;
+
+
+    //! Return the reference to the function of a batch command
+    const BatchCommand* batchCommand() const noexcept override;
+
+    //! Return the reference to the function of a work-item or host command
+    const Command* command() const noexcept override;
+
+    //! Destroy the closure and deallocate the memory
+    void release(zisc::pmr::memory_resource* mem_resource) noexcept override;
+
+   private:
+    Function function_;
+    CommandT command_;
+  };
+
+  /*!
+    \brief A recorded command and its launch parameters
+    */
+  struct Entry
+  {
+    Closure* closure_ = nullptr;
+    std::array<uint32b, 3> work_size_;
+    std::array<uint32b, 3> local_work_size_;
+    std::size_t local_memory_size_ = 0;
+    const void* kernel_id_ = nullptr;
+    WorkLayout work_layout_;
+    uint32b lane_size_ = 0; //!< Zero for a host command
+  };
+
+
+  //! Execute the recorded commands in order
+  void execute() noexcept;
+
+  //! Make a closure of the function
+  template <typename CommandT, typename Function>
+  Closure* makeClosure(Function&& function);
+
+  //! Return the device
+  CpuDevice& parentImpl() noexcept;
+
+  //! Return the device
+  const CpuDevice& parentImpl() const noexcept;
+
+
+  zisc::pmr::unique_ptr<zisc::pmr::vector<Entry>> entry_list_;
+};
+
+} // namespace zinvul
+
+#include "cpu_command_list-inl.hpp"
+
+#endif // ZINVUL_CPU_COMMAND_LIST_HPP
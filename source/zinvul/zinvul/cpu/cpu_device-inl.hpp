@@ -17,8 +17,10 @@
 
 #include "cpu_device.hpp"
 // Standard C++ library
+#include <array>
 #include <cstddef>
 #include <memory>
+#include <utility>
 // Zisc
 #include "zisc/memory.hpp"
 #include "zisc/thread_manager.hpp"
@@ -26,7 +28,11 @@
 // Zinvul
 #include "cpu_device_info.hpp"
 #include "cpu_sub_platform.hpp"
+#include "utility/command_queue.hpp"
+#include "utility/work_layout.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
 
 namespace zinvul {
 
@@ -40,6 +46,35 @@ namespace zinvul {
 ////  b.resize(size);
 ////
 ////  const std::size_t memory_usage = deviceMemoryUsage() + buffer->memoryUsage();
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t CpuDevice::bufferAlignment() const noexcept
+{
+  const auto& sub_platform = parentImpl();
+  return sub_platform.bufferAlignment();
+}
+
+/*!
+  \details The memory of buffers is placed on NUMA nodes according to the
+  memory policy of the sub-platform, and large buffers are backed by huge
+  pages according to the huge page policy
+
+  \return No description
+  */
+inline
+zisc::pmr::memory_resource* CpuDevice::bufferMemoryResource() noexcept
+{
+  zisc::pmr::memory_resource* mem_resource =
+      buffer_mem_resource_ ? buffer_mem_resource_.get() :
+      huge_page_mem_resource_ ? huge_page_mem_resource_.get()
+                              : memoryResource();
+  return mem_resource;
+}
+
 /*!
   \details No detailed description
 
@@ -52,6 +87,20 @@ const CpuDeviceInfo& CpuDevice::deviceInfoData() const noexcept
   return *zisc::cast<const CpuDeviceInfo*>(std::addressof(info));
 }
 
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \return No description
+  */
+template <std::size_t kDimension> inline
+const std::array<uint32b, 3>& CpuDevice::localWorkSize() const noexcept
+{
+  static_assert((0 < kDimension) && (kDimension <= 3),
+                "The dimension is out of range.");
+  return work_group_size_list_[kDimension - 1];
+}
+
 /*!
   \details No detailed description
 
@@ -86,6 +135,246 @@ std::size_t CpuDevice::numOfThreads() const noexcept
   return thread_manager.numOfThreads();
 }
 
+/*!
+  \details The command is executed asynchronously after the commands which
+  were submitted to the queue before. The command is moved or copied into
+  the queue, so the objects referred by the command must be alive until the
+  returned fence is signaled
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submit(const std::array<uint32b, kDimension>& work_size,
+                        const std::size_t local_memory_size,
+                        const uint32b queue_index,
+                        Function&& command) noexcept
+{
+  return submit(work_size, local_memory_size, queue_index, nullptr,
+                std::forward<Function>(command));
+}
+
+/*!
+  \details The task batch size of the command is learned by the kernel id
+  if the adaptive task batch is enabled. A null id uses the fixed task batch
+  size of the sub-platform
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submit(const std::array<uint32b, kDimension>& work_size,
+                        const std::size_t local_memory_size,
+                        const uint32b queue_index,
+                        const void* kernel_id,
+                        Function&& command) noexcept
+{
+  return submit(work_size, local_memory_size, queue_index, kernel_id,
+                WorkLayout{}, std::forward<Function>(command));
+}
+
+/*!
+  \details The tile size of the order is in work-items
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submit(const std::array<uint32b, kDimension>& work_size,
+                        const std::size_t local_memory_size,
+                        const uint32b queue_index,
+                        const void* kernel_id,
+                        const WorkLayout& work_layout,
+                        Function&& command) noexcept
+{
+  std::array<uint32b, 3> work_size_3d{{1, 1, 1}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    work_size_3d[i] = work_size[i];
+  auto c = [this, work_size_3d, local_memory_size, kernel_id, work_layout,
+            func = std::forward<Function>(command)]() noexcept
+  {
+    execute(work_size_3d, localWorkSize<kDimension>(), local_memory_size,
+            1, kernel_id, work_layout, func);
+  };
+  return submit(queue_index, std::move(c));
+}
+
+/*!
+  \details The command is executed on the dispatch thread of the queue
+  instead of the kernel threads
+
+  \tparam Function No description.
+  \param [in] queue_index No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <typename Function> inline
+Fence CpuDevice::submit(const uint32b queue_index, Function&& command) noexcept
+{
+  auto& queue = getQueue(queue_index);
+  const uint64b number = queue.enqueue(std::forward<Function>(command));
+  return Fence{this, queue_index, number};
+}
+
+/*!
+  \details The command is invoked with a range [begin, end) of work-group ids
+  and processes the work-groups in the range by itself, so the kernel body
+  can be inlined into the loop. A work-group consists of the lanes of one
+  invocation, so the kernel must not use barriers and local memory
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] lane_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submitBatch(const std::array<uint32b, kDimension>& work_size,
+                             const uint32b lane_size,
+                             const uint32b queue_index,
+                             const void* kernel_id,
+                             Function&& command) noexcept
+{
+  return submitBatch(work_size, lane_size, queue_index, kernel_id,
+                     WorkLayout{}, std::forward<Function>(command));
+}
+
+/*!
+  \details The command is invoked with a run of work-groups of a tile,
+  which have contiguous ids, when the order isn't row-major
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] lane_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submitBatch(const std::array<uint32b, kDimension>& work_size,
+                             const uint32b lane_size,
+                             const uint32b queue_index,
+                             const void* kernel_id,
+                             const WorkLayout& work_layout,
+                             Function&& command) noexcept
+{
+  std::array<uint32b, 3> work_size_3d{{1, 1, 1}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    work_size_3d[i] = work_size[i];
+  auto c = [this, work_size_3d, lane_size, kernel_id, work_layout,
+            func = std::forward<Function>(command)]() noexcept
+  {
+    execute(work_size_3d, lane_size, kernel_id, work_layout, func);
+  };
+  return submit(queue_index, std::move(c));
+}
+
+/*!
+  \details An invocation of the command processes the adjacent work-items of
+  x dimension as the lanes of cl::get_global_lane_id(), so that the kernel
+  can compute the lanes with the vector types in SIMD registers.
+  The x size of the local work-group is a multiple of the lane size, so the
+  local work-group size can be larger than the one of the device info
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                                const std::size_t local_memory_size,
+                                const uint32b queue_index,
+                                Function&& command) noexcept
+{
+  return submitLockStep(work_size, local_memory_size, queue_index, nullptr,
+                        std::forward<Function>(command));
+}
+
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                                const std::size_t local_memory_size,
+                                const uint32b queue_index,
+                                const void* kernel_id,
+                                Function&& command) noexcept
+{
+  return submitLockStep(work_size, local_memory_size, queue_index, kernel_id,
+                        WorkLayout{}, std::forward<Function>(command));
+}
+
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \tparam Function No description.
+  \param [in] work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] queue_index No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename Function> inline
+Fence CpuDevice::submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                                const std::size_t local_memory_size,
+                                const uint32b queue_index,
+                                const void* kernel_id,
+                                const WorkLayout& work_layout,
+                                Function&& command) noexcept
+{
+  std::array<uint32b, 3> work_size_3d{{1, 1, 1}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    work_size_3d[i] = work_size[i];
+  auto c = [this, work_size_3d, local_memory_size, kernel_id, work_layout,
+            func = std::forward<Function>(command)]() noexcept
+  {
+    constexpr uint32b lane_size = cl::inner::WorkGroup::lockStepLaneSize();
+    execute(work_size_3d, lockStepLocalWorkSize<kDimension>(),
+            local_memory_size, lane_size, kernel_id, work_layout, func);
+  };
+  return submit(queue_index, std::move(c));
+}
+
 /*!
   \details No detailed description
 
@@ -98,6 +387,21 @@ std::size_t CpuDevice::taskBatchSize() const noexcept
   return device.taskBatchSize();
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] kernel_id No description.
+  \return No description
+  */
+inline
+std::size_t CpuDevice::taskBatchSize(const void* kernel_id) const noexcept
+{
+  const std::size_t batch_size = (batch_tuner_ && (kernel_id != nullptr))
+      ? zisc::cast<std::size_t>(batch_tuner_->batchSize(kernel_id))
+      : taskBatchSize();
+  return batch_size;
+}
+
 /*!
   \details No detailed description
 
@@ -120,6 +424,20 @@ const zisc::ThreadManager& CpuDevice::threadManager() const noexcept
   return *thread_manager_;
 }
 
+/*!
+  \details No detailed description
+
+  \tparam kDimension No description.
+  \return No description
+  */
+template <std::size_t kDimension> inline
+const std::array<uint32b, 3>& CpuDevice::lockStepLocalWorkSize() const noexcept
+{
+  static_assert((0 < kDimension) && (kDimension <= 3),
+                "The dimension is out of range.");
+  return lock_step_group_size_list_[kDimension - 1];
+}
+
 
 ////  setDeviceMemoryUsage(memory_usage);
 ////  setHostMemoryUsage(memory_usage);
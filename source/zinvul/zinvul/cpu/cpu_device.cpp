@@ -14,10 +14,17 @@
 
 #include "cpu_device.hpp"
 // Standard C++ library
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <numeric>
 // Zisc
+#include "zisc/error.hpp"
 #include "zisc/memory.hpp"
 #include "zisc/std_memory_resource.hpp"
 #include "zisc/thread_manager.hpp"
@@ -25,9 +32,19 @@
 // Zinvul
 #include "cpu_device_info.hpp"
 #include "cpu_sub_platform.hpp"
+#include "utility/command_queue.hpp"
+#include "utility/huge_page_memory_resource.hpp"
+#include "utility/numa_memory_resource.hpp"
+#include "utility/numa_topology.hpp"
+#include "utility/task_batch_tuner.hpp"
+#include "utility/work_group_scheduler.hpp"
+#include "utility/work_layout.hpp"
+#include "utility/work_traversal.hpp"
 #include "zinvul/device.hpp"
 #include "zinvul/device_info.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
 #include "zinvul/utility/id_data.hpp"
 
 namespace zinvul {
@@ -49,14 +66,50 @@ CpuDevice::~CpuDevice() noexcept
   destroy();
 }
 
+/*!
+  \details The commands of a queue are executed in order, so the wait is
+  only required for a fence of another queue. The dispatch thread of the
+  queue is blocked until the fence is signaled
+
+  \param [in] queue_index No description.
+  \param [in] fence No description.
+  */
+void CpuDevice::enqueueWait(const uint32b queue_index, const Fence& fence) noexcept
+{
+  const bool is_same_queue = (fence.device() == this) &&
+                             (fence.queueIndex() == queue_index);
+  if (!fence || is_same_queue || fence.isCompleted())
+    return;
+  submit(queue_index, [fence]() noexcept
+  {
+    fence.wait();
+  });
+}
+
 /*!
   \details No detailed description
 
+  \param [in] fence No description.
+  \return No description
+  */
+bool CpuDevice::isCompleted(const Fence& fence) const noexcept
+{
+  ZISC_ASSERT(fence.device() == this, "The fence isn't of the device.");
+  const auto& queue = getQueue(fence.queueIndex());
+  const bool result = fence.number() <= queue.completedNumber();
+  return result;
+}
+
+/*!
+  \details The kernels of different queues are executed on the same worker
+  threads concurrently
+
   \return No description
   */
 std::size_t CpuDevice::numOfQueues() const noexcept
 {
-  return 1;
+  const std::size_t n = queue_list_ ? queue_list_->size() : 0;
+  return n;
 }
 
 /*!
@@ -110,23 +163,45 @@ std::size_t CpuDevice::peakMemoryUsage(const std::size_t /* number */) const noe
 /*!
   \details No detailed description
 
-  \param [in] work_size No description.
-  \param [in] command No description.
+  \param [in] number No description.
+  \return No description
   */
-void CpuDevice::submit(const std::array<uint32b, 3>& work_size,
-                       const Command& command) noexcept
+std::size_t CpuDevice::totalMemoryUsage(const std::size_t /* number */) const noexcept
 {
+  return heap_usage_.total();
 }
 
 /*!
   \details No detailed description
+  */
+void CpuDevice::waitForCompletion() const noexcept
+{
+  const std::size_t num_of_queues = numOfQueues();
+  for (std::size_t i = 0; i < num_of_queues; ++i)
+    waitForCompletion(zisc::cast<uint32b>(i));
+}
 
-  \param [in] number No description.
-  \return No description
+/*!
+  \details No detailed description
+
+  \param [in] queue_index No description.
   */
-std::size_t CpuDevice::totalMemoryUsage(const std::size_t /* number */) const noexcept
+void CpuDevice::waitForCompletion(const uint32b queue_index) const noexcept
 {
-  return heap_usage_.total();
+  const auto& queue = getQueue(queue_index);
+  queue.waitForCompletion();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] fence No description.
+  */
+void CpuDevice::waitForCompletion(const Fence& fence) const noexcept
+{
+  ZISC_ASSERT(fence.device() == this, "The fence isn't of the device.");
+  const auto& queue = getQueue(fence.queueIndex());
+  queue.wait(fence.number());
 }
 
 /*!
@@ -134,7 +209,15 @@ std::size_t CpuDevice::totalMemoryUsage(const std::size_t /* number */) const no
   */
 void CpuDevice::destroyData() noexcept
 {
+  // The queues complete the remaining commands before the threads are destroyed
+  queue_list_.reset();
+  scheduler_list_.reset();
   thread_manager_.reset();
+  pinned_thread_list_.reset();
+  worker_capacity_list_.reset();
+  batch_tuner_.reset();
+  buffer_mem_resource_.reset();
+  huge_page_mem_resource_.reset();
 }
 
 /*!
@@ -151,6 +234,616 @@ void CpuDevice::initData()
   thread_manager_ = zisc::pmr::allocateUnique(alloc,
                                               device.numOfThreads(),
                                               mem_resource);
+  initBufferMemoryResource();
+  initWorkerPlacement();
+  initTaskBatchTuner();
+  initLocalWorkGroupSize();
+  initWorkGroupSchedulers();
+  initCommandQueues();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] work_size No description.
+  \param [in] local_work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] lane_size No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  */
+void CpuDevice::execute(const std::array<uint32b, 3>& work_size,
+                        const std::array<uint32b, 3>& local_work_size,
+                        const std::size_t local_memory_size,
+                        const uint32b lane_size,
+                        const void* kernel_id,
+                        const WorkLayout& work_layout,
+                        const Command& command) noexcept
+{
+  executeImpl(work_size, local_work_size, local_memory_size, lane_size,
+              kernel_id, work_layout, std::addressof(command), nullptr);
+}
+
+/*!
+  \details A work-group consists of the lanes of one invocation
+
+  \param [in] work_size No description.
+  \param [in] lane_size No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  */
+void CpuDevice::execute(const std::array<uint32b, 3>& work_size,
+                        const uint32b lane_size,
+                        const void* kernel_id,
+                        const WorkLayout& work_layout,
+                        const BatchCommand& command) noexcept
+{
+  const std::array<uint32b, 3> local_work_size{{lane_size, 1, 1}};
+  executeImpl(work_size, local_work_size, 0, lane_size,
+              kernel_id, work_layout, nullptr, std::addressof(command));
+}
+
+/*!
+  \details The work-groups are processed by the command for each work-item,
+  or by the batch command for each range of work-groups. Unless the order is
+  row-major, a task batch consists of the runs of the traversal instead of
+  the work-groups
+
+  \param [in] work_size No description.
+  \param [in] local_work_size No description.
+  \param [in] local_memory_size No description.
+  \param [in] lane_size No description.
+  \param [in] kernel_id No description.
+  \param [in] work_layout No description.
+  \param [in] command No description.
+  \param [in] batch_command No description.
+  */
+void CpuDevice::executeImpl(const std::array<uint32b, 3>& work_size,
+                            const std::array<uint32b, 3>& local_work_size,
+                            const std::size_t local_memory_size,
+                            const uint32b lane_size,
+                            const void* kernel_id,
+                            const WorkLayout& work_layout,
+                            const Command* command,
+                            const BatchCommand* batch_command) noexcept
+{
+  ZISC_ASSERT((local_work_size[0] % lane_size) == 0,
+              "The local work size isn't a multiple of the lane size.");
+  // The work-groups which cover the work size are dispatched as vulkan does
+  const std::array<uint32b, 3> num_of_groups{{
+      (work_size[0] + local_work_size[0] - 1) / local_work_size[0],
+      (work_size[1] + local_work_size[1] - 1) / local_work_size[1],
+      (work_size[2] + local_work_size[2] - 1) / local_work_size[2]}};
+  const uint64b total_groups = zisc::cast<uint64b>(num_of_groups[0]) *
+                               zisc::cast<uint64b>(num_of_groups[1]) *
+                               zisc::cast<uint64b>(num_of_groups[2]);
+  if (total_groups == 0)
+    return;
+  // An invocation of the command processes the lanes of work-items
+  const uint32b group_size = (local_work_size[0] / lane_size) *
+                             local_work_size[1] *
+                             local_work_size[2];
+
+  auto& thread_manager = threadManager();
+  const uint32b num_of_workers = zisc::cast<uint32b>(thread_manager.numOfThreads());
+  const bool is_tuned = batch_tuner_ && (kernel_id != nullptr);
+  uint64b batch_size = zisc::cast<uint64b>(taskBatchSize(kernel_id));
+  if (is_tuned) {
+    // A learned batch doesn't exceed the share of a worker of this launch
+    const uint64b share = (total_groups + num_of_workers - 1) / num_of_workers;
+    batch_size = std::min(batch_size, share);
+  }
+
+  // A batch of a tiled traversal consists of the runs of work-groups
+  auto mem_resource = memoryResource();
+  zisc::pmr::unique_ptr<WorkTraversal> traversal;
+  uint64b num_of_units = total_groups;
+  if (!work_layout.isRowMajor()) {
+    zisc::pmr::polymorphic_allocator<WorkTraversal> alloc{mem_resource};
+    traversal = zisc::pmr::allocateUnique(alloc,
+                                          work_layout,
+                                          num_of_groups,
+                                          local_work_size,
+                                          mem_resource);
+    num_of_units = traversal->numOfRuns();
+    batch_size = std::max(batch_size / traversal->runLength(), uint64b{1});
+  }
+  const uint64b num_of_batches = (num_of_units + batch_size - 1) / batch_size;
+  ZISC_ASSERT(num_of_batches <= std::numeric_limits<uint32b>::max(),
+              "The number of task batches exceeds the limit: ", num_of_batches);
+
+  // Distribute the batches to the worker queues in proportion to the
+  // capacity of the cores, so that fast cores start with more batches
+  zisc::pmr::vector<BatchQueue> queue_list{num_of_workers, mem_resource};
+  const uint64b total_capacity = getWorkerCapacity(num_of_workers);
+  for (uint32b i = 0; i < num_of_workers; ++i) {
+    const uint32b begin = zisc::cast<uint32b>(
+        (num_of_batches * getWorkerCapacity(i)) / total_capacity);
+    const uint32b end = zisc::cast<uint32b>(
+        (num_of_batches * getWorkerCapacity(i + 1)) / total_capacity);
+    queue_list[i].set(begin, end);
+  }
+
+  // The execution time of the batches is measured for the batch tuner
+  using Clock = std::chrono::steady_clock;
+  std::atomic<uint64b> measured_time{0};
+  std::atomic<uint64b> measured_groups{0};
+
+  auto task = [this, command, batch_command, &num_of_groups, &local_work_size,
+               &work_layout,
+               &queue_list, &measured_time, &measured_groups, &traversal,
+               num_of_units, group_size, batch_size, local_memory_size,
+               lane_size, is_tuned]
+  (const uint thread_id, const uint /* worker_index */)
+  {
+    using cl::inner::WorkGroup;
+    pinThread(zisc::cast<uint32b>(thread_id));
+    auto& scheduler = *(*scheduler_list_)[thread_id];
+    uint64b elapsed_time = 0;
+    uint64b num_of_processed = 0;
+    auto process_groups = [command, batch_command, &scheduler, group_size]
+    (const uint32b begin, const uint32b end)
+    {
+      if (batch_command != nullptr) {
+        (*batch_command)(begin, end);
+      }
+      else {
+        // The ids of the following work-groups are advanced incrementally
+        for (uint32b id = begin; id < end; ++id) {
+          if (id == begin)
+            WorkGroup::setWorkGroupId(id);
+          else
+            WorkGroup::nextWorkGroupId();
+          if (group_size == 1)
+            (*command)();
+          else
+            scheduler.run(*command, group_size);
+        }
+      }
+    };
+    auto process_batch = [&process_groups, &traversal, &elapsed_time,
+                          &num_of_processed, num_of_units, batch_size, is_tuned]
+    (const uint32b batch)
+    {
+      const auto start_time = is_tuned ? Clock::now() : Clock::time_point{};
+      const uint64b begin = batch * batch_size;
+      const uint64b end = std::min(begin + batch_size, num_of_units);
+      uint64b n = 0;
+      if (!traversal) {
+        process_groups(zisc::cast<uint32b>(begin), zisc::cast<uint32b>(end));
+        n = end - begin;
+      }
+      else {
+        for (uint64b run = begin; run < end; ++run) {
+          uint32b group_begin = 0,
+                  group_end = 0;
+          traversal->getRun(run, &group_begin, &group_end);
+          process_groups(group_begin, group_end);
+          n += group_end - group_begin;
+        }
+      }
+      if (is_tuned) {
+        const auto t = Clock::now() - start_time;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t);
+        elapsed_time += zisc::cast<uint64b>(ns.count());
+        num_of_processed += n;
+      }
+    };
+
+    WorkGroup::setGlobalOffset(work_layout.globalOffset());
+    WorkGroup::setWorkGroupSize(num_of_groups);
+    WorkGroup::setLocalWorkSize(local_work_size);
+    WorkGroup::setLaneSize(lane_size);
+    WorkGroup::setLocalWorkId(0);
+    WorkGroup::setLocalMemory(scheduler.prepareLocalMemory(local_memory_size));
+    // Take the queue of the same index as the thread, so that the thread
+    // processes the range of batches which is close to its NUMA node
+    const uint32b num_of_queues = zisc::cast<uint32b>(queue_list.size());
+    uint32b queue_index = zisc::cast<uint32b>(thread_id) % num_of_queues;
+    while (!queue_list[queue_index].claim())
+      queue_index = (queue_index + 1) % num_of_queues;
+    auto& queue = queue_list[queue_index];
+    while (true) {
+      // Process own batches first
+      for (uint32b batch = 0; queue.pop(&batch);)
+        process_batch(batch);
+      // Steal batches from the most loaded worker
+      BatchQueue* victim = nullptr;
+      uint32b victim_size = 0;
+      for (uint32b i = 1; i < num_of_queues; ++i) {
+        auto& q = queue_list[(queue_index + i) % num_of_queues];
+        const uint32b s = q.size();
+        if (victim_size < s) {
+          victim = &q;
+          victim_size = s;
+        }
+      }
+      if (victim == nullptr)
+        break;
+      uint32b begin = 0,
+              end = 0;
+      if (victim->steal(&begin, &end)) {
+        // The own queue is empty here, so no other worker touches it
+        queue.set(begin + 1, end);
+        process_batch(begin);
+      }
+    }
+    if (is_tuned) {
+      measured_time.fetch_add(elapsed_time, std::memory_order_relaxed);
+      measured_groups.fetch_add(num_of_processed, std::memory_order_relaxed);
+    }
+  };
+
+  constexpr uint start = 0;
+  const uint end = num_of_workers;
+  auto result = thread_manager.enqueueLoop(task, start, end, mem_resource);
+  result->wait();
+
+  if (is_tuned)
+    batch_tuner_->update(kernel_id, measured_groups.load(), measured_time.load());
+}
+
+/*!
+  \details Each worker has the same capacity unless the workers are placed
+  on the cores of a hybrid host
+
+  \param [in] num_of_workers No description.
+  \return No description
+  */
+uint64b CpuDevice::getWorkerCapacity(const uint32b num_of_workers) const noexcept
+{
+  const uint64b capacity = worker_capacity_list_
+      ? (*worker_capacity_list_)[num_of_workers]
+      : zisc::cast<uint64b>(num_of_workers);
+  return capacity;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+CommandQueue& CpuDevice::getQueue(const uint32b queue_index) const noexcept
+{
+  ZISC_ASSERT(queue_index < queue_list_->size(),
+              "The queue index is out of range: ", queue_index);
+  return *(*queue_list_)[queue_index];
+}
+
+/*!
+  \details The huge page resource is placed under the NUMA resource, so the
+  memory policy is applied to the mapped pages before they are touched
+  */
+void CpuDevice::initBufferMemoryResource() noexcept
+{
+  auto& sub_platform = parentImpl();
+  const auto& topology = sub_platform.numaTopology();
+  auto mem_resource = memoryResource();
+  zisc::pmr::memory_resource* upstream = mem_resource;
+  if (sub_platform.hugePagePolicy() != CpuHugePagePolicy::kNone) {
+    zisc::pmr::polymorphic_allocator<HugePageMemoryResource> alloc{mem_resource};
+    huge_page_mem_resource_ = zisc::pmr::allocateUnique<HugePageMemoryResource>(
+        alloc,
+        sub_platform.hugePagePolicy(),
+        sub_platform.hugePageThreshold(),
+        mem_resource);
+    upstream = huge_page_mem_resource_.get();
+  }
+  const std::size_t num_of_workers = threadManager().numOfThreads();
+  if (topology.isNuma() &&
+      (sub_platform.memoryPolicy() != CpuMemoryPolicy::kFirstTouch)) {
+    zisc::pmr::polymorphic_allocator<NumaMemoryResource> alloc{mem_resource};
+    buffer_mem_resource_ = zisc::pmr::allocateUnique<NumaMemoryResource>(
+        alloc,
+        std::addressof(topology),
+        sub_platform.memoryPolicy(),
+        num_of_workers,
+        upstream);
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuDevice::initCommandQueues() noexcept
+{
+  auto mem_resource = memoryResource();
+  using QueueList = decltype(queue_list_)::element_type;
+  {
+    QueueList queue_list{QueueList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<QueueList> alloc{mem_resource};
+    queue_list_ = zisc::pmr::allocateUnique(alloc, std::move(queue_list));
+  }
+
+  const auto& sub_platform = parentImpl();
+  const std::size_t num_of_queues = sub_platform.numOfQueues();
+  queue_list_->reserve(num_of_queues);
+  for (std::size_t i = 0; i < num_of_queues; ++i) {
+    zisc::pmr::polymorphic_allocator<CommandQueue> alloc{mem_resource};
+    auto queue = zisc::pmr::allocateUnique(alloc, mem_resource);
+    queue_list_->emplace_back(std::move(queue));
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuDevice::initLocalWorkGroupSize() noexcept
+{
+  const auto& info = deviceInfoData();
+  const uint32b group_size = info.workGroupSize();
+
+  for (uint32b dim = 1; dim <= work_group_size_list_.size(); ++dim) {
+    std::array<uint32b, 3> work_group_size{{1, 1, 1}};
+    const auto product = [](const std::array<uint32b, 3>& s) noexcept
+    {
+      return std::accumulate(s.begin(), s.end(), 1u, std::multiplies<uint32b>());
+    };
+    for (uint32b i = 0; product(work_group_size) < group_size; i = (i + 1) % dim)
+      work_group_size[i] *= 2;
+    ZISC_ASSERT(product(work_group_size) == group_size,
+                "The work-group size should be power of 2: group size = ",
+                product(work_group_size));
+    work_group_size_list_[dim - 1] = work_group_size;
+    // Lock-step execution requires the lanes in x dimension
+    constexpr uint32b lane_size = cl::inner::WorkGroup::lockStepLaneSize();
+    for (uint32b i = 1; (work_group_size[0] < lane_size) && (i < dim);) {
+      if (1 < work_group_size[i]) {
+        work_group_size[i] /= 2;
+        work_group_size[0] *= 2;
+      }
+      else {
+        ++i;
+      }
+    }
+    work_group_size[0] = std::max(work_group_size[0], lane_size);
+    lock_step_group_size_list_[dim - 1] = work_group_size;
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuDevice::initTaskBatchTuner() noexcept
+{
+  const auto& sub_platform = parentImpl();
+  if (sub_platform.adaptiveTaskBatchEnabled()) {
+    auto mem_resource = memoryResource();
+    const uint32b initial_size = zisc::cast<uint32b>(taskBatchSize());
+    constexpr uint32b max_size = CpuSubPlatform::maxTaskBatchSize();
+    // The batch time is in microseconds
+    const uint64b target_time = 1000 * zisc::cast<uint64b>(sub_platform.taskBatchTime());
+    zisc::pmr::polymorphic_allocator<TaskBatchTuner> alloc{mem_resource};
+    batch_tuner_ = zisc::pmr::allocateUnique<TaskBatchTuner>(alloc,
+                                                             initial_size,
+                                                             max_size,
+                                                             target_time,
+                                                             mem_resource);
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CpuDevice::initWorkGroupSchedulers() noexcept
+{
+  auto mem_resource = memoryResource();
+  using SchedulerList = decltype(scheduler_list_)::element_type;
+  {
+    SchedulerList scheduler_list{SchedulerList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<SchedulerList> alloc{mem_resource};
+    scheduler_list_ = zisc::pmr::allocateUnique(alloc, std::move(scheduler_list));
+  }
+
+  const std::size_t num_of_threads = numOfThreads();
+  scheduler_list_->reserve(num_of_threads);
+  for (std::size_t i = 0; i < num_of_threads; ++i) {
+    zisc::pmr::polymorphic_allocator<WorkGroupScheduler> alloc{mem_resource};
+    auto scheduler = zisc::pmr::allocateUnique(alloc, mem_resource);
+    scheduler_list_->emplace_back(std::move(scheduler));
+  }
+}
+
+/*!
+  \details The workers are pinned to NUMA nodes on a NUMA host if the NUMA
+  pinning is enabled. Otherwise they are pinned to the cores by the core
+  policy, and the first workers are placed on the fastest physical cores
+  */
+void CpuDevice::initWorkerPlacement() noexcept
+{
+  auto& sub_platform = parentImpl();
+  const auto& topology = sub_platform.numaTopology();
+  auto mem_resource = memoryResource();
+  const std::size_t num_of_workers = threadManager().numOfThreads();
+  const bool numa_pinning = topology.isNuma() && sub_platform.numaPinningEnabled();
+  const bool core_pinning = !numa_pinning &&
+                            (sub_platform.corePolicy() != CpuCorePolicy::kAny);
+  if (numa_pinning || core_pinning) {
+    using PinnedList = decltype(pinned_thread_list_)::element_type;
+    PinnedList pinned_list{num_of_workers, 0, PinnedList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<PinnedList> alloc{mem_resource};
+    pinned_thread_list_ = zisc::pmr::allocateUnique(alloc, std::move(pinned_list));
+  }
+  if (core_pinning && topology.isHybrid()) {
+    using CapacityList = decltype(worker_capacity_list_)::element_type;
+    CapacityList capacity_list{num_of_workers + 1, 0, CapacityList::allocator_type{mem_resource}};
+    for (std::size_t i = 0; i < num_of_workers; ++i) {
+      const std::size_t core_index = topology.getWorkerCore(i);
+      capacity_list[i + 1] = capacity_list[i] + topology.coreCapacity(core_index);
+    }
+    zisc::pmr::polymorphic_allocator<CapacityList> alloc{mem_resource};
+    worker_capacity_list_ = zisc::pmr::allocateUnique(alloc, std::move(capacity_list));
+  }
+}
+
+/*!
+  \details The thread which has the n-th thread id processes the n-th range
+  of task batches at first, so the thread is bound to the node where the
+  worker-local memory policy places the n-th range of buffers. Without the
+  NUMA pinning, the thread is bound to the core of the core policy
+
+  \param [in] thread_id No description.
+  */
+void CpuDevice::pinThread(const uint32b thread_id) noexcept
+{
+  if (!pinned_thread_list_)
+    return;
+  // Each element is only touched by the thread of the id
+  auto& is_pinned = (*pinned_thread_list_)[thread_id];
+  if (is_pinned == 0) {
+    const auto& sub_platform = parentImpl();
+    const auto& topology = sub_platform.numaTopology();
+    if (topology.isNuma() && sub_platform.numaPinningEnabled()) {
+      const std::size_t num_of_workers = pinned_thread_list_->size();
+      const std::size_t node_index = topology.getWorkerNode(thread_id,
+                                                            num_of_workers);
+      topology.bindThread(node_index);
+    }
+    else {
+      topology.bindThreadToCore(topology.getWorkerCore(thread_id));
+    }
+    is_pinned = 1;
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+CpuDevice::BatchQueue::BatchQueue() noexcept :
+    range_{pack(0, 0)},
+    is_claimed_{0}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool CpuDevice::BatchQueue::claim() noexcept
+{
+  const bool result = is_claimed_.exchange(1, std::memory_order_acq_rel) == 0;
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [out] batch_index No description.
+  \return No description
+  */
+bool CpuDevice::BatchQueue::pop(uint32b* batch_index) noexcept
+{
+  uint64b range = range_.load(std::memory_order_acquire);
+  bool result = false;
+  while (!result) {
+    const uint32b begin = unpackBegin(range);
+    const uint32b end = unpackEnd(range);
+    if (end <= begin)
+      break;
+    result = range_.compare_exchange_weak(range,
+                                          pack(begin + 1, end),
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire);
+    if (result)
+      *batch_index = begin;
+  }
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] begin No description.
+  \param [in] end No description.
+  */
+void CpuDevice::BatchQueue::set(const uint32b begin, const uint32b end) noexcept
+{
+  range_.store(pack(begin, end), std::memory_order_release);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint32b CpuDevice::BatchQueue::size() const noexcept
+{
+  const uint64b range = range_.load(std::memory_order_relaxed);
+  const uint32b begin = unpackBegin(range);
+  const uint32b end = unpackEnd(range);
+  const uint32b s = (begin < end) ? end - begin : 0;
+  return s;
+}
+
+/*!
+  \details No detailed description
+
+  \param [out] begin No description.
+  \param [out] end No description.
+  \return No description
+  */
+bool CpuDevice::BatchQueue::steal(uint32b* begin, uint32b* end) noexcept
+{
+  uint64b range = range_.load(std::memory_order_acquire);
+  bool result = false;
+  while (!result) {
+    const uint32b b = unpackBegin(range);
+    const uint32b e = unpackEnd(range);
+    if (e <= b)
+      break;
+    const uint32b middle = e - (e - b + 1) / 2;
+    result = range_.compare_exchange_weak(range,
+                                          pack(b, middle),
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire);
+    if (result) {
+      *begin = middle;
+      *end = e;
+    }
+  }
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] begin No description.
+  \param [in] end No description.
+  \return No description
+  */
+uint64b CpuDevice::BatchQueue::pack(const uint32b begin, const uint32b end) noexcept
+{
+  const uint64b range = (zisc::cast<uint64b>(end) << 32) |
+                        zisc::cast<uint64b>(begin);
+  return range;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] range No description.
+  \return No description
+  */
+uint32b CpuDevice::BatchQueue::unpackBegin(const uint64b range) noexcept
+{
+  const uint32b begin = zisc::cast<uint32b>(range & 0xffff'ffffu);
+  return begin;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] range No description.
+  \return No description
+  */
+uint32b CpuDevice::BatchQueue::unpackEnd(const uint64b range) noexcept
+{
+  const uint32b end = zisc::cast<uint32b>(range >> 32);
+  return end;
 }
 
 } // namespace zinvul
@@ -17,6 +17,7 @@
 
 // Standard C++ library
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 // Zisc
@@ -25,8 +26,16 @@
 #include "zisc/std_memory_resource.hpp"
 #include "zisc/thread_manager.hpp"
 // Zinvul
+#include "utility/command_queue.hpp"
+#include "utility/huge_page_memory_resource.hpp"
+#include "utility/numa_memory_resource.hpp"
+#include "utility/task_batch_tuner.hpp"
+#include "utility/work_group_scheduler.hpp"
+#include "utility/work_layout.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/command_list.hpp"
 #include "zinvul/device.hpp"
+#include "zinvul/fence.hpp"
 //#include "zinvul/kernel.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -35,6 +44,7 @@ namespace zinvul {
 
 // Forward declaration
 class DeviceInfo;
+class CpuCommandList;
 class CpuDeviceInfo;
 class CpuSubPlatform;
 
@@ -48,6 +58,7 @@ class CpuDevice : public Device
  public:
   // Type aliases
   using Command = zisc::FunctionReference<void ()>;
+  using BatchCommand = zisc::FunctionReference<void (const uint32b, const uint32b)>;
 
 
   //! Initialize the cpu device
@@ -57,13 +68,33 @@ class CpuDevice : public Device
   ~CpuDevice() noexcept override;
 
 
+  //! Return the alignment of buffer data in bytes
+  std::size_t bufferAlignment() const noexcept;
+
+  //! Return the memory resource which is used for buffer data
+  zisc::pmr::memory_resource* bufferMemoryResource() noexcept;
+
   //! Return the underlying device info
   const CpuDeviceInfo& deviceInfoData() const noexcept;
 
+  //! Make the queue wait for the command of the fence before the next commands
+  void enqueueWait(const uint32b queue_index,
+                   const Fence& fence) noexcept override;
+
+  //! Check if the command of the given fence is completed
+  bool isCompleted(const Fence& fence) const noexcept override;
+
+  //! Return the local work-group size for the dimension
+  template <std::size_t kDimension>
+  const std::array<uint32b, 3>& localWorkSize() const noexcept;
+
   //! Make a buffer
   template <typename Type>
   SharedBuffer<Type> makeBuffer(const BufferUsage flag) noexcept;
 
+  //! Make a command list
+  SharedCommandList makeCommandList() noexcept;
+
 //  //! Make a kernel
 //  template <std::size_t kDimension, typename Function, typename ...BufferArgs>
 //  UniqueKernel<kDimension, BufferArgs...> makeKernel(
@@ -84,13 +115,81 @@ class CpuDevice : public Device
   //! Return the peak memory usage of the heap of the given index
   std::size_t peakMemoryUsage(const std::size_t number) const noexcept override;
 
-  //! Submit a kernel command
-  void submit(const std::array<uint32b, 3>& work_size,
-              const Command& command) noexcept;
+  //! Submit a kernel command to the queue
+  template <std::size_t kDimension, typename Function>
+  Fence submit(const std::array<uint32b, kDimension>& work_size,
+               const std::size_t local_memory_size,
+               const uint32b queue_index,
+               Function&& command) noexcept;
+
+  //! Submit a kernel command whose task batch size is learned by the id
+  template <std::size_t kDimension, typename Function>
+  Fence submit(const std::array<uint32b, kDimension>& work_size,
+               const std::size_t local_memory_size,
+               const uint32b queue_index,
+               const void* kernel_id,
+               Function&& command) noexcept;
+
+  //! Submit a kernel command in the work layout
+  template <std::size_t kDimension, typename Function>
+  Fence submit(const std::array<uint32b, kDimension>& work_size,
+               const std::size_t local_memory_size,
+               const uint32b queue_index,
+               const void* kernel_id,
+               const WorkLayout& work_layout,
+               Function&& command) noexcept;
+
+  //! Submit a host command to the queue
+  template <typename Function>
+  Fence submit(const uint32b queue_index, Function&& command) noexcept;
+
+  //! Submit a kernel command which processes a range of work-groups at once
+  template <std::size_t kDimension, typename Function>
+  Fence submitBatch(const std::array<uint32b, kDimension>& work_size,
+                    const uint32b lane_size,
+                    const uint32b queue_index,
+                    const void* kernel_id,
+                    Function&& command) noexcept;
+
+  //! Submit a batch kernel command in the work layout
+  template <std::size_t kDimension, typename Function>
+  Fence submitBatch(const std::array<uint32b, kDimension>& work_size,
+                    const uint32b lane_size,
+                    const uint32b queue_index,
+                    const void* kernel_id,
+                    const WorkLayout& work_layout,
+                    Function&& command) noexcept;
+
+  //! Submit a kernel command which processes adjacent work-items in lock-step
+  template <std::size_t kDimension, typename Function>
+  Fence submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                       const std::size_t local_memory_size,
+                       const uint32b queue_index,
+                       Function&& command) noexcept;
+
+  //! Submit a lock-step kernel command whose task batch size is learned by the id
+  template <std::size_t kDimension, typename Function>
+  Fence submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                       const std::size_t local_memory_size,
+                       const uint32b queue_index,
+                       const void* kernel_id,
+                       Function&& command) noexcept;
+
+  //! Submit a lock-step kernel command in the work layout
+  template <std::size_t kDimension, typename Function>
+  Fence submitLockStep(const std::array<uint32b, kDimension>& work_size,
+                       const std::size_t local_memory_size,
+                       const uint32b queue_index,
+                       const void* kernel_id,
+                       const WorkLayout& work_layout,
+                       Function&& command) noexcept;
 
   //! Return the task batch size per thread
   std::size_t taskBatchSize() const noexcept;
 
+  //! Return the task batch size of the given kernel
+  std::size_t taskBatchSize(const void* kernel_id) const noexcept;
+
   //! Return the underlying thread manager which is used for kernel exection
   zisc::ThreadManager& threadManager() noexcept;
 
@@ -100,15 +199,14 @@ class CpuDevice : public Device
   //! Return the current memory usage of the heap of the given index
   std::size_t totalMemoryUsage(const std::size_t number) const noexcept override;
 
-//  //! Wait this thread until all commands in the device are completed
-//  void waitForCompletion() const noexcept override;
-//
-//  //! Wait this thread until all commands in the queues are completed
-//  void waitForCompletion(const QueueType queue_type) const noexcept override;
-//
-//  //! Wait this thread until all commands in the queue are completed
-//  void waitForCompletion(const QueueType queue_type,
-//                         const uint32b queue_index) const noexcept override;
+  //! Wait this thread until all commands in the device are completed
+  void waitForCompletion() const noexcept override;
+
+  //! Wait this thread until all commands in the queue are completed
+  void waitForCompletion(const uint32b queue_index) const noexcept override;
+
+  //! Wait this thread until the command of the given fence is completed
+  void waitForCompletion(const Fence& fence) const noexcept override;
 
  protected:
   //! Destroy the device
@@ -118,15 +216,129 @@ class CpuDevice : public Device
   void initData() override;
 
  private:
+  friend CpuCommandList;
+
+
+  /*!
+    \brief A range of task batches which is owned by a worker thread
+
+    The owner takes batches from the front of the range and the other workers
+    steal the back half of the remaining batches. Both ends are packed into
+    a 64bit word so that the range can be updated with one CAS.
+    */
+  class alignas(64) BatchQueue
+  {
+   public:
+    //! Initialize a queue with an empty range
+    BatchQueue() noexcept;
+
+
+    //! Take the ownership of the queue. Return false if it's already owned
+    bool claim() noexcept;
+
+    //! Take a batch from the front of the range
+    bool pop(uint32b* batch_index) noexcept;
+
+    //! Set a range of batches
+    void set(const uint32b begin, const uint32b end) noexcept;
+
+    //! Return the number of batches remaining in the queue
+    uint32b size() const noexcept;
+
+    //! Steal the back half of the remaining batches
+    bool steal(uint32b* begin, uint32b* end) noexcept;
+
+   private:
+    //! Pack a range into a word
+    static uint64b pack(const uint32b begin, const uint32b end) noexcept;
+
+    //! Return the begin of a packed range
+    static uint32b unpackBegin(const uint64b range) noexcept;
+
+    //! Return the end of a packed range
+    static uint32b unpackEnd(const uint64b range) noexcept;
+
+
+    std::atomic<uint64b> range_;
+    std::atomic<uint32b> is_claimed_;
+  };
+
+
+  //! Execute a kernel command with work-groups
+  void execute(const std::array<uint32b, 3>& work_size,
+               const std::array<uint32b, 3>& local_work_size,
+               const std::size_t local_memory_size,
+               const uint32b lane_size,
+               const void* kernel_id,
+               const WorkLayout& work_layout,
+               const Command& command) noexcept;
+
+  //! Execute a kernel command with ranges of work-groups
+  void execute(const std::array<uint32b, 3>& work_size,
+               const uint32b lane_size,
+               const void* kernel_id,
+               const WorkLayout& work_layout,
+               const BatchCommand& command) noexcept;
+
+  //! Execute a kernel command of either form
+  void executeImpl(const std::array<uint32b, 3>& work_size,
+                   const std::array<uint32b, 3>& local_work_size,
+                   const std::size_t local_memory_size,
+                   const uint32b lane_size,
+                   const void* kernel_id,
+                   const WorkLayout& work_layout,
+                   const Command* command,
+                   const BatchCommand* batch_command) noexcept;
+
+  //! Return the total capacity of the cores of the first workers
+  uint64b getWorkerCapacity(const uint32b num_of_workers) const noexcept;
+
+  //! Return the command queue of the given index
+  CommandQueue& getQueue(const uint32b queue_index) const noexcept;
+
+  //! Initialize the memory resource of buffers
+  void initBufferMemoryResource() noexcept;
+
+  //! Initialize the command queues
+  void initCommandQueues() noexcept;
+
+  //! Initialize the local work-group size
+  void initLocalWorkGroupSize() noexcept;
+
+  //! Initialize the task batch tuner
+  void initTaskBatchTuner() noexcept;
+
+  //! Initialize the work-group schedulers
+  void initWorkGroupSchedulers() noexcept;
+
+  //! Initialize the placement of the worker threads on the cores
+  void initWorkerPlacement() noexcept;
+
+  //! Return the local work-group size of lock-step execution for the dimension
+  template <std::size_t kDimension>
+  const std::array<uint32b, 3>& lockStepLocalWorkSize() const noexcept;
+
   //! Return the sub-platform
   CpuSubPlatform& parentImpl() noexcept;
 
   //! Return the sub-platform
   const CpuSubPlatform& parentImpl() const noexcept;
 
+  //! Pin the current worker thread to its NUMA node or core if not pinned yet
+  void pinThread(const uint32b thread_id) noexcept;
+
 
   zisc::Memory::Usage heap_usage_;
   zisc::pmr::unique_ptr<zisc::ThreadManager> thread_manager_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<zisc::pmr::unique_ptr<WorkGroupScheduler>>> scheduler_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<zisc::pmr::unique_ptr<CommandQueue>>> queue_list_;
+  zisc::pmr::unique_ptr<HugePageMemoryResource> huge_page_mem_resource_;
+  zisc::pmr::unique_ptr<NumaMemoryResource> buffer_mem_resource_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<uint8b>> pinned_thread_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<uint64b>> worker_capacity_list_; //!< Prefix sums
+  zisc::pmr::unique_ptr<TaskBatchTuner> batch_tuner_;
+  std::array<std::array<uint32b, 3>, 3> work_group_size_list_;
+  std::array<std::array<uint32b, 3>, 3> lock_step_group_size_list_;
 };
 
 } // namespace zinvul
@@ -37,7 +37,9 @@
 // Zisc
 #include "zisc/memory.hpp"
 #include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
 // Zinvul
+#include "utility/numa_topology.hpp"
 #include "zinvul/device_info.hpp"
 #include "zinvul/zinvul_config.hpp"
 
@@ -62,7 +64,11 @@ CpuDeviceInfo::CpuDeviceInfo(CpuDeviceInfo&& other) noexcept :
     DeviceInfo(std::move(other)),
     name_{std::move(other.name_)},
     vendor_name_{std::move(other.vendor_name_)},
-    memory_stats_{std::move(other.memory_stats_)}
+    memory_stats_{std::move(other.memory_stats_)},
+    work_group_size_{other.work_group_size_},
+    num_of_logical_cores_{other.num_of_logical_cores_},
+    num_of_physical_cores_{other.num_of_physical_cores_},
+    num_of_performance_cores_{other.num_of_performance_cores_}
 {
 }
 
@@ -85,6 +91,10 @@ CpuDeviceInfo& CpuDeviceInfo::operator=(CpuDeviceInfo&& other) noexcept
   name_ = std::move(other.name_);
   vendor_name_ = std::move(other.vendor_name_);
   memory_stats_ = std::move(other.memory_stats_);
+  work_group_size_ = other.work_group_size_;
+  num_of_logical_cores_ = other.num_of_logical_cores_;
+  num_of_physical_cores_ = other.num_of_physical_cores_;
+  num_of_performance_cores_ = other.num_of_performance_cores_;
   return *this;
 }
 
@@ -102,11 +112,38 @@ std::size_t CpuDeviceInfo::availableMemory(const std::size_t /* heap_index */) c
 
 /*!
   \details No detailed description
+
+  \param [in] topology No description.
   */
-void CpuDeviceInfo::fetch() noexcept
+void CpuDeviceInfo::fetch(const NumaTopology& topology) noexcept
 {
   initCpuInfo();
   memory_stats_ = zisc::Memory::retrieveSystemStats();
+  num_of_logical_cores_ = zisc::cast<uint32b>(topology.numOfLogicalCores());
+  num_of_physical_cores_ = zisc::cast<uint32b>(topology.numOfPhysicalCores());
+  num_of_performance_cores_ = zisc::cast<uint32b>(topology.numOfPerformanceCores());
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool CpuDeviceInfo::isHybrid() const noexcept
+{
+  const bool result = num_of_performance_cores_ < num_of_physical_cores_;
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool CpuDeviceInfo::isSmt() const noexcept
+{
+  const bool result = num_of_physical_cores_ < num_of_logical_cores_;
+  return result;
 }
 
 /*!
@@ -162,6 +199,36 @@ std::size_t CpuDeviceInfo::numOfHeaps() const noexcept
   return 1;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t CpuDeviceInfo::numOfLogicalCores() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_logical_cores_);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t CpuDeviceInfo::numOfPerformanceCores() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_performance_cores_);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t CpuDeviceInfo::numOfPhysicalCores() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_physical_cores_);
+}
+
 /*!
   \details No detailed description
 
@@ -184,6 +251,16 @@ SubPlatformType CpuDeviceInfo::type() const noexcept
   return SubPlatformType::kCpu;
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] group_size No description.
+  */
+void CpuDeviceInfo::setWorkGroupSize(const uint32b group_size) noexcept
+{
+  work_group_size_ = group_size;
+}
+
 /*!
   \details No detailed description
 
@@ -201,7 +278,7 @@ std::string_view CpuDeviceInfo::vendorName() const noexcept
   */
 uint32b CpuDeviceInfo::workGroupSize() const noexcept
 {
-  return 1;
+  return work_group_size_;
 }
 
 /*!
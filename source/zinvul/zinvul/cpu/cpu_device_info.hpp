@@ -30,6 +30,9 @@
 
 namespace zinvul {
 
+// Forward declaration
+class NumaTopology;
+
 /*!
   \brief No brief description
 
@@ -60,7 +63,13 @@ class CpuDeviceInfo : public DeviceInfo
   std::size_t availableMemory(const std::size_t heap_index) const noexcept override;
 
   //! Fetch device info from the host
-  void fetch() noexcept;
+  void fetch(const NumaTopology& topology) noexcept;
+
+  //! Check if the host has cores of different performance
+  bool isHybrid() const noexcept;
+
+  //! Check if the physical cores run multiple logical cores
+  bool isSmt() const noexcept;
 
   //! Return the maximum size of an allocation in bytes
   std::size_t maxAllocationSize() const noexcept override;
@@ -77,12 +86,24 @@ class CpuDeviceInfo : public DeviceInfo
   //! Return the number of heaps of the device local
   std::size_t numOfHeaps() const noexcept override;
 
+  //! Return the number of logical cores of the host
+  std::size_t numOfLogicalCores() const noexcept;
+
+  //! Return the number of the fastest physical cores of the host
+  std::size_t numOfPerformanceCores() const noexcept;
+
+  //! Return the number of physical cores of the host
+  std::size_t numOfPhysicalCores() const noexcept;
+
   //! Return the amount of actual device memory in bytes
   std::size_t totalMemory(const std::size_t heap_index) const noexcept override;
 
   //! Return the sub-platform type
   SubPlatformType type() const noexcept override;
 
+  //! Set the local work group size of the device
+  void setWorkGroupSize(const uint32b group_size) noexcept;
+
   //! Return the vendor name
   std::string_view vendorName() const noexcept override;
 
@@ -97,6 +118,10 @@ class CpuDeviceInfo : public DeviceInfo
   zisc::pmr::string name_;
   zisc::pmr::string vendor_name_;
   MemoryStats memory_stats_;
+  uint32b work_group_size_ = 1;
+  uint32b num_of_logical_cores_ = 1;
+  uint32b num_of_physical_cores_ = 1;
+  uint32b num_of_performance_cores_ = 1;
 };
 
 } // namespace zinvul
@@ -21,15 +21,21 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 // Zisc
 #include "zisc/error.hpp"
 #include "zisc/utility.hpp"
 // Zinvul
 #include "cpu_buffer.hpp"
+#include "cpu_command_list.hpp"
 #include "cpu_device.hpp"
+#include "utility/work_layout.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/kernel.hpp"
 #include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
 #include "zinvul/utility/id_data.hpp"
 #include "zinvul/utility/kernel_arg_parser.hpp"
 #include "zinvul/utility/kernel_init_parameters.hpp"
@@ -73,8 +79,29 @@ kernel() const noexcept -> Function
 }
 
 /*!
-  \details No detailed description
+  \details The local arguments are placed in the reverse order of the
+  kernel arguments, so that a launcher can compute the offset of its
+  argument from the rest of the arguments
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+constexpr std::size_t
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+localMemorySize() noexcept
+{
+  std::size_t size = 0;
+  if constexpr (0 < sizeof...(FuncArgTypes))
+    size = calcLocalMemorySize<FuncArgTypes...>();
+  return size;
+}
+
+/*!
+  \details The command is built once, and the replays of the command list
+  execute it without rebuilding
 
+  \param [in,out] command_list No description.
   \param [in] args No description.
   \param [in] launch_options No description.
   */
@@ -82,16 +109,54 @@ template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes
 inline
 void
 CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+record(CommandList* command_list,
+       BufferRef<ArgTypes>... args,
+       const LaunchOptions& launch_options)
+{
+  ZISC_ASSERT(command_list->type() == SubPlatformType::kCpu,
+              "The command list isn't a cpu command list.");
+  auto list = zisc::cast<CpuCommandList*>(command_list);
+  const WorkLayout work_layout = makeWorkLayout(launch_options);
+  list->addKernel(launch_options.workSize(),
+                  localMemorySize(),
+                  kernelId(),
+                  lock_step_enabled_,
+                  work_layout,
+                  makeCommand(args..., launch_options));
+}
+
+/*!
+  \details The buffers must be alive until the returned fence is signaled
+
+  \param [in] args No description.
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+Fence
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 run(BufferRef<ArgTypes>... args, const LaunchOptions& launch_options)
 {
   auto& device = parentImpl();
-  const auto work_size = expandTo3d(launch_options.workSize());
-  using LauncherType = Launcher<FuncArgTypes...>;
-  auto command = [func = kernel(), &args..., &launch_options]() noexcept
-  {
-    LauncherType::exec(func, launch_options, args...);
-  };
-  device.submit(work_size, command);
+  // The command is executed after this function returns
+  auto command = makeCommand(args..., launch_options);
+  const void* kernel_id = kernelId();
+  const WorkLayout work_layout = makeWorkLayout(launch_options);
+  const auto fence = lock_step_enabled_
+      ? device.submitLockStep(launch_options.workSize(),
+                              localMemorySize(),
+                              launch_options.queueIndex(),
+                              kernel_id,
+                              work_layout,
+                              std::move(command))
+      : device.submit(launch_options.workSize(),
+                      localMemorySize(),
+                      launch_options.queueIndex(),
+                      kernel_id,
+                      work_layout,
+                      std::move(command));
+  return fence;
 }
 
 /*!
@@ -104,6 +169,7 @@ CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 destroyData() noexcept
 {
   kernel_ = nullptr;
+  lock_step_enabled_ = false;
 }
 
 /*!
@@ -118,6 +184,7 @@ CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 initData(const InitParameters& params)
 {
   kernel_ = params.func();
+  lock_step_enabled_ = params.lockStepEnabled();
 }
 
 /*!
@@ -144,8 +211,14 @@ Launcher<ArgType, RestTypes...>::exec(Function func,
   using ArgInfo = KernelArgInfo<ArgType>;
   using ArgT = std::remove_volatile_t<ArgType>;
   if constexpr (ArgInfo::kIsLocal) { // Process a local argument
-    typename ArgInfo::ElementType storage{};
-    ArgT cl_arg{std::addressof(storage)};
+    // The local memory is shared by all work-items in the work-group
+    using ElementT = typename ArgInfo::ElementType;
+    static_assert(std::is_trivially_destructible_v<ElementT>,
+                  "The local element type isn't trivially destructible.");
+    constexpr std::size_t offset =
+        calcLocalMemorySize<ArgType, RestTypes...>() - sizeof(ElementT);
+    auto memory = zisc::cast<uint8b*>(cl::inner::WorkGroup::getLocalMemory());
+    ArgT cl_arg{zisc::treatAs<ElementT*>(memory + offset)};
     invoke(func,
            launch_options,
            std::forward<Type>(value),
@@ -193,7 +266,7 @@ Launcher<ArgType, RestTypes...>::invoke(Function func,
                                         Types&&... args) noexcept
 {
   constexpr std::size_t rest_size = sizeof...(RestTypes);
-  if (0 < rest_size) {
+  if constexpr (0 < rest_size) {
     using LauncherType = Launcher<RestTypes...>;
     LauncherType::exec(func, launch_options, std::forward<Types>(args)...);
   }
@@ -205,19 +278,100 @@ Launcher<ArgType, RestTypes...>::invoke(Function func,
 /*!
   \details No detailed description
 
-  \param [in] work_size No description.
+  \tparam Type No description.
+  \tparam Types No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+template <typename Type, typename ...Types>
+inline
+constexpr std::size_t
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+calcLocalMemorySize() noexcept
+{
+  std::size_t size = 0;
+  if constexpr (0 < sizeof...(Types))
+    size = calcLocalMemorySize<Types...>();
+  using ArgInfo = KernelArgInfo<Type>;
+  if constexpr (ArgInfo::kIsLocal) {
+    using ElementT = typename ArgInfo::ElementType;
+    constexpr std::size_t alignment = alignof(ElementT);
+    size = ((size + alignment - 1) / alignment) * alignment + sizeof(ElementT);
+  }
+  return size;
+}
+
+/*!
+  \details The task batch size is learned for each kernel function
+
   \return No description
   */
 template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
 inline
-std::array<uint32b, 3>
+const void*
 CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
-expandTo3d(const std::array<uint32b, kDimension>& work_size) noexcept
+kernelId() const noexcept
 {
-  std::array<uint32b, 3> work_size_3d{{1, 1, 1}};
-  for (std::size_t i = 0; i < kDimension; ++i)
-    work_size_3d[i] = work_size[i];
-  return work_size_3d;
+  return reinterpret_cast<const void*>(kernel());
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+bool
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+lockStepEnabled() const noexcept
+{
+  return lock_step_enabled_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+WorkLayout
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+makeWorkLayout(const LaunchOptions& launch_options) noexcept
+{
+  WorkLayout work_layout{launch_options.traversalOrder(),
+                         launch_options.tileSize()};
+  work_layout.setGlobalOffset(launch_options.globalOffset());
+  return work_layout;
+}
+
+/*!
+  \details The addresses of the buffers are captured
+
+  \param [in] args No description.
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+auto
+CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+makeCommand(BufferRef<ArgTypes>... args,
+            const LaunchOptions& launch_options) const noexcept
+{
+  using LauncherType = Launcher<FuncArgTypes...>;
+  auto command = [func = kernel(),
+                  arg_list = std::make_tuple(std::addressof(args)...),
+                  launch_options]() noexcept
+  {
+    std::apply([func, &launch_options](auto*... arg_ptrs) noexcept
+    {
+      LauncherType::exec(func, launch_options, *arg_ptrs...);
+    }, arg_list);
+  };
+  return command;
 }
 
 /*!
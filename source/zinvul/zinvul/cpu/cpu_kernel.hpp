@@ -21,6 +21,8 @@
 #include <memory>
 #include <type_traits>
 // Zinvul
+#include "utility/work_layout.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/kernel.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -30,6 +32,7 @@ namespace zinvul {
 
 // Forward declaration
 template <typename Type> class Buffer;
+class CommandList;
 class CpuDevice;
 template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
 class CpuKernel;
@@ -68,9 +71,17 @@ class CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>
   //! Return the underlying kernel function
   Function kernel() const noexcept;
 
-  //! Execute a kernel
-  void run(BufferRef<ArgTypes>... args,
-           const LaunchOptions& launch_options) override;
+  //! Return the size of the local memory which is shared in a work-group
+  static constexpr std::size_t localMemorySize() noexcept;
+
+  //! Record a launch of the kernel in the command list
+  void record(CommandList* command_list,
+              BufferRef<ArgTypes>... args,
+              const LaunchOptions& launch_options) override;
+
+  //! Execute a kernel asynchronously
+  Fence run(BufferRef<ArgTypes>... args,
+            const LaunchOptions& launch_options) override;
 
  protected:
   //! Clear the contents of the kernel
@@ -79,6 +90,21 @@ class CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>
   //! Initialize the kernel
   void initData(const InitParameters& params) override;
 
+  //! Return the id which the task batch size of the kernel is learned by
+  const void* kernelId() const noexcept;
+
+  //! Check if the kernel processes the lanes of work-items in lock-step
+  bool lockStepEnabled() const noexcept;
+
+  //! Make the work layout of a launch
+  static WorkLayout makeWorkLayout(const LaunchOptions& launch_options) noexcept;
+
+  //! Return the device
+  CpuDevice& parentImpl() noexcept;
+
+  //! Return the device
+  const CpuDevice& parentImpl() const noexcept;
+
  private:
   /*!
     \brief No brief description
@@ -107,18 +133,17 @@ class CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>
                        Types&&... args) noexcept;
   };
 
-  //! Expand the given work size to 3d work size array
-  static std::array<uint32b, 3> expandTo3d(
-    const std::array<uint32b, kDimension>& work_size) noexcept;
-
-  //! Return the device
-  CpuDevice& parentImpl() noexcept;
+  //! Return the size of the local memory which is required by the given args
+  template <typename Type, typename ...Types>
+  static constexpr std::size_t calcLocalMemorySize() noexcept;
 
-  //! Return the device
-  const CpuDevice& parentImpl() const noexcept;
+  //! Make a command which invokes the kernel with the arguments
+  auto makeCommand(BufferRef<ArgTypes>... args,
+                   const LaunchOptions& launch_options) const noexcept;
 
 
   Function kernel_ = nullptr;
+  bool lock_step_enabled_ = false;
 };
 
 } // namespace zinvul
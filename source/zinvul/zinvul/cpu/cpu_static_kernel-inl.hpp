@@ -0,0 +1,279 @@
+/*!
+  \file cpu_static_kernel-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CPU_STATIC_KERNEL_INL_HPP
+#define ZINVUL_CPU_STATIC_KERNEL_INL_HPP
+
+#include "cpu_static_kernel.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "cpu_buffer.hpp"
+#include "cpu_command_list.hpp"
+#include "cpu_device.hpp"
+#include "cpu_kernel.hpp"
+#include "utility/work_layout.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
+#include "zinvul/utility/id_data.hpp"
+#include "zinvul/utility/kernel_arg_parser.hpp"
+#include "zinvul/utility/kernel_init_parameters.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] id No description.
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+CpuStaticKernel(IdData&& id) noexcept : BaseKernel(std::move(id))
+{
+}
+
+/*!
+  \details No detailed description
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+~CpuStaticKernel() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in,out] command_list No description.
+  \param [in] args No description.
+  \param [in] launch_options No description.
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+void
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+record(CommandList* command_list,
+       BufferRef<ArgTypes>... args,
+       const LaunchOptions& launch_options)
+{
+  ZISC_ASSERT(command_list->type() == SubPlatformType::kCpu,
+              "The command list isn't a cpu command list.");
+  auto list = zisc::cast<CpuCommandList*>(command_list);
+  const WorkLayout work_layout = BaseKernel::makeWorkLayout(launch_options);
+  list->addBatchKernel(launch_options.workSize(),
+                       laneSize(),
+                       BaseKernel::kernelId(),
+                       work_layout,
+                       makeBatchCommand(args...));
+}
+
+/*!
+  \details The buffers must be alive until the returned fence is signaled
+
+  \param [in] args No description.
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+Fence
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+run(BufferRef<ArgTypes>... args, const LaunchOptions& launch_options)
+{
+  auto& device = BaseKernel::parentImpl();
+  // The command is executed after this function returns
+  auto command = makeBatchCommand(args...);
+  const WorkLayout work_layout = BaseKernel::makeWorkLayout(launch_options);
+  const auto fence = device.submitBatch(launch_options.workSize(),
+                                        laneSize(),
+                                        launch_options.queueIndex(),
+                                        BaseKernel::kernelId(),
+                                        work_layout,
+                                        std::move(command));
+  return fence;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] params No description.
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+void
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+initData(const InitParameters& params)
+{
+  ZISC_ASSERT(params.func() == kFunction,
+              "The kernel function isn't the static kernel function.");
+  BaseKernel::initData(params);
+}
+
+/*!
+  \details The kernel arguments are shared by the work-groups in the range,
+  and the work-group ids are advanced incrementally
+
+  \tparam Types No description.
+  \param [in] begin No description.
+  \param [in] end No description.
+  \param [in] cl_args No description.
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+template <typename ...Types>
+inline
+void
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+invoke(const uint32b begin, const uint32b end, Types&&... cl_args) noexcept
+{
+  using cl::inner::WorkGroup;
+  for (uint32b id = begin; id < end; ++id) {
+    if (id == begin)
+      WorkGroup::setWorkGroupId(id);
+    else
+      WorkGroup::nextWorkGroupId();
+    kFunction(cl_args...);
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+uint32b
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+laneSize() const noexcept
+{
+  const uint32b lane_size = BaseKernel::lockStepEnabled()
+      ? cl::inner::WorkGroup::lockStepLaneSize()
+      : 1;
+  return lane_size;
+}
+
+/*!
+  \details The addresses of the buffers are captured
+
+  \param [in] args No description.
+  \return No description
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+inline
+auto
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+makeBatchCommand(BufferRef<ArgTypes>... args) const noexcept
+{
+  auto command = [arg_list = std::make_tuple(std::addressof(args)...)]
+  (const uint32b begin, const uint32b end) noexcept
+  {
+    std::apply([begin, end](auto*... arg_ptrs) noexcept
+    {
+      invoke(begin, end, toKernelArg<FuncArgTypes>(*arg_ptrs)...);
+    }, arg_list);
+  };
+  return command;
+}
+
+/*!
+  \details A pod argument refers to the element of the buffer
+
+  \tparam FuncArgType No description.
+  \tparam Type No description.
+  \param [in] buffer No description.
+  \return No description
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+template <typename FuncArgType, typename Type>
+inline
+decltype(auto)
+CpuStaticKernel<kFunction,
+                kDimension,
+                KernelInitParameters<FuncArgTypes...>,
+                ArgTypes...>::
+toKernelArg(Buffer<Type>& buffer) noexcept
+{
+  using ArgInfo = KernelArgInfo<FuncArgType>;
+  using ArgT = std::remove_volatile_t<FuncArgType>;
+  auto cpu_buffer = zisc::cast<CpuBuffer<Type>*>(std::addressof(buffer));
+  if constexpr (ArgInfo::kIsPod)
+    return *(cpu_buffer->data());
+  else
+    return ArgT{cpu_buffer->data()};
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_CPU_STATIC_KERNEL_INL_HPP
@@ -0,0 +1,124 @@
+/*!
+  \file cpu_static_kernel.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_CPU_STATIC_KERNEL_HPP
+#define ZINVUL_CPU_STATIC_KERNEL_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <type_traits>
+// Zinvul
+#include "cpu_kernel.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/utility/id_data.hpp"
+#include "zinvul/utility/kernel_init_parameters.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+template <typename Type> class Buffer;
+class CommandList;
+template <auto kFunction,
+          std::size_t kDimension,
+          typename FuncArgTypes,
+          typename ...ArgTypes>
+class CpuStaticKernel;
+
+/*!
+  \brief A cpu kernel which calls the kernel function directly
+
+  The kernel function is a template parameter, so that the call is resolved
+  at compile time and the kernel body can be inlined into the loop over the
+  work-groups of a task batch. The arguments are unpacked once for a batch
+  instead of for each work-item. A work-group consists of the lanes of one
+  invocation, so the kernel must not use barriers and local memory.
+
+  \tparam kFunction The kernel function
+  \tparam kDimension No description.
+  \tparam FuncArgTypes No description.
+  \tparam ArgTypes No description.
+  */
+template <auto kFunction,
+          std::size_t kDimension,
+          typename ...FuncArgTypes,
+          typename ...ArgTypes>
+class CpuStaticKernel<kFunction,
+                      kDimension,
+                      KernelInitParameters<FuncArgTypes...>,
+                      ArgTypes...> :
+    public CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>
+{
+ public:
+  // Type aliases
+  using BaseKernel =
+      CpuKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>;
+  using InitParameters = typename BaseKernel::InitParameters;
+  using Function = typename BaseKernel::Function;
+  template <typename Type>
+  using BufferRef = typename BaseKernel::template BufferRef<Type>;
+  using LaunchOptions = typename BaseKernel::LaunchOptions;
+
+
+  //! Initialize the kernel
+  CpuStaticKernel(IdData&& id) noexcept;
+
+  //! Finalize the kernel
+  ~CpuStaticKernel() noexcept override;
+
+
+  //! Record a launch of the kernel in the command list
+  void record(CommandList* command_list,
+              BufferRef<ArgTypes>... args,
+              const LaunchOptions& launch_options) override;
+
+  //! Execute a kernel asynchronously
+  Fence run(BufferRef<ArgTypes>... args,
+            const LaunchOptions& launch_options) override;
+
+ protected:
+  //! Initialize the kernel
+  void initData(const InitParameters& params) override;
+
+ private:
+  static_assert(std::is_same_v<Function, decltype(kFunction)>,
+                "The kernel function doesn't match the arguments.");
+  static_assert(sizeof...(FuncArgTypes) == sizeof...(ArgTypes),
+                "The kernel has local arguments.");
+  static_assert(BaseKernel::localMemorySize() == 0,
+                "The kernel has local arguments.");
+
+
+  //! Invoke the kernel function for each work-group in the range
+  template <typename ...Types>
+  static void invoke(const uint32b begin,
+                     const uint32b end,
+                     Types&&... cl_args) noexcept;
+
+  //! Return the number of lanes which are processed by an invocation
+  uint32b laneSize() const noexcept;
+
+  //! Make a command which invokes the kernel for a range of work-groups
+  auto makeBatchCommand(BufferRef<ArgTypes>... args) const noexcept;
+
+  //! Return the kernel argument of the given buffer
+  template <typename FuncArgType, typename Type>
+  static decltype(auto) toKernelArg(Buffer<Type>& buffer) noexcept;
+};
+
+} // namespace zinvul
+
+#include "cpu_static_kernel-inl.hpp"
+
+#endif // ZINVUL_CPU_STATIC_KERNEL_HPP
@@ -21,10 +21,88 @@
 // Zisc
 #include "zisc/utility.hpp"
 // Zinvul
+#include "utility/numa_topology.hpp"
 #include "zinvul/zinvul_config.hpp"
 
 namespace zinvul {
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool CpuSubPlatform::adaptiveTaskBatchEnabled() const noexcept
+{
+  return adaptive_task_batch_enabled_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t CpuSubPlatform::bufferAlignment() const noexcept
+{
+  return buffer_alignment_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuCorePolicy CpuSubPlatform::corePolicy() const noexcept
+{
+  return core_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuHugePagePolicy CpuSubPlatform::hugePagePolicy() const noexcept
+{
+  return huge_page_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t CpuSubPlatform::hugePageThreshold() const noexcept
+{
+  return huge_page_threshold_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b CpuSubPlatform::maxBufferAlignment() noexcept
+{
+  return 4096;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b CpuSubPlatform::maxNumOfQueues() noexcept
+{
+  return 64;
+}
+
 /*!
   \details No detailed description
 
@@ -36,6 +114,50 @@ constexpr uint32b CpuSubPlatform::maxTaskBatchSize() noexcept
   return 256;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b CpuSubPlatform::maxWorkGroupSize() noexcept
+{
+  return 1024;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuMemoryPolicy CpuSubPlatform::memoryPolicy() const noexcept
+{
+  return memory_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b CpuSubPlatform::minBufferAlignment() noexcept
+{
+  return 64;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t CpuSubPlatform::numOfQueues() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_queues_);
+}
+
 /*!
   \details No detailed description
 
@@ -47,6 +169,28 @@ std::size_t CpuSubPlatform::numOfThreads() const noexcept
   return zisc::cast<std::size_t>(num_of_threads_);
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool CpuSubPlatform::numaPinningEnabled() const noexcept
+{
+  return numa_pinning_enabled_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const NumaTopology& CpuSubPlatform::numaTopology() const noexcept
+{
+  return *numa_topology_;
+}
+
 /*!
   \details No detailed description
 
@@ -58,6 +202,28 @@ std::size_t CpuSubPlatform::taskBatchSize() const noexcept
   return zisc::cast<std::size_t>(task_batch_size_);
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b CpuSubPlatform::taskBatchTime() const noexcept
+{
+  return task_batch_time_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b CpuSubPlatform::workGroupSize() const noexcept
+{
+  return work_group_size_;
+}
+
 } // namespace zinvul
 
 #endif // ZINVUL_CPU_SUB_PLATFORM_INL_HPP
@@ -14,6 +14,7 @@
 
 #include "cpu_sub_platform.hpp"
 // Standard C++ library
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <memory>
@@ -24,6 +25,7 @@
 // Zinvul
 #include "cpu_device.hpp"
 #include "cpu_device_info.hpp"
+#include "utility/numa_topology.hpp"
 #include "zinvul/device.hpp"
 #include "zinvul/platform.hpp"
 #include "zinvul/platform_options.hpp"
@@ -117,7 +119,7 @@ SubPlatformType CpuSubPlatform::type() const noexcept
   */
 void CpuSubPlatform::updateDeviceInfoList() noexcept
 {
-  device_info_->fetch();
+  device_info_->fetch(*numa_topology_);
 }
 
 /*!
@@ -126,7 +128,18 @@ void CpuSubPlatform::updateDeviceInfoList() noexcept
 void CpuSubPlatform::destroyData() noexcept
 {
   num_of_threads_ = 0;
+  num_of_queues_ = 4;
   task_batch_size_ = 32;
+  task_batch_time_ = 50;
+  work_group_size_ = 1;
+  buffer_alignment_ = 64;
+  memory_policy_ = CpuMemoryPolicy::kFirstTouch;
+  core_policy_ = CpuCorePolicy::kAny;
+  huge_page_policy_ = CpuHugePagePolicy::kNone;
+  huge_page_threshold_ = 0;
+  numa_pinning_enabled_ = false;
+  adaptive_task_batch_enabled_ = false;
+  numa_topology_.reset();
   device_info_.reset();
 }
 
@@ -141,9 +154,47 @@ void CpuSubPlatform::initData(PlatformOptions& platform_options)
   zisc::pmr::polymorphic_allocator<CpuDeviceInfo> alloc{mem_resource};
   device_info_ = zisc::pmr::allocateUnique<CpuDeviceInfo>(alloc, mem_resource);
   num_of_threads_ = platform_options.cpuNumOfThreads();
+  num_of_queues_ = zisc::clamp(platform_options.cpuNumOfQueues(),
+                               1,
+                               maxNumOfQueues());
   const uint32b max_batch_size = maxTaskBatchSize();
   task_batch_size_ = platform_options.cpuTaskBatchSize();
   task_batch_size_ = zisc::clamp(task_batch_size_, 1, max_batch_size);
+  task_batch_time_ = std::max(platform_options.cpuTaskBatchTime(), 1u);
+  adaptive_task_batch_enabled_ = platform_options.cpuAdaptiveTaskBatchEnabled();
+  // The work-group size is rounded down to power of 2
+  const uint32b max_group_size = maxWorkGroupSize();
+  const uint32b group_size = zisc::clamp(platform_options.cpuWorkGroupSize(),
+                                         1,
+                                         max_group_size);
+  for (work_group_size_ = 1; (work_group_size_ << 1) <= group_size;)
+    work_group_size_ <<= 1;
+  device_info_->setWorkGroupSize(work_group_size_);
+  // The buffer alignment is rounded up to power of 2
+  const uint32b alignment = zisc::clamp(platform_options.cpuBufferAlignment(),
+                                        minBufferAlignment(),
+                                        maxBufferAlignment());
+  for (buffer_alignment_ = minBufferAlignment(); buffer_alignment_ < alignment;)
+    buffer_alignment_ <<= 1;
+
+  {
+    zisc::pmr::polymorphic_allocator<NumaTopology> topology_alloc{mem_resource};
+    numa_topology_ = zisc::pmr::allocateUnique<NumaTopology>(topology_alloc,
+                                                             mem_resource);
+    numa_topology_->fetch();
+  }
+  memory_policy_ = platform_options.cpuMemoryPolicy();
+  huge_page_policy_ = platform_options.cpuHugePagePolicy();
+  huge_page_threshold_ = platform_options.cpuHugePageThreshold();
+  numa_pinning_enabled_ = platform_options.cpuNumaPinningEnabled();
+  core_policy_ = platform_options.cpuCorePolicy();
+  // A worker runs on each core of the policy if the number isn't specified
+  if (num_of_threads_ == 0) {
+    if (core_policy_ == CpuCorePolicy::kPhysicalCore)
+      num_of_threads_ = zisc::cast<uint32b>(numa_topology_->numOfPhysicalCores());
+    else if (core_policy_ == CpuCorePolicy::kLogicalCore)
+      num_of_threads_ = zisc::cast<uint32b>(numa_topology_->numOfLogicalCores());
+  }
 }
 
 } // namespace zinvul
@@ -23,6 +23,7 @@
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
 #include "cpu_device_info.hpp"
+#include "utility/numa_topology.hpp"
 #include "zinvul/device.hpp"
 #include "zinvul/sub_platform.hpp"
 #include "zinvul/zinvul_config.hpp"
@@ -48,6 +49,15 @@ class CpuSubPlatform : public SubPlatform
   ~CpuSubPlatform() noexcept override;
 
 
+  //! Check whether the task batch size is adjusted at runtime
+  bool adaptiveTaskBatchEnabled() const noexcept;
+
+  //! Return the alignment of the storage of buffers in bytes
+  std::size_t bufferAlignment() const noexcept;
+
+  //! Return the placement of the worker threads on the cores
+  CpuCorePolicy corePolicy() const noexcept;
+
   //! Add the underlying device info into the given list
   void getDeviceInfoList(zisc::pmr::vector<const DeviceInfo*>& device_info_list) const noexcept override;
 
@@ -57,24 +67,60 @@ class CpuSubPlatform : public SubPlatform
   //! Make a unique device
   SharedDevice makeDevice(const DeviceInfo& device_info) noexcept override;
 
+  //! Return the use of huge pages for the memory of large buffers
+  CpuHugePagePolicy hugePagePolicy() const noexcept;
+
+  //! Return the size in bytes from which buffers are backed by huge pages
+  std::size_t hugePageThreshold() const noexcept;
+
+  //! Return the maximum alignment of the storage of buffers
+  static constexpr uint32b maxBufferAlignment() noexcept;
+
+  //! Return the maximum number of command queues of a device
+  static constexpr uint32b maxNumOfQueues() noexcept;
+
   //! Return the maximum task batch size per thread
   static constexpr uint32b maxTaskBatchSize() noexcept;
 
+  //! Return the maximum local work-group size
+  static constexpr uint32b maxWorkGroupSize() noexcept;
+
+  //! Return the memory policy of buffers
+  CpuMemoryPolicy memoryPolicy() const noexcept;
+
+  //! Return the minimum alignment of the storage of buffers
+  static constexpr uint32b minBufferAlignment() noexcept;
+
   //! Return the number of available devices
   std::size_t numOfDevices() const noexcept override;
 
+  //! Return the number of command queues of a device
+  std::size_t numOfQueues() const noexcept;
+
   //! Return the number of thread which is used for kernel execution
   std::size_t numOfThreads() const noexcept;
 
+  //! Check whether the worker threads are pinned to NUMA nodes
+  bool numaPinningEnabled() const noexcept;
+
+  //! Return the NUMA topology of the host
+  const NumaTopology& numaTopology() const noexcept;
+
   //! Return the task batch size per thread
   std::size_t taskBatchSize() const noexcept;
 
+  //! Return the target execution time of a task batch in microseconds
+  uint32b taskBatchTime() const noexcept;
+
   //! Return the sub-platform type
   SubPlatformType type() const noexcept override;
 
   //! Update the device info list
   void updateDeviceInfoList() noexcept override;
 
+  //! Return the local work-group size
+  uint32b workGroupSize() const noexcept;
+
  protected:
   //! Destroy the sub-platform
   void destroyData() noexcept override;
@@ -84,8 +130,19 @@ class CpuSubPlatform : public SubPlatform
 
  private:
   zisc::pmr::unique_ptr<CpuDeviceInfo> device_info_;
+  zisc::pmr::unique_ptr<NumaTopology> numa_topology_;
   uint32b num_of_threads_ = 0;
+  uint32b num_of_queues_ = 4;
   uint32b task_batch_size_ = 32;
+  uint32b task_batch_time_ = 50;
+  uint32b work_group_size_ = 1;
+  uint32b buffer_alignment_ = 64;
+  CpuMemoryPolicy memory_policy_ = CpuMemoryPolicy::kFirstTouch;
+  CpuCorePolicy core_policy_ = CpuCorePolicy::kAny;
+  CpuHugePagePolicy huge_page_policy_ = CpuHugePagePolicy::kNone;
+  std::size_t huge_page_threshold_ = 0;
+  bool numa_pinning_enabled_ = false;
+  bool adaptive_task_batch_enabled_ = false;
 };
 
 } // namespace zinvul
@@ -0,0 +1,97 @@
+/*!
+  \file command_queue-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_COMMAND_QUEUE_INL_HPP
+#define ZINVUL_COMMAND_QUEUE_INL_HPP
+
+#include "command_queue.hpp"
+// Standard C++ library
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint64b CommandQueue::completedNumber() const noexcept
+{
+  const uint64b number = completed_number_.load(std::memory_order_acquire);
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Function No description.
+  \param [in] command No description.
+  \return No description
+  */
+template <typename Function> inline
+uint64b CommandQueue::enqueue(Function&& command) noexcept
+{
+  using CommandT = FunctionCommand<std::decay_t<Function>>;
+  zisc::pmr::polymorphic_allocator<CommandT> alloc{mem_resource_};
+  CommandT* c = alloc.allocate(1);
+  ::new (c) CommandT{std::forward<Function>(command)};
+  const uint64b number = submit(c);
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] function No description.
+  */
+template <typename Function> inline
+CommandQueue::FunctionCommand<Function>::FunctionCommand(Function function)
+    noexcept : function_{std::move(function)}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+template <typename Function> inline
+void CommandQueue::FunctionCommand<Function>::release(
+    zisc::pmr::memory_resource* mem_resource) noexcept
+{
+  zisc::pmr::polymorphic_allocator<FunctionCommand> alloc{mem_resource};
+  this->~FunctionCommand();
+  alloc.deallocate(this, 1);
+}
+
+/*!
+  \details No detailed description
+  */
+template <typename Function> inline
+void CommandQueue::FunctionCommand<Function>::run() noexcept
+{
+  function_();
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_COMMAND_QUEUE_INL_HPP
@@ -0,0 +1,148 @@
+/*!
+  \file command_queue.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "command_queue.hpp"
+// Standard C++ library
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+  */
+CommandQueue::Command::~Command() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+CommandQueue::CommandQueue(zisc::pmr::memory_resource* mem_resource) noexcept :
+    mem_resource_{mem_resource},
+    command_list_{zisc::pmr::vector<Command*>::allocator_type{mem_resource}},
+    completed_number_{0}
+{
+  dispatch_thread_ = std::thread{[this]() noexcept {dispatch();}};
+}
+
+/*!
+  \details No detailed description
+  */
+CommandQueue::~CommandQueue() noexcept
+{
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    is_finished_ = true;
+  }
+  command_condition_.notify_one();
+  dispatch_thread_.join();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint64b CommandQueue::submittedNumber() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return submitted_number_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] number No description.
+  */
+void CommandQueue::wait(const uint64b number) const noexcept
+{
+  if (completedNumber() < number) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    completion_condition_.wait(lock, [this, number]() noexcept
+    {
+      return number <= completedNumber();
+    });
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void CommandQueue::waitForCompletion() const noexcept
+{
+  wait(submittedNumber());
+}
+
+/*!
+  \details The commands which are submitted while the dispatch thread is
+  executing commands are taken at once at the next iteration.
+  The remaining commands are executed before the thread exits
+  */
+void CommandQueue::dispatch() noexcept
+{
+  zisc::pmr::vector<Command*> command_list{
+      zisc::pmr::vector<Command*>::allocator_type{mem_resource_}};
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      command_condition_.wait(lock, [this]() noexcept
+      {
+        return !command_list_.empty() || is_finished_;
+      });
+      if (command_list_.empty())
+        break;
+      std::swap(command_list, command_list_);
+    }
+    for (auto command : command_list) {
+      command->run();
+      command->release(mem_resource_);
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        completed_number_.fetch_add(1, std::memory_order_release);
+      }
+      completion_condition_.notify_all();
+    }
+    command_list.clear();
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] command No description.
+  \return No description
+  */
+uint64b CommandQueue::submit(Command* command) noexcept
+{
+  uint64b number = 0;
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    command_list_.emplace_back(command);
+    number = ++submitted_number_;
+  }
+  command_condition_.notify_one();
+  return number;
+}
+
+} // namespace zinvul
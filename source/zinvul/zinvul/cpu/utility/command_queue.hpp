@@ -0,0 +1,130 @@
+/*!
+  \file command_queue.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_COMMAND_QUEUE_HPP
+#define ZINVUL_COMMAND_QUEUE_HPP
+
+// Standard C++ library
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief Execute commands asynchronously in submission order
+
+  A queue has a dispatch thread which takes submitted commands and executes
+  them one by one, so that the submitter can prepare the next commands while
+  the previous commands are executed. Commands are numbered from 1 in
+  submission order and the number of completed commands is used to check the
+  completion of a command.
+  */
+class CommandQueue : private zisc::NonCopyable<CommandQueue>
+{
+ public:
+  /*!
+    \brief A command which is owned by a queue
+    */
+  class Command
+  {
+   public:
+    //! Finalize the command
+    virtual ~Command() noexcept;
+
+
+    //! Destroy the command and deallocate the memory of it
+    virtual void release(zisc::pmr::memory_resource* mem_resource) noexcept = 0;
+
+    //! Execute the command
+    virtual void run() noexcept = 0;
+  };
+
+
+  //! Create a queue and start the dispatch thread
+  CommandQueue(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+  //! Wait for the completion of all commands and stop the dispatch thread
+  ~CommandQueue() noexcept;
+
+
+  //! Return the number of completed commands
+  uint64b completedNumber() const noexcept;
+
+  //! Submit a command and return the number of the command
+  template <typename Function>
+  uint64b enqueue(Function&& command) noexcept;
+
+  //! Return the number of submitted commands
+  uint64b submittedNumber() const noexcept;
+
+  //! Wait this thread until the command of the given number is completed
+  void wait(const uint64b number) const noexcept;
+
+  //! Wait this thread until all submitted commands are completed
+  void waitForCompletion() const noexcept;
+
+ private:
+  /*!
+    \brief A command which holds a function object
+    */
+  template <typename Function>
+  class FunctionCommand : public Command
+  {
+   public:
+    //! Create a command
+    FunctionCommand(Function function) noexcept;
+
+
+    //! Destroy the command and deallocate the memory of it
+    void release(zisc::pmr::memory_resource* mem_resource) noexcept override;
+
+    //! Execute the command
+    void run() noexcept override;
+
+   private:
+    Function function_;
+  };
+
+
+  //! Process submitted commands on the dispatch thread
+  void dispatch() noexcept;
+
+  //! Submit a command and return the number of the command
+  uint64b submit(Command* command) noexcept;
+
+
+  zisc::pmr::memory_resource* mem_resource_;
+  zisc::pmr::vector<Command*> command_list_;
+  mutable std::mutex mutex_;
+  std::condition_variable command_condition_;
+  mutable std::condition_variable completion_condition_;
+  std::atomic<uint64b> completed_number_;
+  uint64b submitted_number_ = 0;
+  bool is_finished_ = false;
+  std::thread dispatch_thread_;
+};
+
+} // namespace zinvul
+
+#include "command_queue-inl.hpp"
+
+#endif // ZINVUL_COMMAND_QUEUE_HPP
@@ -0,0 +1,213 @@
+/*!
+  \file default_init_allocator-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_DEFAULT_INIT_ALLOCATOR_INL_HPP
+#define ZINVUL_DEFAULT_INIT_ALLOCATOR_INL_HPP
+
+#include "default_init_allocator.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+  */
+template <typename T> inline
+DefaultInitAllocator<T>::DefaultInitAllocator() noexcept
+{
+}
+
+/*!
+  \details The alignment isn't less than the alignment of the element type
+
+  \param [in] mem_resource No description.
+  \param [in] alignment No description.
+  */
+template <typename T> inline
+DefaultInitAllocator<T>::DefaultInitAllocator(
+    zisc::pmr::memory_resource* mem_resource,
+    const std::size_t alignment) noexcept :
+        BaseAllocator(mem_resource),
+        alignment_{std::max(alignment, alignof(T))}
+{
+  ZISC_ASSERT((alignment_ & (alignment_ - 1)) == 0,
+              "The alignment isn't power of 2: ", alignment_);
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Other No description.
+  \param [in] other No description.
+  */
+template <typename T> template <typename Other> inline
+DefaultInitAllocator<T>::DefaultInitAllocator(
+    const DefaultInitAllocator<Other>& other) noexcept :
+        BaseAllocator(other.resource()),
+        alignment_{std::max(other.alignment(), alignof(T))}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+std::size_t DefaultInitAllocator<T>::alignment() const noexcept
+{
+  return alignment_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] n No description.
+  \return No description
+  */
+template <typename T> inline
+T* DefaultInitAllocator<T>::allocate(const std::size_t n)
+{
+  auto mem_resource = BaseAllocator::resource();
+  void* p = mem_resource->allocate(getStorageSize(n), alignment());
+  return static_cast<T*>(p);
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type No description.
+  \param [out] p No description.
+  */
+template <typename T> template <typename Type> inline
+void DefaultInitAllocator<T>::construct(Type* p)
+    noexcept(std::is_nothrow_default_constructible_v<Type>)
+{
+  ::new (static_cast<void*>(p)) Type;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type No description.
+  \tparam Args No description.
+  \param [out] p No description.
+  \param [in] args No description.
+  */
+template <typename T> template <typename Type, typename ...Args> inline
+void DefaultInitAllocator<T>::construct(Type* p, Args&&... args)
+{
+  BaseAllocator::construct(p, std::forward<Args>(args)...);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] p No description.
+  \param [in] n No description.
+  */
+template <typename T> inline
+void DefaultInitAllocator<T>::deallocate(T* p, const std::size_t n) noexcept
+{
+  auto mem_resource = BaseAllocator::resource();
+  mem_resource->deallocate(p, getStorageSize(n), alignment());
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+constexpr std::size_t DefaultInitAllocator<T>::defaultAlignment() noexcept
+{
+  return 64;
+}
+
+/*!
+  \details The alignment of the allocator is kept
+
+  \return No description
+  */
+template <typename T> inline
+auto DefaultInitAllocator<T>::select_on_container_copy_construction() const noexcept
+    -> DefaultInitAllocator
+{
+  DefaultInitAllocator alloc{};
+  alloc.alignment_ = alignment_;
+  return alloc;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] n No description.
+  \return No description
+  */
+template <typename T> inline
+std::size_t DefaultInitAllocator<T>::getStorageSize(const std::size_t n) const noexcept
+{
+  const std::size_t a = alignment();
+  const std::size_t size = ((sizeof(T) * n + a - 1) / a) * a;
+  return size;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type1 No description.
+  \tparam Type2 No description.
+  \param [in] lhs No description.
+  \param [in] rhs No description.
+  \return No description
+  */
+template <typename Type1, typename Type2> inline
+bool operator==(const DefaultInitAllocator<Type1>& lhs,
+                const DefaultInitAllocator<Type2>& rhs) noexcept
+{
+  const bool result = (*lhs.resource() == *rhs.resource()) &&
+                      (lhs.alignment() == rhs.alignment());
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type1 No description.
+  \tparam Type2 No description.
+  \param [in] lhs No description.
+  \param [in] rhs No description.
+  \return No description
+  */
+template <typename Type1, typename Type2> inline
+bool operator!=(const DefaultInitAllocator<Type1>& lhs,
+                const DefaultInitAllocator<Type2>& rhs) noexcept
+{
+  const bool result = !(lhs == rhs);
+  return result;
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_DEFAULT_INIT_ALLOCATOR_INL_HPP
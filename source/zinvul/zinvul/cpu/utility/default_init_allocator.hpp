@@ -0,0 +1,110 @@
+/*!
+  \file default_init_allocator.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_DEFAULT_INIT_ALLOCATOR_HPP
+#define ZINVUL_DEFAULT_INIT_ALLOCATOR_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <type_traits>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief A polymorphic allocator which default-initializes elements
+
+  A container which uses the allocator doesn't value-initialize the elements
+  which are constructed without arguments, so growing the container leaves
+  the elements of a trivial type uninitialized instead of filling them with
+  zero. The storage is aligned to the alignment of the allocator and padded
+  to a multiple of it, so storages never share a cache line.
+
+  \tparam T No description.
+  */
+template <typename T>
+class DefaultInitAllocator : public zisc::pmr::polymorphic_allocator<T>
+{
+ public:
+  // Type aliases
+  using BaseAllocator = zisc::pmr::polymorphic_allocator<T>;
+  template <typename Other>
+  struct rebind
+  {
+    using other = DefaultInitAllocator<Other>;
+  };
+
+
+  //! Create an allocator with the default memory resource
+  DefaultInitAllocator() noexcept;
+
+  //! Create an allocator with the given memory resource
+  DefaultInitAllocator(zisc::pmr::memory_resource* mem_resource,
+                       const std::size_t alignment = defaultAlignment()) noexcept;
+
+  //! Create an allocator which uses the same memory resource as the other
+  template <typename Other>
+  DefaultInitAllocator(const DefaultInitAllocator<Other>& other) noexcept;
+
+
+  //! Return the alignment of storage
+  std::size_t alignment() const noexcept;
+
+  //! Allocate storage for n elements
+  T* allocate(const std::size_t n);
+
+
+  //! Default-initialize an object
+  template <typename Type>
+  void construct(Type* p) noexcept(std::is_nothrow_default_constructible_v<Type>);
+
+  //! Construct an object with the given arguments
+  template <typename Type, typename ...Args>
+  void construct(Type* p, Args&&... args);
+
+  //! Deallocate storage for n elements
+  void deallocate(T* p, const std::size_t n) noexcept;
+
+  //! Return the default alignment of storage, which is a cache line
+  static constexpr std::size_t defaultAlignment() noexcept;
+
+  //! Return an allocator with the default memory resource for a copied container
+  DefaultInitAllocator select_on_container_copy_construction() const noexcept;
+
+ private:
+  //! Return the size of storage for n elements in bytes
+  std::size_t getStorageSize(const std::size_t n) const noexcept;
+
+
+  std::size_t alignment_ = defaultAlignment();
+};
+
+//! Check if the allocators share the memory resource and the alignment
+template <typename Type1, typename Type2>
+bool operator==(const DefaultInitAllocator<Type1>& lhs,
+                const DefaultInitAllocator<Type2>& rhs) noexcept;
+
+//! Check if the allocators don't share the memory resource or the alignment
+template <typename Type1, typename Type2>
+bool operator!=(const DefaultInitAllocator<Type1>& lhs,
+                const DefaultInitAllocator<Type2>& rhs) noexcept;
+
+} // namespace zinvul
+
+#include "default_init_allocator-inl.hpp"
+
+#endif // ZINVUL_DEFAULT_INIT_ALLOCATOR_HPP
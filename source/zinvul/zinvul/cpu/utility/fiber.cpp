@@ -0,0 +1,428 @@
+/*!
+  \file fiber.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#if defined(Z_MAC) && !defined(_XOPEN_SOURCE)
+// The ucontext routines of macOS require the macro
+#define _XOPEN_SOURCE 700
+#endif // Z_MAC
+
+#include "fiber.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+// Platform
+#if defined(Z_WINDOWS)
+#include <windows.h>
+#else // Z_WINDOWS
+#include <ucontext.h>
+#endif // Z_WINDOWS
+#if defined(Z_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // Z_LINUX
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+#if defined(Z_LINUX) && (defined(__x86_64__) || defined(__aarch64__))
+// A fiber switch saves only the callee-saved registers, so it doesn't make
+// the signal mask syscall of swapcontext
+#define ZINVUL_FIBER_REGISTER_SWITCH 1
+#endif
+
+#if defined(ZINVUL_FIBER_REGISTER_SWITCH)
+
+extern "C" {
+
+//! Save the registers on the current stack and restore them from the given stack
+void zinvulSwitchFiberStack(void** current_stack, void* next_stack) noexcept;
+
+//! The first return address of a fiber, which calls the entry function
+void zinvulStartFiber() noexcept;
+
+} // extern "C"
+
+#if defined(__x86_64__)
+
+// The stack of a fiber: x87 control word and mxcsr, r15, r14, r13, r12, rbx,
+// rbp and the return address. r12 and r13 of a new fiber are the fiber and
+// the entry function
+asm(R"(
+  .text
+  .p2align 4
+  .type zinvulSwitchFiberStack, @function
+zinvulSwitchFiberStack:
+  pushq %rbp
+  pushq %rbx
+  pushq %r12
+  pushq %r13
+  pushq %r14
+  pushq %r15
+  subq $8, %rsp
+  stmxcsr (%rsp)
+  fnstcw 4(%rsp)
+  movq %rsp, (%rdi)
+  movq %rsi, %rsp
+  ldmxcsr (%rsp)
+  fldcw 4(%rsp)
+  addq $8, %rsp
+  popq %r15
+  popq %r14
+  popq %r13
+  popq %r12
+  popq %rbx
+  popq %rbp
+  ret
+  .size zinvulSwitchFiberStack, .-zinvulSwitchFiberStack
+
+  .p2align 4
+  .type zinvulStartFiber, @function
+zinvulStartFiber:
+  movq %r12, %rdi
+  callq *%r13
+  ud2
+  .size zinvulStartFiber, .-zinvulStartFiber
+)");
+
+#elif defined(__aarch64__)
+
+// The stack of a fiber: x19-x28, x29, x30, d8-d15 and padding. x19 and x20
+// of a new fiber are the fiber and the entry function
+asm(R"(
+  .text
+  .p2align 4
+  .type zinvulSwitchFiberStack, %function
+zinvulSwitchFiberStack:
+  sub sp, sp, #176
+  stp x19, x20, [sp, #0]
+  stp x21, x22, [sp, #16]
+  stp x23, x24, [sp, #32]
+  stp x25, x26, [sp, #48]
+  stp x27, x28, [sp, #64]
+  stp x29, x30, [sp, #80]
+  stp d8, d9, [sp, #96]
+  stp d10, d11, [sp, #112]
+  stp d12, d13, [sp, #128]
+  stp d14, d15, [sp, #144]
+  mov x9, sp
+  str x9, [x0]
+  mov sp, x1
+  ldp x19, x20, [sp, #0]
+  ldp x21, x22, [sp, #16]
+  ldp x23, x24, [sp, #32]
+  ldp x25, x26, [sp, #48]
+  ldp x27, x28, [sp, #64]
+  ldp x29, x30, [sp, #80]
+  ldp d8, d9, [sp, #96]
+  ldp d10, d11, [sp, #112]
+  ldp d12, d13, [sp, #128]
+  ldp d14, d15, [sp, #144]
+  add sp, sp, #176
+  ret
+  .size zinvulSwitchFiberStack, .-zinvulSwitchFiberStack
+
+  .p2align 4
+  .type zinvulStartFiber, %function
+zinvulStartFiber:
+  mov x0, x19
+  blr x20
+  brk #0
+  .size zinvulStartFiber, .-zinvulStartFiber
+)");
+
+#endif
+
+#endif // ZINVUL_FIBER_REGISTER_SWITCH
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+Fiber::Fiber(zisc::pmr::memory_resource* mem_resource) noexcept :
+    memory_{decltype(memory_)::allocator_type{mem_resource}}
+{
+  initialize(0);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] func No description.
+  \param [in] data No description.
+  \param [in] stack_size No description.
+  \param [in] mem_resource No description.
+  */
+Fiber::Fiber(Function func,
+             void* data,
+             const std::size_t stack_size,
+             zisc::pmr::memory_resource* mem_resource) noexcept :
+    memory_{decltype(memory_)::allocator_type{mem_resource}},
+    function_{func},
+    data_{data}
+{
+  ZISC_ASSERT(func != nullptr, "The fiber function is null.");
+  ZISC_ASSERT(0 < stack_size, "The stack size of the fiber is zero.");
+  initialize(stack_size);
+}
+
+/*!
+  \details No detailed description
+  */
+Fiber::~Fiber() noexcept
+{
+#if defined(Z_WINDOWS)
+  if (hasStack() && (handle_ != nullptr))
+    DeleteFiber(handle_);
+#else // Z_WINDOWS
+  deallocateStack();
+#endif // Z_WINDOWS
+  handle_ = nullptr;
+}
+
+/*!
+  \details No detailed description
+  */
+void Fiber::bindThread() noexcept
+{
+#if defined(Z_WINDOWS)
+  if (!hasStack()) {
+    is_thread_converted_ = IsThreadAFiber() == FALSE;
+    handle_ = is_thread_converted_ ? ConvertThreadToFiber(nullptr)
+                                   : GetCurrentFiber();
+  }
+#endif // Z_WINDOWS
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool Fiber::hasStack() const noexcept
+{
+  const bool result = function_ != nullptr;
+  return result;
+}
+
+/*!
+  \details On Linux x86-64 and aarch64, only the callee-saved registers and
+  the stack pointer are switched, so the switch doesn't enter the kernel.
+  The other platforms use the fiber or the ucontext routines of the OS
+
+  \param [in,out] current No description.
+  */
+void Fiber::switchFrom(Fiber* current) noexcept
+{
+  ZISC_ASSERT(current != this, "The fiber switches to itself.");
+#if defined(Z_WINDOWS)
+  static_cast<void>(current);
+  SwitchToFiber(handle_);
+#elif defined(ZINVUL_FIBER_REGISTER_SWITCH)
+  zinvulSwitchFiberStack(std::addressof(current->handle_), handle_);
+#else // Z_WINDOWS
+  auto from = zisc::cast<ucontext_t*>(current->handle_);
+  auto to = zisc::cast<ucontext_t*>(handle_);
+  const int result = swapcontext(from, to);
+  if (result != 0) {
+    //! \todo Handle the error
+    std::cerr << "[Error] Fiber switching failed." << std::endl;
+    std::abort();
+  }
+#endif // Z_WINDOWS
+}
+
+/*!
+  \details No detailed description
+  */
+void Fiber::unbindThread() noexcept
+{
+#if defined(Z_WINDOWS)
+  if (!hasStack() && is_thread_converted_) {
+    ConvertFiberToThread();
+    is_thread_converted_ = false;
+    handle_ = nullptr;
+  }
+#endif // Z_WINDOWS
+}
+
+/*!
+  \details The stack isn't initialized since a fiber stack is large and
+  most of it is never touched. On Linux, the stack is mapped from the OS and
+  its lowest page is protected as a guard page, so a stack overflow faults
+  instead of corrupting the neighboring memory
+
+  \param [in] stack_size No description.
+  */
+void Fiber::allocateStack(const std::size_t stack_size) noexcept
+{
+#if defined(Z_LINUX)
+  const auto page_size = zisc::cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  stack_size_ = ((stack_size + page_size - 1) / page_size) * page_size;
+  stack_memory_size_ = page_size + stack_size_;
+  constexpr int prot = PROT_READ | PROT_WRITE;
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK;
+  void* memory = ::mmap(nullptr, stack_memory_size_, prot, flags, -1, 0);
+  if ((memory == MAP_FAILED) || (::mprotect(memory, page_size, PROT_NONE) != 0)) {
+    //! \todo Handle the error
+    std::cerr << "[Error] Fiber stack allocation failed." << std::endl;
+    std::abort();
+  }
+  stack_ = zisc::cast<std::byte*>(memory) + page_size;
+#else // Z_LINUX
+  constexpr std::size_t alignment = alignof(std::max_align_t);
+  stack_size_ = ((stack_size + alignment - 1) / alignment) * alignment;
+  stack_memory_size_ = stack_size_;
+  auto mem_resource = memory_.get_allocator().resource();
+  stack_ = mem_resource->allocate(stack_memory_size_, alignment);
+#endif // Z_LINUX
+}
+
+/*!
+  \details No detailed description
+  */
+void Fiber::deallocateStack() noexcept
+{
+  if (stack_ != nullptr) {
+#if defined(Z_LINUX)
+    const std::size_t page_size = stack_memory_size_ - stack_size_;
+    ::munmap(zisc::cast<std::byte*>(stack_) - page_size, stack_memory_size_);
+#else // Z_LINUX
+    auto mem_resource = memory_.get_allocator().resource();
+    mem_resource->deallocate(stack_, stack_memory_size_, alignof(std::max_align_t));
+#endif // Z_LINUX
+    stack_ = nullptr;
+    stack_size_ = 0;
+    stack_memory_size_ = 0;
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] fiber No description.
+  */
+void Fiber::enter(Fiber* fiber) noexcept
+{
+  fiber->function_(fiber->data_);
+  //! \todo Handle the error
+  std::cerr << "[Error] A fiber function returned." << std::endl;
+  std::abort();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] high No description.
+  \param [in] low No description.
+  */
+void Fiber::enterContext(const int high, const int low) noexcept
+{
+  const std::uintptr_t address =
+      (zisc::cast<std::uintptr_t>(zisc::cast<uint32b>(high)) << 32) |
+      zisc::cast<std::uintptr_t>(zisc::cast<uint32b>(low));
+  enter(reinterpret_cast<Fiber*>(address));
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] fiber No description.
+  */
+void Fiber::enterFiber(void* fiber) noexcept
+{
+  enter(zisc::cast<Fiber*>(fiber));
+}
+
+/*!
+  \details With the register switch, the handle is the stack pointer which
+  the fiber was switched out at. The stack of a new fiber is initialized as
+  if the fiber was switched out at the start of zinvulStartFiber
+
+  \param [in] stack_size No description.
+  */
+void Fiber::initialize(const std::size_t stack_size) noexcept
+{
+#if defined(Z_WINDOWS)
+  if (hasStack()) {
+    auto entry = reinterpret_cast<LPFIBER_START_ROUTINE>(&Fiber::enterFiber);
+    handle_ = CreateFiber(stack_size, entry, this);
+    if (handle_ == nullptr) {
+      //! \todo Handle the error
+      std::cerr << "[Error] Fiber creation failed." << std::endl;
+      std::abort();
+    }
+  }
+#elif defined(ZINVUL_FIBER_REGISTER_SWITCH)
+  if (hasStack()) {
+    allocateStack(stack_size);
+    const auto fiber = reinterpret_cast<std::uintptr_t>(this);
+    const auto entry = reinterpret_cast<std::uintptr_t>(&Fiber::enter);
+    const auto start = reinterpret_cast<std::uintptr_t>(&zinvulStartFiber);
+    auto top = zisc::cast<std::byte*>(stack_) + stack_size_;
+#if defined(__x86_64__)
+    // The stack is 16 byte aligned at the call of the entry function
+    constexpr std::size_t frame_size = 8;
+    auto frame = reinterpret_cast<std::uintptr_t*>(top - 16) - frame_size;
+    constexpr std::uintptr_t default_mxcsr = 0x1f80;
+    constexpr std::uintptr_t default_fpu_control = 0x037f;
+    const std::array<std::uintptr_t, frame_size> registers{{
+        default_mxcsr | (default_fpu_control << 32), // Control words
+        0, 0, entry, fiber, 0, 0, // r15, r14, r13, r12, rbx, rbp
+        start}};
+#elif defined(__aarch64__)
+    constexpr std::size_t frame_size = 22;
+    auto frame = reinterpret_cast<std::uintptr_t*>(top) - frame_size;
+    std::array<std::uintptr_t, frame_size> registers{};
+    registers[0] = fiber; // x19
+    registers[1] = entry; // x20
+    registers[11] = start; // x30
+#endif
+    std::copy(registers.begin(), registers.end(), frame);
+    handle_ = frame;
+  }
+#else // Z_WINDOWS
+  using Block = decltype(memory_)::value_type;
+  constexpr std::size_t context_size = (sizeof(ucontext_t) + sizeof(Block) - 1) /
+                                       sizeof(Block);
+  memory_.resize(context_size);
+  auto context = ::new (zisc::cast<void*>(memory_.data())) ucontext_t{};
+  handle_ = context;
+  if (hasStack()) {
+    allocateStack(stack_size);
+    getcontext(context);
+    context->uc_stack.ss_sp = stack_;
+    context->uc_stack.ss_size = stack_size_;
+    context->uc_link = nullptr;
+    const auto address = reinterpret_cast<std::uintptr_t>(this);
+    const int high = zisc::cast<int>(zisc::cast<uint32b>(address >> 32));
+    const int low = zisc::cast<int>(zisc::cast<uint32b>(address & 0xffff'ffffu));
+    auto entry = reinterpret_cast<void (*)()>(&Fiber::enterContext);
+    makecontext(context, entry, 2, high, low);
+  }
+#endif // Z_WINDOWS
+}
+
+} // namespace zinvul
@@ -0,0 +1,99 @@
+/*!
+  \file fiber.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_FIBER_HPP
+#define ZINVUL_FIBER_HPP
+
+// Standard C++ library
+#include <cstddef>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief A user-space execution context which has its own stack
+
+  A fiber is switched explicitly with \a switchFrom on the thread which owns
+  it. A fiber which is made with the memory resource only represents the
+  context of the thread itself.
+  */
+class Fiber : private zisc::NonCopyable<Fiber>
+{
+ public:
+  // Type aliases
+  using Function = void (*)(void* data);
+
+
+  //! Create a fiber which represents the current thread
+  Fiber(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+  //! Create a fiber which runs the given function on its own stack
+  Fiber(Function func,
+        void* data,
+        const std::size_t stack_size,
+        zisc::pmr::memory_resource* mem_resource) noexcept;
+
+  //! Destroy the fiber
+  ~Fiber() noexcept;
+
+
+  //! Bind the fiber to the current thread
+  void bindThread() noexcept;
+
+  //! Check if the fiber has its own stack
+  bool hasStack() const noexcept;
+
+  //! Switch the execution from the given fiber to this fiber
+  void switchFrom(Fiber* current) noexcept;
+
+  //! Unbind the fiber from the current thread
+  void unbindThread() noexcept;
+
+ private:
+  //! Allocate the stack of the fiber
+  void allocateStack(const std::size_t stack_size) noexcept;
+
+  //! Deallocate the stack of the fiber
+  void deallocateStack() noexcept;
+
+  //! The entry point of the fiber
+  static void enter(Fiber* fiber) noexcept;
+
+  //! The entry point of a ucontext. The fiber pointer is split into two ints
+  static void enterContext(const int high, const int low) noexcept;
+
+  //! The entry point of a windows fiber
+  static void enterFiber(void* fiber) noexcept;
+
+  //! Initialize the underlying context
+  void initialize(const std::size_t stack_size) noexcept;
+
+
+  zisc::pmr::vector<std::max_align_t> memory_; //!< Context
+  void* stack_ = nullptr;
+  std::size_t stack_size_ = 0;
+  std::size_t stack_memory_size_ = 0; //!< Including the guard page
+  void* handle_ = nullptr;
+  Function function_ = nullptr;
+  void* data_ = nullptr;
+  bool is_thread_converted_ = false;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_FIBER_HPP
@@ -0,0 +1,39 @@
+/*!
+  \file huge_page_memory_resource-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_INL_HPP
+#define ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_INL_HPP
+
+#include "huge_page_memory_resource.hpp"
+// Standard C++ library
+#include <cstddef>
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details The default huge page size of x86-64 and aarch64 with 4 KiB pages
+
+  \return No description
+  */
+inline
+constexpr std::size_t HugePageMemoryResource::hugePageSize() noexcept
+{
+  return 2 * 1024 * 1024;
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_INL_HPP
@@ -0,0 +1,264 @@
+/*!
+  \file huge_page_memory_resource.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "huge_page_memory_resource.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#if defined(Z_LINUX)
+#include <sys/mman.h>
+#endif // Z_LINUX
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] policy No description.
+  \param [in] threshold No description.
+  \param [in] upstream No description.
+  */
+HugePageMemoryResource::HugePageMemoryResource(
+    const CpuHugePagePolicy policy,
+    const std::size_t threshold,
+    zisc::pmr::memory_resource* upstream) noexcept :
+        upstream_{upstream},
+        block_list_{decltype(block_list_)::allocator_type{upstream}},
+        threshold_{std::max(threshold, std::size_t{1})},
+        policy_{policy}
+{
+  ZISC_ASSERT(upstream_ != nullptr, "The upstream resource is null.");
+}
+
+/*!
+  \details No detailed description
+  */
+HugePageMemoryResource::~HugePageMemoryResource() noexcept
+{
+  for (const auto& block : block_list_)
+    unmapMemory(block.data_, block.size_);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] data No description.
+  \return No description
+  */
+bool HugePageMemoryResource::isMapped(const void* data) const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto block = std::find_if(block_list_.begin(), block_list_.end(),
+  [data](const MappedBlock& b) noexcept
+  {
+    return b.data_ == data;
+  });
+  return block != block_list_.end();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t HugePageMemoryResource::numOfMappedBlocks() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return block_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+CpuHugePagePolicy HugePageMemoryResource::policy() const noexcept
+{
+  return policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t HugePageMemoryResource::threshold() const noexcept
+{
+  return threshold_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+zisc::pmr::memory_resource* HugePageMemoryResource::upstream() const noexcept
+{
+  return upstream_;
+}
+
+/*!
+  \details The mapped blocks are few since they are large, so a block is
+  looked up linearly on deallocation
+
+  \param [in] size No description.
+  \param [in] alignment No description.
+  \return No description
+  */
+void* HugePageMemoryResource::do_allocate(std::size_t size, std::size_t alignment)
+{
+  void* data = nullptr;
+  const bool is_large = (policy_ != CpuHugePagePolicy::kNone) &&
+                        (threshold_ <= size) &&
+                        (alignment <= hugePageSize());
+  if (is_large) {
+    // The size is rounded up, so the tail of the last huge page isn't shared
+    const std::size_t page_size = hugePageSize();
+    const std::size_t s = ((size + page_size - 1) / page_size) * page_size;
+    data = mapMemory(policy_, s);
+    if (data != nullptr) {
+      std::unique_lock<std::mutex> lock{mutex_};
+      block_list_.push_back(MappedBlock{data, s});
+    }
+  }
+  if (data == nullptr)
+    data = upstream_->allocate(size, alignment);
+  return data;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] data No description.
+  \param [in] size No description.
+  \param [in] alignment No description.
+  */
+void HugePageMemoryResource::do_deallocate(void* data,
+                                           std::size_t size,
+                                           std::size_t alignment)
+{
+  std::size_t mapped_size = 0;
+  if (threshold_ <= size) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    auto block = std::find_if(block_list_.begin(), block_list_.end(),
+    [data](const MappedBlock& b) noexcept
+    {
+      return b.data_ == data;
+    });
+    if (block != block_list_.end()) {
+      mapped_size = block->size_;
+      *block = block_list_.back();
+      block_list_.pop_back();
+    }
+  }
+  if (0 < mapped_size)
+    unmapMemory(data, mapped_size);
+  else
+    upstream_->deallocate(data, size, alignment);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] other No description.
+  \return No description
+  */
+bool HugePageMemoryResource::do_is_equal(
+    const zisc::pmr::memory_resource& other) const noexcept
+{
+  const bool result = this == &other;
+  return result;
+}
+
+/*!
+  \details The explicit policy maps the memory from the huge page pool which
+  is reserved by the administrator. If the pool doesn't have enough pages,
+  the memory is mapped with the normal pages and the kernel is advised to
+  promote them to transparent huge pages. Nullptr is returned on failure
+
+  \param [in] policy No description.
+  \param [in] size No description.
+  \return No description
+  */
+void* HugePageMemoryResource::mapMemory(const CpuHugePagePolicy policy,
+                                        const std::size_t size) noexcept
+{
+  void* data = nullptr;
+#if defined(Z_LINUX)
+  constexpr int prot = PROT_READ | PROT_WRITE;
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  if (policy == CpuHugePagePolicy::kExplicit) {
+#if defined(MAP_HUGE_2MB)
+    constexpr int huge_flags = flags | MAP_HUGETLB | MAP_HUGE_2MB;
+#else // MAP_HUGE_2MB
+    constexpr int huge_flags = flags | MAP_HUGETLB;
+#endif // MAP_HUGE_2MB
+    void* p = ::mmap(nullptr, size, prot, huge_flags, -1, 0);
+    if (p != MAP_FAILED)
+      data = p;
+  }
+  if (data == nullptr) {
+    // Map extra memory and trim it so that the memory is aligned to a huge page
+    const std::size_t page_size = hugePageSize();
+    const std::size_t s = size + page_size;
+    void* p = ::mmap(nullptr, s, prot, flags, -1, 0);
+    if (p != MAP_FAILED) {
+      const auto address = reinterpret_cast<std::uintptr_t>(p);
+      const std::uintptr_t begin = ((address + page_size - 1) / page_size) * page_size;
+      const std::size_t head = zisc::cast<std::size_t>(begin - address);
+      const std::size_t tail = s - head - size;
+      if (0 < head)
+        ::munmap(p, head);
+      if (0 < tail)
+        ::munmap(reinterpret_cast<void*>(begin + size), tail);
+      data = reinterpret_cast<void*>(begin);
+#if defined(MADV_HUGEPAGE)
+      // The advice fails if transparent huge pages are disabled, which is harmless
+      ::madvise(data, size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+    }
+  }
+#else // Z_LINUX
+  static_cast<void>(policy);
+  static_cast<void>(size);
+#endif // Z_LINUX
+  return data;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] data No description.
+  \param [in] size No description.
+  */
+void HugePageMemoryResource::unmapMemory(void* data, const std::size_t size) noexcept
+{
+#if defined(Z_LINUX)
+  ::munmap(data, size);
+#else // Z_LINUX
+  static_cast<void>(data);
+  static_cast<void>(size);
+#endif // Z_LINUX
+}
+
+} // namespace zinvul
@@ -0,0 +1,110 @@
+/*!
+  \file huge_page_memory_resource.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_HPP
+#define ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <mutex>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief A memory resource which backs large allocations by huge pages
+
+  An allocation of the threshold size or larger is mapped directly from the
+  OS with the alignment of a huge page, so the kernel can back it by huge
+  pages. If the mapping fails, or the allocation is small, the memory is
+  allocated from the upstream resource.
+  */
+class HugePageMemoryResource : public zisc::pmr::memory_resource,
+                               private zisc::NonCopyable<HugePageMemoryResource>
+{
+ public:
+  //! Create a memory resource
+  HugePageMemoryResource(const CpuHugePagePolicy policy,
+                         const std::size_t threshold,
+                         zisc::pmr::memory_resource* upstream) noexcept;
+
+  //! Unmap the remaining memory
+  ~HugePageMemoryResource() noexcept override;
+
+
+  //! Return the size of a huge page
+  static constexpr std::size_t hugePageSize() noexcept;
+
+  //! Check whether the memory is mapped by the resource
+  bool isMapped(const void* data) const noexcept;
+
+  //! Return the number of the mapped memory blocks
+  std::size_t numOfMappedBlocks() const noexcept;
+
+  //! Return the huge page policy
+  CpuHugePagePolicy policy() const noexcept;
+
+  //! Return the size in bytes from which the memory is mapped
+  std::size_t threshold() const noexcept;
+
+  //! Return the upstream memory resource
+  zisc::pmr::memory_resource* upstream() const noexcept;
+
+ protected:
+  //! Allocate memory
+  void* do_allocate(std::size_t size, std::size_t alignment) override;
+
+  //! Deallocate memory
+  void do_deallocate(void* data,
+                     std::size_t size,
+                     std::size_t alignment) override;
+
+  //! Compare two memory resources
+  bool do_is_equal(const zisc::pmr::memory_resource& other) const noexcept override;
+
+ private:
+  /*!
+    \brief A memory block which is mapped from the OS
+    */
+  struct MappedBlock
+  {
+    void* data_;
+    std::size_t size_;
+  };
+
+
+  //! Map memory which is aligned to the huge page size
+  static void* mapMemory(const CpuHugePagePolicy policy,
+                         const std::size_t size) noexcept;
+
+  //! Unmap memory
+  static void unmapMemory(void* data, const std::size_t size) noexcept;
+
+
+  zisc::pmr::memory_resource* upstream_;
+  zisc::pmr::vector<MappedBlock> block_list_;
+  mutable std::mutex mutex_;
+  std::size_t threshold_;
+  CpuHugePagePolicy policy_;
+};
+
+} // namespace zinvul
+
+#include "huge_page_memory_resource-inl.hpp"
+
+#endif // ZINVUL_HUGE_PAGE_MEMORY_RESOURCE_HPP
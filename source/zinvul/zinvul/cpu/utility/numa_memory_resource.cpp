@@ -0,0 +1,111 @@
+/*!
+  \file numa_memory_resource.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "numa_memory_resource.hpp"
+// Standard C++ library
+#include <cstddef>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "numa_topology.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] topology No description.
+  \param [in] policy No description.
+  \param [in] num_of_workers No description.
+  \param [in] upstream No description.
+  */
+NumaMemoryResource::NumaMemoryResource(const NumaTopology* topology,
+                                       const CpuMemoryPolicy policy,
+                                       const std::size_t num_of_workers,
+                                       zisc::pmr::memory_resource* upstream)
+    noexcept :
+        topology_{topology},
+        upstream_{upstream},
+        num_of_workers_{num_of_workers},
+        policy_{policy}
+{
+  ZISC_ASSERT(topology_ != nullptr, "The topology is null.");
+  ZISC_ASSERT(upstream_ != nullptr, "The upstream resource is null.");
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+CpuMemoryPolicy NumaMemoryResource::policy() const noexcept
+{
+  return policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+zisc::pmr::memory_resource* NumaMemoryResource::upstream() const noexcept
+{
+  return upstream_;
+}
+
+/*!
+  \details The policy is applied on every allocation, so the memory which
+  a growing buffer reallocates is placed in the same way
+
+  \param [in] size No description.
+  \param [in] alignment No description.
+  \return No description
+  */
+void* NumaMemoryResource::do_allocate(std::size_t size, std::size_t alignment)
+{
+  void* data = upstream_->allocate(size, alignment);
+  topology_->setMemoryPolicy(data, size, policy_, num_of_workers_);
+  return data;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] data No description.
+  \param [in] size No description.
+  \param [in] alignment No description.
+  */
+void NumaMemoryResource::do_deallocate(void* data,
+                                       std::size_t size,
+                                       std::size_t alignment)
+{
+  upstream_->deallocate(data, size, alignment);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] other No description.
+  \return No description
+  */
+bool NumaMemoryResource::do_is_equal(
+    const zisc::pmr::memory_resource& other) const noexcept
+{
+  const bool result = this == &other;
+  return result;
+}
+
+} // namespace zinvul
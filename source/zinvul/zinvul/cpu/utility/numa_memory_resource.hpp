@@ -0,0 +1,76 @@
+/*!
+  \file numa_memory_resource.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_NUMA_MEMORY_RESOURCE_HPP
+#define ZINVUL_NUMA_MEMORY_RESOURCE_HPP
+
+// Standard C++ library
+#include <cstddef>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+class NumaTopology;
+
+/*!
+  \brief A memory resource which places the allocated pages on NUMA nodes
+
+  The memory is allocated from the upstream resource and then the memory
+  policy is applied to the pages before they are touched. Small allocations
+  which don't have a whole page are passed through.
+  */
+class NumaMemoryResource : public zisc::pmr::memory_resource,
+                           private zisc::NonCopyable<NumaMemoryResource>
+{
+ public:
+  //! Create a memory resource
+  NumaMemoryResource(const NumaTopology* topology,
+                     const CpuMemoryPolicy policy,
+                     const std::size_t num_of_workers,
+                     zisc::pmr::memory_resource* upstream) noexcept;
+
+
+  //! Return the memory policy
+  CpuMemoryPolicy policy() const noexcept;
+
+  //! Return the upstream memory resource
+  zisc::pmr::memory_resource* upstream() const noexcept;
+
+ protected:
+  //! Allocate memory and apply the memory policy to it
+  void* do_allocate(std::size_t size, std::size_t alignment) override;
+
+  //! Deallocate memory
+  void do_deallocate(void* data,
+                     std::size_t size,
+                     std::size_t alignment) override;
+
+  //! Compare two memory resources
+  bool do_is_equal(const zisc::pmr::memory_resource& other) const noexcept override;
+
+ private:
+  const NumaTopology* topology_;
+  zisc::pmr::memory_resource* upstream_;
+  std::size_t num_of_workers_;
+  CpuMemoryPolicy policy_;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_NUMA_MEMORY_RESOURCE_HPP
@@ -0,0 +1,37 @@
+/*!
+  \file numa_topology-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_NUMA_TOPOLOGY_INL_HPP
+#define ZINVUL_NUMA_TOPOLOGY_INL_HPP
+
+#include "numa_topology.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details The capacity is of the same scale as the cpu_capacity of linux
+
+  \return No description
+  */
+inline
+constexpr uint32b NumaTopology::maxCoreCapacity() noexcept
+{
+  return 1024;
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_NUMA_TOPOLOGY_INL_HPP
@@ -0,0 +1,609 @@
+/*!
+  \file numa_topology.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "numa_topology.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#if defined(Z_LINUX)
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // Z_LINUX
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+NumaTopology::NumaTopology(zisc::pmr::memory_resource* mem_resource) noexcept :
+    node_id_list_{decltype(node_id_list_)::allocator_type{mem_resource}},
+    cpu_list_{decltype(cpu_list_)::allocator_type{mem_resource}},
+    core_list_{decltype(core_list_)::allocator_type{mem_resource}}
+{
+  setSingleNode();
+  setSingleCoreType();
+}
+
+/*!
+  \details The thread is left as it is if the node has no core list
+
+  \param [in] node_index No description.
+  \return True if the thread is bound to the node
+  */
+bool NumaTopology::bindThread(const std::size_t node_index) const noexcept
+{
+  bool result = false;
+#if defined(Z_LINUX)
+  const auto& cpu_list = cpuList(node_index);
+  if (!cpu_list.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const uint32b cpu : cpu_list) {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &cpu_set);
+    }
+    result = ::pthread_setaffinity_np(::pthread_self(),
+                                      sizeof(cpu_set),
+                                      &cpu_set) == 0;
+  }
+#else // Z_LINUX
+  static_cast<void>(node_index);
+#endif // Z_LINUX
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] core_index No description.
+  \return True if the thread is bound to the core
+  */
+bool NumaTopology::bindThreadToCore(const std::size_t core_index) const noexcept
+{
+  bool result = false;
+#if defined(Z_LINUX)
+  const uint32b cpu = coreId(core_index);
+  if (cpu < CPU_SETSIZE) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    result = ::pthread_setaffinity_np(::pthread_self(),
+                                      sizeof(cpu_set),
+                                      &cpu_set) == 0;
+  }
+#else // Z_LINUX
+  static_cast<void>(core_index);
+#endif // Z_LINUX
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] core_index No description.
+  \return No description
+  */
+uint32b NumaTopology::coreCapacity(const std::size_t core_index) const noexcept
+{
+  ZISC_ASSERT(core_index < numOfLogicalCores(),
+              "The core index is out of range: ", core_index);
+  return core_list_[core_index].capacity_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] core_index No description.
+  \return No description
+  */
+uint32b NumaTopology::coreId(const std::size_t core_index) const noexcept
+{
+  ZISC_ASSERT(core_index < numOfLogicalCores(),
+              "The core index is out of range: ", core_index);
+  return core_list_[core_index].id_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] node_index No description.
+  \return No description
+  */
+const zisc::pmr::vector<uint32b>& NumaTopology::cpuList(
+    const std::size_t node_index) const noexcept
+{
+  ZISC_ASSERT(node_index < numOfNodes(),
+              "The node index is out of range: ", node_index);
+  return cpu_list_[node_index];
+}
+
+/*!
+  \details No detailed description
+  */
+void NumaTopology::fetch() noexcept
+{
+  setSingleNode();
+  fetchCores();
+#if defined(Z_LINUX)
+  std::array<char, 4096> buffer;
+  auto nodes = readFile("/sys/devices/system/node/online",
+                        buffer.data(),
+                        buffer.size());
+  if (nodes.empty())
+    return;
+  zisc::pmr::vector<uint32b> node_id_list{node_id_list_.get_allocator()};
+  parseIdList(nodes, &node_id_list);
+  if (node_id_list.size() <= 1)
+    return;
+
+  node_id_list_.clear();
+  cpu_list_.clear();
+  for (const uint32b id : node_id_list) {
+    std::array<char, 64> path;
+    std::snprintf(path.data(),
+                  path.size(),
+                  "/sys/devices/system/node/node%u/cpulist",
+                  id);
+    auto cpus = readFile(path.data(), buffer.data(), buffer.size());
+    zisc::pmr::vector<uint32b> cpu_list{cpu_list_.get_allocator()};
+    parseIdList(cpus, &cpu_list);
+    // A node without cores only provides memory
+    node_id_list_.emplace_back(id);
+    cpu_list_.emplace_back(std::move(cpu_list));
+  }
+#endif // Z_LINUX
+}
+
+/*!
+  \details The workers are placed on the cores in the order of the cores, so
+  the first workers run on the fastest physical cores
+
+  \param [in] worker_index No description.
+  \return No description
+  */
+std::size_t NumaTopology::getWorkerCore(const std::size_t worker_index) const noexcept
+{
+  const std::size_t core_index = worker_index % numOfLogicalCores();
+  return core_index;
+}
+
+/*!
+  \details The workers are split into contiguous ranges of the same size
+  for each node, as the task batches are split into the worker queues
+
+  \param [in] worker_index No description.
+  \param [in] num_of_workers No description.
+  \return No description
+  */
+std::size_t NumaTopology::getWorkerNode(
+    const std::size_t worker_index,
+    const std::size_t num_of_workers) const noexcept
+{
+  ZISC_ASSERT(worker_index < num_of_workers,
+              "The worker index is out of range: ", worker_index);
+  const std::size_t node_index = (worker_index * numOfNodes()) / num_of_workers;
+  return node_index;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool NumaTopology::isHybrid() const noexcept
+{
+  const bool result = num_of_performance_cores_ < num_of_physical_cores_;
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool NumaTopology::isNuma() const noexcept
+{
+  const bool result = 1 < numOfNodes();
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool NumaTopology::isSmt() const noexcept
+{
+  const bool result = num_of_physical_cores_ < numOfLogicalCores();
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] node_index No description.
+  \return No description
+  */
+uint32b NumaTopology::nodeId(const std::size_t node_index) const noexcept
+{
+  ZISC_ASSERT(node_index < numOfNodes(),
+              "The node index is out of range: ", node_index);
+  return node_id_list_[node_index];
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t NumaTopology::numOfLogicalCores() const noexcept
+{
+  return core_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t NumaTopology::numOfNodes() const noexcept
+{
+  return node_id_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t NumaTopology::numOfPerformanceCores() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_performance_cores_);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t NumaTopology::numOfPhysicalCores() const noexcept
+{
+  return zisc::cast<std::size_t>(num_of_physical_cores_);
+}
+
+/*!
+  \details Invalid characters terminate the parsing
+
+  \param [in] list No description.
+  \param [out] id_list No description.
+  */
+void NumaTopology::parseIdList(const std::string_view list,
+                               zisc::pmr::vector<uint32b>* id_list) noexcept
+{
+  const auto is_digit = [](const char c) noexcept
+  {
+    return ('0' <= c) && (c <= '9');
+  };
+  const auto read_number = [&list, &is_digit](std::size_t* i) noexcept
+  {
+    uint32b n = 0;
+    for (; (*i < list.size()) && is_digit(list[*i]); ++(*i))
+      n = 10 * n + zisc::cast<uint32b>(list[*i] - '0');
+    return n;
+  };
+
+  for (std::size_t i = 0; (i < list.size()) && is_digit(list[i]);) {
+    const uint32b begin = read_number(&i);
+    uint32b end = begin;
+    if ((i < list.size()) && (list[i] == '-')) {
+      ++i;
+      if ((list.size() <= i) || !is_digit(list[i]))
+        break;
+      end = read_number(&i);
+    }
+    for (uint32b id = begin; id <= end; ++id)
+      id_list->emplace_back(id);
+    if ((i < list.size()) && (list[i] == ','))
+      ++i;
+  }
+}
+
+/*!
+  \details The worker-local policy places the n-th range of the memory on
+  the node of the n-th worker. Only the pages which are entirely in the
+  memory are changed. Nothing is done on a single node system
+
+  \param [in,out] data No description.
+  \param [in] size No description.
+  \param [in] policy No description.
+  \param [in] num_of_workers No description.
+  \return True if the policy is applied
+  */
+bool NumaTopology::setMemoryPolicy(void* data,
+                                   const std::size_t size,
+                                   const CpuMemoryPolicy policy,
+                                   const std::size_t num_of_workers) const noexcept
+{
+  bool result = false;
+#if defined(Z_LINUX)
+  if (!isNuma() || (data == nullptr) || (size == 0))
+    return result;
+  switch (policy) {
+   case CpuMemoryPolicy::kInterleave: {
+    result = bindMemory(data, size, MPOL_INTERLEAVE, 0, numOfNodes());
+    break;
+   }
+   case CpuMemoryPolicy::kWorkerLocal: {
+    auto address = zisc::cast<uint8b*>(data);
+    result = 0 < num_of_workers;
+    for (std::size_t begin = 0; begin < num_of_workers;) {
+      // Merge the workers which are on the same node
+      const std::size_t node_index = getWorkerNode(begin, num_of_workers);
+      std::size_t end = begin + 1;
+      while ((end < num_of_workers) &&
+             (getWorkerNode(end, num_of_workers) == node_index))
+        ++end;
+      const std::size_t offset = (size * begin) / num_of_workers;
+      const std::size_t s = (size * end) / num_of_workers - offset;
+      result = bindMemory(address + offset,
+                          s,
+                          MPOL_PREFERRED,
+                          node_index,
+                          node_index + 1) && result;
+      begin = end;
+    }
+    break;
+   }
+   case CpuMemoryPolicy::kFirstTouch:
+   default: {
+    break;
+   }
+  }
+#else // Z_LINUX
+  static_cast<void>(data);
+  static_cast<void>(size);
+  static_cast<void>(policy);
+  static_cast<void>(num_of_workers);
+#endif // Z_LINUX
+  return result;
+}
+
+/*!
+  \details mbind is called directly so that zinvul doesn't depend on libnuma
+
+  \param [in,out] data No description.
+  \param [in] size No description.
+  \param [in] mode No description.
+  \param [in] node_begin No description.
+  \param [in] node_end No description.
+  \return No description
+  */
+bool NumaTopology::bindMemory(void* data,
+                              const std::size_t size,
+                              const int mode,
+                              const std::size_t node_begin,
+                              const std::size_t node_end) const noexcept
+{
+  bool result = false;
+#if defined(Z_LINUX)
+  const auto page_size = zisc::cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const auto address = reinterpret_cast<std::uintptr_t>(data);
+  const std::uintptr_t begin = ((address + page_size - 1) / page_size) * page_size;
+  const std::uintptr_t end = ((address + size) / page_size) * page_size;
+  if (end <= begin)
+    return result;
+
+  constexpr std::size_t kNumOfBits = 8 * sizeof(unsigned long);
+  std::array<unsigned long, 1024 / kNumOfBits> node_mask;
+  node_mask.fill(0);
+  for (std::size_t i = node_begin; i < node_end; ++i) {
+    const uint32b id = nodeId(i);
+    if (id < kNumOfBits * node_mask.size())
+      node_mask[id / kNumOfBits] |= 1ul << (id % kNumOfBits);
+  }
+  const long r = ::syscall(SYS_mbind,
+                           reinterpret_cast<void*>(begin),
+                           zisc::cast<unsigned long>(end - begin),
+                           mode,
+                           node_mask.data(),
+                           zisc::cast<unsigned long>(kNumOfBits * node_mask.size()),
+                           zisc::cast<unsigned>(MPOL_MF_MOVE));
+  result = r == 0;
+#else // Z_LINUX
+  static_cast<void>(data);
+  static_cast<void>(size);
+  static_cast<void>(mode);
+  static_cast<void>(node_begin);
+  static_cast<void>(node_end);
+#endif // Z_LINUX
+  return result;
+}
+
+/*!
+  \details A physical core is identified by the smallest id of its SMT
+  siblings. The performance of a core is read from cpu_capacity, which is
+  provided on hybrid hosts, or the max frequency of the core otherwise
+  */
+void NumaTopology::fetchCores() noexcept
+{
+  setSingleCoreType();
+#if defined(Z_LINUX)
+  std::array<char, 4096> buffer;
+  auto cpus = readFile("/sys/devices/system/cpu/online",
+                       buffer.data(),
+                       buffer.size());
+  zisc::pmr::vector<uint32b> id_list{node_id_list_.get_allocator()};
+  parseIdList(cpus, &id_list);
+  if (id_list.empty())
+    return;
+
+  zisc::pmr::vector<Core> core_list{core_list_.get_allocator()};
+  zisc::pmr::vector<uint64b> performance_list{core_list_.get_allocator()};
+  zisc::pmr::vector<uint32b> sibling_list{node_id_list_.get_allocator()};
+  core_list.reserve(id_list.size());
+  performance_list.reserve(id_list.size());
+  for (const uint32b id : id_list) {
+    std::array<char, 96> path;
+    Core core;
+    core.id_ = id;
+    core.physical_id_ = id;
+    std::snprintf(path.data(),
+                  path.size(),
+                  "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list",
+                  id);
+    auto siblings = readFile(path.data(), buffer.data(), buffer.size());
+    sibling_list.clear();
+    parseIdList(siblings, &sibling_list);
+    if (!sibling_list.empty())
+      core.physical_id_ = *std::min_element(sibling_list.begin(), sibling_list.end());
+    std::snprintf(path.data(),
+                  path.size(),
+                  "/sys/devices/system/cpu/cpu%u/cpu_capacity",
+                  id);
+    uint64b performance = readNumber(path.data());
+    if (performance == 0) {
+      std::snprintf(path.data(),
+                    path.size(),
+                    "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq",
+                    id);
+      performance = readNumber(path.data());
+    }
+    core_list.emplace_back(core);
+    performance_list.emplace_back(performance);
+  }
+
+  // Scale the performance so that the fastest cores have the max capacity
+  const uint64b max_performance = *std::max_element(performance_list.begin(),
+                                                    performance_list.end());
+  for (std::size_t i = 0; (0 < max_performance) && (i < core_list.size()); ++i) {
+    const uint64b performance = (0 < performance_list[i])
+        ? performance_list[i]
+        : max_performance;
+    const uint64b capacity = (maxCoreCapacity() * performance) / max_performance;
+    core_list[i].capacity_ = zisc::cast<uint32b>(std::max(capacity, uint64b{1}));
+  }
+
+  // The physical cores from the fastest, and then their SMT siblings
+  const auto key = [](const Core& core) noexcept
+  {
+    return std::make_tuple(core.id_ != core.physical_id_,
+                           maxCoreCapacity() - core.capacity_,
+                           core.id_);
+  };
+  std::sort(core_list.begin(),
+            core_list.end(),
+            [&key](const Core& lhs, const Core& rhs) noexcept
+            {
+              return key(lhs) < key(rhs);
+            });
+  num_of_physical_cores_ = 0;
+  num_of_performance_cores_ = 0;
+  for (const auto& core : core_list) {
+    if (core.id_ == core.physical_id_) {
+      ++num_of_physical_cores_;
+      if (core.capacity_ == maxCoreCapacity())
+        ++num_of_performance_cores_;
+    }
+  }
+  core_list_ = std::move(core_list);
+#endif // Z_LINUX
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] path No description.
+  \return The number. 0 if the file can't be read
+  */
+uint64b NumaTopology::readNumber(const char* path) noexcept
+{
+  std::array<char, 64> buffer;
+  const auto text = readFile(path, buffer.data(), buffer.size());
+  const uint64b number = text.empty()
+      ? 0
+      : zisc::cast<uint64b>(std::strtoull(buffer.data(), nullptr, 10));
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] path No description.
+  \param [out] buffer No description.
+  \param [in] buffer_size No description.
+  \return The contents of the file. Empty if the file can't be read
+  */
+std::string_view NumaTopology::readFile(const char* path,
+                                        char* buffer,
+                                        const std::size_t buffer_size) noexcept
+{
+  std::size_t size = 0;
+  std::FILE* file = std::fopen(path, "r");
+  if (file != nullptr) {
+    size = std::fread(buffer, 1, buffer_size - 1, file);
+    std::fclose(file);
+  }
+  buffer[size] = '\0';
+  return std::string_view{buffer, size};
+}
+
+/*!
+  \details Each logical core is treated as a physical core
+  */
+void NumaTopology::setSingleCoreType() noexcept
+{
+  core_list_.clear();
+  const uint32b num_of_cores = std::max(std::thread::hardware_concurrency(), 1u);
+  for (uint32b id = 0; id < num_of_cores; ++id) {
+    Core core;
+    core.id_ = id;
+    core.physical_id_ = id;
+    core_list_.emplace_back(core);
+  }
+  num_of_physical_cores_ = num_of_cores;
+  num_of_performance_cores_ = num_of_cores;
+}
+
+/*!
+  \details No detailed description
+  */
+void NumaTopology::setSingleNode() noexcept
+{
+  node_id_list_.clear();
+  cpu_list_.clear();
+  node_id_list_.emplace_back(0);
+  cpu_list_.emplace_back(zisc::pmr::vector<uint32b>{cpu_list_.get_allocator()});
+}
+
+} // namespace zinvul
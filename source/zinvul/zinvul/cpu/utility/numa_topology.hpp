@@ -0,0 +1,159 @@
+/*!
+  \file numa_topology.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_NUMA_TOPOLOGY_HPP
+#define ZINVUL_NUMA_TOPOLOGY_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <string_view>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief The NUMA nodes of the host and the logical cores which belong to them
+
+  The topology is read from sysfs on linux. The other systems are treated as
+  a single node which has all cores. The worker threads of a cpu device are
+  assigned to the nodes in proportion to the number of workers, so that
+  the n-th worker and the n-th range of a buffer are placed on the same node.
+
+  The logical cores are also sorted in the order in which workers are
+  placed on them: the physical cores from the fastest, and then their SMT
+  siblings. The capacity of a core is the relative performance of the core
+  on a hybrid host, where the fastest cores have 1024.
+  */
+class NumaTopology : private zisc::NonCopyable<NumaTopology>
+{
+ public:
+  //! Create a topology of a single node
+  NumaTopology(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+
+  //! Bind the current thread to the cores of the given node
+  bool bindThread(const std::size_t node_index) const noexcept;
+
+  //! Bind the current thread to the logical core of the given order
+  bool bindThreadToCore(const std::size_t core_index) const noexcept;
+
+  //! Return the capacity of the logical core of the given order
+  uint32b coreCapacity(const std::size_t core_index) const noexcept;
+
+  //! Return the system id of the logical core of the given order
+  uint32b coreId(const std::size_t core_index) const noexcept;
+
+  //! Return the max capacity of a core
+  static constexpr uint32b maxCoreCapacity() noexcept;
+
+  //! Return the logical core list of the given node
+  const zisc::pmr::vector<uint32b>& cpuList(const std::size_t node_index) const noexcept;
+
+  //! Read the topology of the host
+  void fetch() noexcept;
+
+  //! Return the order index of the logical core of the given worker
+  std::size_t getWorkerCore(const std::size_t worker_index) const noexcept;
+
+  //! Return the node index of the given worker
+  std::size_t getWorkerNode(const std::size_t worker_index,
+                            const std::size_t num_of_workers) const noexcept;
+
+  //! Check if the host has cores of different performance
+  bool isHybrid() const noexcept;
+
+  //! Check if the host has multiple nodes
+  bool isNuma() const noexcept;
+
+  //! Check if the physical cores run multiple logical cores
+  bool isSmt() const noexcept;
+
+  //! Return the system node id of the given node
+  uint32b nodeId(const std::size_t node_index) const noexcept;
+
+  //! Return the number of logical cores
+  std::size_t numOfLogicalCores() const noexcept;
+
+  //! Return the number of nodes
+  std::size_t numOfNodes() const noexcept;
+
+  //! Return the number of the fastest physical cores
+  std::size_t numOfPerformanceCores() const noexcept;
+
+  //! Return the number of physical cores
+  std::size_t numOfPhysicalCores() const noexcept;
+
+  //! Parse a list of ids such as "0-3,8,10-11"
+  static void parseIdList(const std::string_view list,
+                          zisc::pmr::vector<uint32b>* id_list) noexcept;
+
+  //! Apply the memory policy to the pages of the given memory
+  bool setMemoryPolicy(void* data,
+                       const std::size_t size,
+                       const CpuMemoryPolicy policy,
+                       const std::size_t num_of_workers) const noexcept;
+
+ private:
+  /*!
+    \brief A logical core of the host
+    */
+  struct Core
+  {
+    uint32b id_ = 0;
+    uint32b physical_id_ = 0; //!< The smallest id of the SMT siblings
+    uint32b capacity_ = maxCoreCapacity();
+  };
+
+
+  //! Apply a memory policy of the given nodes to the pages in the range
+  bool bindMemory(void* data,
+                  const std::size_t size,
+                  const int mode,
+                  const std::size_t node_begin,
+                  const std::size_t node_end) const noexcept;
+
+  //! Read the logical cores of the host
+  void fetchCores() noexcept;
+
+  //! Read an unsigned number from a small text file
+  static uint64b readNumber(const char* path) noexcept;
+
+  //! Read a small text file into the given buffer
+  static std::string_view readFile(const char* path,
+                                   char* buffer,
+                                   const std::size_t buffer_size) noexcept;
+
+  //! Reset the cores to the logical cores of the same performance
+  void setSingleCoreType() noexcept;
+
+  //! Reset the topology to a single node
+  void setSingleNode() noexcept;
+
+
+  zisc::pmr::vector<uint32b> node_id_list_;
+  zisc::pmr::vector<zisc::pmr::vector<uint32b>> cpu_list_;
+  zisc::pmr::vector<Core> core_list_;
+  uint32b num_of_physical_cores_ = 0;
+  uint32b num_of_performance_cores_ = 0;
+};
+
+} // namespace zinvul
+
+#include "numa_topology-inl.hpp"
+
+#endif // ZINVUL_NUMA_TOPOLOGY_HPP
@@ -0,0 +1,130 @@
+/*!
+  \file task_batch_tuner.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "task_batch_tuner.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] initial_batch_size No description.
+  \param [in] max_batch_size No description.
+  \param [in] target_time No description.
+  \param [in] mem_resource No description.
+  */
+TaskBatchTuner::TaskBatchTuner(const uint32b initial_batch_size,
+                               const uint32b max_batch_size,
+                               const uint64b target_time,
+                               zisc::pmr::memory_resource* mem_resource)
+    noexcept :
+        batch_size_list_{decltype(batch_size_list_)::allocator_type{mem_resource}},
+        target_time_{std::max(target_time, uint64b{1})},
+        initial_batch_size_{initial_batch_size},
+        max_batch_size_{max_batch_size}
+{
+  ZISC_ASSERT(0 < initial_batch_size_, "The initial batch size is zero.");
+  ZISC_ASSERT(initial_batch_size_ <= max_batch_size_,
+              "The initial batch size exceeds the max: ", initial_batch_size_);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] kernel_id No description.
+  \return No description
+  */
+uint32b TaskBatchTuner::batchSize(const void* kernel_id) const noexcept
+{
+  uint32b batch_size = initialBatchSize();
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    const auto p = batch_size_list_.find(kernel_id);
+    if (p != batch_size_list_.end())
+      batch_size = p->second;
+  }
+  return batch_size;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint32b TaskBatchTuner::initialBatchSize() const noexcept
+{
+  return initial_batch_size_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint32b TaskBatchTuner::maxBatchSize() const noexcept
+{
+  return max_batch_size_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint64b TaskBatchTuner::targetTime() const noexcept
+{
+  return target_time_;
+}
+
+/*!
+  \details The new size is the geometric mean of the current size and the
+  size which would take the target time. It converges in a few launches
+  and a single noisy measurement doesn't move it far
+
+  \param [in] kernel_id No description.
+  \param [in] num_of_groups The number of work-groups which are measured.
+  \param [in] elapsed_time The total time of the groups in nanoseconds.
+  */
+void TaskBatchTuner::update(const void* kernel_id,
+                            const uint64b num_of_groups,
+                            const uint64b elapsed_time) noexcept
+{
+  if (num_of_groups == 0)
+    return;
+  const double group_time = std::max(zisc::cast<double>(elapsed_time), 1.0) /
+                            zisc::cast<double>(num_of_groups);
+  const double ideal_size = zisc::cast<double>(targetTime()) / group_time;
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto p = batch_size_list_.find(kernel_id);
+  if (p == batch_size_list_.end())
+    p = batch_size_list_.emplace(kernel_id, initialBatchSize()).first;
+  const double current_size = zisc::cast<double>(p->second);
+  const double size = std::sqrt(current_size * ideal_size);
+  const double max_size = zisc::cast<double>(maxBatchSize());
+  p->second = zisc::cast<uint32b>(std::clamp(std::round(size), 1.0, max_size));
+}
+
+} // namespace zinvul
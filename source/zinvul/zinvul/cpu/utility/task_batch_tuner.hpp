@@ -0,0 +1,74 @@
+/*!
+  \file task_batch_tuner.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_TASK_BATCH_TUNER_HPP
+#define ZINVUL_TASK_BATCH_TUNER_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <mutex>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief Learn the task batch size of each kernel from the execution time
+
+  A task batch is the unit of work-groups which a worker thread takes from
+  the queues at once. The tuner keeps a batch size per kernel and moves it
+  toward the size which takes the target time, so that small kernels aren't
+  dominated by the scheduling overhead and heavy kernels are balanced well.
+  */
+class TaskBatchTuner : private zisc::NonCopyable<TaskBatchTuner>
+{
+ public:
+  //! Create a tuner
+  TaskBatchTuner(const uint32b initial_batch_size,
+                 const uint32b max_batch_size,
+                 const uint64b target_time,
+                 zisc::pmr::memory_resource* mem_resource) noexcept;
+
+
+  //! Return the learned batch size of the given kernel
+  uint32b batchSize(const void* kernel_id) const noexcept;
+
+  //! Return the initial batch size of kernels
+  uint32b initialBatchSize() const noexcept;
+
+  //! Return the maximum batch size
+  uint32b maxBatchSize() const noexcept;
+
+  //! Return the target execution time of a batch in nanoseconds
+  uint64b targetTime() const noexcept;
+
+  //! Update the batch size of the given kernel with a measured time
+  void update(const void* kernel_id,
+              const uint64b num_of_groups,
+              const uint64b elapsed_time) noexcept;
+
+ private:
+  mutable std::mutex mutex_;
+  zisc::pmr::map<const void*, uint32b> batch_size_list_;
+  uint64b target_time_;
+  uint32b initial_batch_size_;
+  uint32b max_batch_size_;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_TASK_BATCH_TUNER_HPP
@@ -0,0 +1,53 @@
+/*!
+  \file work_group_scheduler-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_WORK_GROUP_SCHEDULER_INL_HPP
+#define ZINVUL_WORK_GROUP_SCHEDULER_INL_HPP
+
+#include "work_group_scheduler.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <limits>
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr std::size_t WorkGroupScheduler::stackSize() noexcept
+{
+  const std::size_t size = 128 * 1024;
+  return size;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b WorkGroupScheduler::invalidIndex() noexcept
+{
+  const uint32b index = (std::numeric_limits<uint32b>::max)();
+  return index;
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_WORK_GROUP_SCHEDULER_INL_HPP
@@ -0,0 +1,181 @@
+/*!
+  \file work_group_scheduler.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "work_group_scheduler.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <memory>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "fiber.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/cppcl/utility.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+WorkGroupScheduler::WorkGroupScheduler(zisc::pmr::memory_resource* mem_resource)
+    noexcept :
+        thread_fiber_{mem_resource},
+        fiber_list_{decltype(fiber_list_)::allocator_type{mem_resource}},
+        finished_list_{decltype(finished_list_)::allocator_type{mem_resource}},
+        local_memory_{decltype(local_memory_)::allocator_type{mem_resource}}
+{
+}
+
+/*!
+  \details No detailed description
+  */
+WorkGroupScheduler::~WorkGroupScheduler() noexcept
+{
+  // The fibers are suspended in their loop and never resumed
+  fiber_list_.clear();
+}
+
+/*!
+  \details The local memory isn't cleared for each work-group,
+  as with OpenCL the contents are undefined at the beginning of a group
+
+  \param [in] size No description.
+  \return No description
+  */
+void* WorkGroupScheduler::prepareLocalMemory(const std::size_t size) noexcept
+{
+  constexpr std::size_t block_size = sizeof(LocalMemoryBlock);
+  const std::size_t num_of_blocks = (size + block_size - 1) / block_size;
+  if (local_memory_.size() < num_of_blocks)
+    local_memory_.resize(num_of_blocks);
+  void* memory = (0 < size) ? zisc::cast<void*>(local_memory_.data()) : nullptr;
+  return memory;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] command No description.
+  \param [in] group_size No description.
+  */
+void WorkGroupScheduler::run(const Command& command,
+                             const uint32b group_size) noexcept
+{
+  using cl::inner::WorkGroup;
+
+  command_ = std::addressof(command);
+  num_of_finished_ = 0;
+  barrier_reached_ = false;
+  finished_list_.assign(group_size, 0);
+  thread_fiber_.bindThread();
+  WorkGroup::setBarrierCallback(&WorkGroupScheduler::barrier, this);
+
+  // Run the first work-item in order to check if the kernel has barriers
+  prepareFibers(1);
+  resume(0);
+  if (!barrier_reached_) {
+    for (uint32b index = 1; index < group_size; ++index) {
+      WorkGroup::setLocalWorkId(index);
+      command();
+    }
+  }
+  else {
+    prepareFibers(group_size);
+    // Make the rest of the work-items reach the first barrier
+    for (uint32b index = 1; index < group_size; ++index)
+      resume(index);
+    while (num_of_finished_ < group_size) {
+      for (uint32b index = 0; index < group_size; ++index) {
+        if (finished_list_[index] == 0)
+          resume(index);
+      }
+    }
+  }
+
+  WorkGroup::setBarrierCallback(nullptr, nullptr);
+  thread_fiber_.unbindThread();
+  command_ = nullptr;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in,out] scheduler No description.
+  */
+void WorkGroupScheduler::barrier(void* scheduler) noexcept
+{
+  auto s = zisc::cast<WorkGroupScheduler*>(scheduler);
+  const uint32b index = s->current_index_;
+  // The work-items which run on the thread directly don't need to wait
+  if (index != invalidIndex()) {
+    s->barrier_reached_ = true;
+    s->current_index_ = invalidIndex();
+    s->thread_fiber_.switchFrom(s->fiber_list_[index].get());
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in,out] scheduler No description.
+  */
+void WorkGroupScheduler::execFiber(void* scheduler) noexcept
+{
+  auto s = zisc::cast<WorkGroupScheduler*>(scheduler);
+  while (true) {
+    (*s->command_)();
+    const uint32b index = s->current_index_;
+    s->finished_list_[index] = 1;
+    ++s->num_of_finished_;
+    s->current_index_ = invalidIndex();
+    s->thread_fiber_.switchFrom(s->fiber_list_[index].get());
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] num_of_fibers No description.
+  */
+void WorkGroupScheduler::prepareFibers(const uint32b num_of_fibers) noexcept
+{
+  auto mem_resource = fiber_list_.get_allocator().resource();
+  for (std::size_t i = fiber_list_.size(); i < num_of_fibers; ++i) {
+    zisc::pmr::polymorphic_allocator<Fiber> alloc{mem_resource};
+    auto fiber = zisc::pmr::allocateUnique(alloc,
+                                           &WorkGroupScheduler::execFiber,
+                                           zisc::cast<void*>(this),
+                                           stackSize(),
+                                           mem_resource);
+    fiber_list_.emplace_back(std::move(fiber));
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] index No description.
+  */
+void WorkGroupScheduler::resume(const uint32b index) noexcept
+{
+  cl::inner::WorkGroup::setLocalWorkId(index);
+  current_index_ = index;
+  fiber_list_[index]->switchFrom(std::addressof(thread_fiber_));
+}
+
+} // namespace zinvul
@@ -0,0 +1,104 @@
+/*!
+  \file work_group_scheduler.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_WORK_GROUP_SCHEDULER_HPP
+#define ZINVUL_WORK_GROUP_SCHEDULER_HPP
+
+// Standard C++ library
+#include <cstddef>
+#include <limits>
+// Zisc
+#include "zisc/function_reference.hpp"
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "fiber.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief Run the work-items of a work-group on a thread
+
+  Each work-item of a group runs on a fiber and the fibers are switched at
+  each barrier, so that all work-items reach a barrier before any of them
+  proceeds. The first work-item of a group detects whether the kernel has
+  barriers. If it finishes without reaching a barrier, the rest of the
+  work-items are run directly on the thread without switching.
+  The scheduler must be used by only one thread.
+  */
+class WorkGroupScheduler : private zisc::NonCopyable<WorkGroupScheduler>
+{
+ public:
+  // Type aliases
+  using Command = zisc::FunctionReference<void ()>;
+
+
+  //! Create a scheduler
+  WorkGroupScheduler(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+  //! Destroy the scheduler
+  ~WorkGroupScheduler() noexcept;
+
+
+  //! Return the local memory of the thread which has at least the given size
+  void* prepareLocalMemory(const std::size_t size) noexcept;
+
+  //! Run all work-items of a work-group
+  void run(const Command& command, const uint32b group_size) noexcept;
+
+  //! Return the stack size of a fiber in bytes
+  static constexpr std::size_t stackSize() noexcept;
+
+ private:
+  /*!
+    \brief A memory block of the local memory
+    */
+  struct alignas(64) LocalMemoryBlock
+  {
+    uint8b data_[64];
+  };
+
+
+  //! Yield the execution of the current work-item at a barrier
+  static void barrier(void* scheduler) noexcept;
+
+  //! Process work-items on a fiber
+  static void execFiber(void* scheduler) noexcept;
+
+  //! Return the index which represents no fiber is running
+  static constexpr uint32b invalidIndex() noexcept;
+
+  //! Make fibers as many as the given number
+  void prepareFibers(const uint32b num_of_fibers) noexcept;
+
+  //! Resume the work-item of the given index
+  void resume(const uint32b index) noexcept;
+
+
+  Fiber thread_fiber_;
+  zisc::pmr::vector<zisc::pmr::unique_ptr<Fiber>> fiber_list_;
+  zisc::pmr::vector<uint8b> finished_list_;
+  zisc::pmr::vector<LocalMemoryBlock> local_memory_;
+  const Command* command_ = nullptr;
+  uint32b current_index_ = invalidIndex();
+  uint32b num_of_finished_ = 0;
+  bool barrier_reached_ = false;
+};
+
+} // namespace zinvul
+
+#include "work_group_scheduler-inl.hpp"
+
+#endif // ZINVUL_WORK_GROUP_SCHEDULER_HPP
@@ -0,0 +1,120 @@
+/*!
+  \file work_layout-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_WORK_LAYOUT_INL_HPP
+#define ZINVUL_WORK_LAYOUT_INL_HPP
+
+#include "work_layout.hpp"
+// Standard C++ library
+#include <array>
+#include <cstddef>
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+  */
+inline
+WorkLayout::WorkLayout() noexcept :
+    global_offset_{{0, 0, 0}},
+    tile_size_{{1, 1, 1}},
+    order_{TraversalOrder::kRowMajor}
+{
+}
+
+/*!
+  \details The tile size of the missing dimensions is 1
+
+  \tparam kDimension No description.
+  \param [in] order No description.
+  \param [in] tile_size No description.
+  */
+template <std::size_t kDimension> inline
+WorkLayout::WorkLayout(const TraversalOrder order,
+                       const std::array<uint32b, kDimension>& tile_size) noexcept :
+    global_offset_{{0, 0, 0}},
+    tile_size_{{1, 1, 1}},
+    order_{order}
+{
+  static_assert(kDimension <= 3, "The dimension is greater than 3.");
+  for (std::size_t i = 0; i < kDimension; ++i)
+    tile_size_[i] = tile_size[i];
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const std::array<uint32b, 3>& WorkLayout::globalOffset() const noexcept
+{
+  return global_offset_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool WorkLayout::isRowMajor() const noexcept
+{
+  const bool result = order_ == TraversalOrder::kRowMajor;
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+TraversalOrder WorkLayout::order() const noexcept
+{
+  return order_;
+}
+
+/*!
+  \details The offset of the missing dimensions is 0
+
+  \tparam kDimension No description.
+  \param [in] global_offset No description.
+  */
+template <std::size_t kDimension> inline
+void WorkLayout::setGlobalOffset(
+    const std::array<uint32b, kDimension>& global_offset) noexcept
+{
+  static_assert(kDimension <= 3, "The dimension is greater than 3.");
+  global_offset_ = {{0, 0, 0}};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    global_offset_[i] = global_offset[i];
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const std::array<uint32b, 3>& WorkLayout::tileSize() const noexcept
+{
+  return tile_size_;
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_WORK_LAYOUT_INL_HPP
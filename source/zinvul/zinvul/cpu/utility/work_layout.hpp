@@ -0,0 +1,70 @@
+/*!
+  \file work_layout.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_WORK_LAYOUT_HPP
+#define ZINVUL_WORK_LAYOUT_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief The placement of the work-items of a launch
+
+  The global offset shifts the global ids of the launch, and the traversal
+  order and the tile size decide the order of the work-groups.
+  */
+class WorkLayout
+{
+ public:
+  //! Create a row-major layout without offset
+  WorkLayout() noexcept;
+
+  //! Create a layout with the tile size of the given dimension
+  template <std::size_t kDimension>
+  WorkLayout(const TraversalOrder order,
+             const std::array<uint32b, kDimension>& tile_size) noexcept;
+
+
+  //! Return the global id of the first work-item
+  const std::array<uint32b, 3>& globalOffset() const noexcept;
+
+  //! Check if the work-groups are traversed in row-major order
+  bool isRowMajor() const noexcept;
+
+  //! Return the traversal order
+  TraversalOrder order() const noexcept;
+
+  //! Set the global id of the first work-item
+  template <std::size_t kDimension>
+  void setGlobalOffset(const std::array<uint32b, kDimension>& global_offset) noexcept;
+
+  //! Return the number of work-items of a tile in each dimension
+  const std::array<uint32b, 3>& tileSize() const noexcept;
+
+ private:
+  std::array<uint32b, 3> global_offset_;
+  std::array<uint32b, 3> tile_size_;
+  TraversalOrder order_;
+};
+
+} // namespace zinvul
+
+#include "work_layout-inl.hpp"
+
+#endif // ZINVUL_WORK_LAYOUT_HPP
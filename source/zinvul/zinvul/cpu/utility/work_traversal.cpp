@@ -0,0 +1,218 @@
+/*!
+  \file work_traversal.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "work_traversal.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "work_layout.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details The tile size is rounded up to a multiple of the local work-group
+  size, and clamped to the number of work-groups
+
+  \param [in] work_layout No description.
+  \param [in] num_of_groups No description.
+  \param [in] local_work_size No description.
+  \param [in] mem_resource No description.
+  */
+WorkTraversal::WorkTraversal(const WorkLayout& work_layout,
+                             const std::array<uint32b, 3>& num_of_groups,
+                             const std::array<uint32b, 3>& local_work_size,
+                             zisc::pmr::memory_resource* mem_resource) noexcept :
+    tile_list_{decltype(tile_list_)::allocator_type{mem_resource}},
+    num_of_groups_{num_of_groups},
+    order_{work_layout.order()}
+{
+  const auto& tile_size = work_layout.tileSize();
+  for (std::size_t i = 0; i < tile_size_.size(); ++i) {
+    const uint32b s = std::max(tile_size[i], 1u);
+    const uint32b size = (s + local_work_size[i] - 1) / local_work_size[i];
+    tile_size_[i] = std::min(size, std::max(num_of_groups_[i], 1u));
+    num_of_tiles_[i] = (num_of_groups_[i] + tile_size_[i] - 1) / tile_size_[i];
+  }
+  if ((order_ == TraversalOrder::kMorton) || (order_ == TraversalOrder::kHilbert))
+    sortTiles();
+}
+
+/*!
+  \details The range is empty if the run is out of the work-groups
+
+  \param [in] run_index No description.
+  \param [out] begin No description.
+  \param [out] end No description.
+  */
+void WorkTraversal::getRun(const uint64b run_index,
+                           uint32b* begin,
+                           uint32b* end) const noexcept
+{
+  ZISC_ASSERT(run_index < numOfRuns(), "The run index is out of range: ", run_index);
+  const uint64b runs_per_tile = zisc::cast<uint64b>(tile_size_[1]) * tile_size_[2];
+  const uint64b n = run_index / runs_per_tile;
+  const uint32b row = zisc::cast<uint32b>(run_index % runs_per_tile);
+  const uint32b tile_index = tile_list_.empty() ? zisc::cast<uint32b>(n)
+                                                : tile_list_[n];
+  const uint32b tile_x = tile_index % num_of_tiles_[0];
+  const uint32b tile_y = (tile_index / num_of_tiles_[0]) % num_of_tiles_[1];
+  const uint32b tile_z = tile_index / (num_of_tiles_[0] * num_of_tiles_[1]);
+
+  const uint32b x = tile_x * tile_size_[0];
+  const uint32b y = tile_y * tile_size_[1] + row % tile_size_[1];
+  const uint32b z = tile_z * tile_size_[2] + row / tile_size_[1];
+  *begin = 0;
+  *end = 0;
+  if ((y < num_of_groups_[1]) && (z < num_of_groups_[2])) {
+    *begin = x + num_of_groups_[0] * (y + num_of_groups_[1] * z);
+    *end = *begin + std::min(tile_size_[0], num_of_groups_[0] - x);
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] x No description.
+  \param [in] y No description.
+  \param [in] order No description.
+  \return No description
+  */
+uint64b WorkTraversal::hilbertIndex(const uint32b x,
+                                    const uint32b y,
+                                    const uint32b order) noexcept
+{
+  const uint32b n = 1u << order;
+  uint32b px = x;
+  uint32b py = y;
+  uint64b index = 0;
+  for (uint32b s = n / 2; 0 < s; s /= 2) {
+    const uint32b rx = ((px & s) != 0) ? 1 : 0;
+    const uint32b ry = ((py & s) != 0) ? 1 : 0;
+    index += zisc::cast<uint64b>(s) * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant
+    if (ry == 0) {
+      if (rx == 1) {
+        px = n - 1 - px;
+        py = n - 1 - py;
+      }
+      std::swap(px, py);
+    }
+  }
+  return index;
+}
+
+/*!
+  \details Each coordinate has 21 bits at most
+
+  \param [in] x No description.
+  \param [in] y No description.
+  \param [in] z No description.
+  \return No description
+  */
+uint64b WorkTraversal::mortonCode(const uint32b x,
+                                  const uint32b y,
+                                  const uint32b z) noexcept
+{
+  const auto spread = [](const uint32b value) noexcept
+  {
+    uint64b v = zisc::cast<uint64b>(value) & 0x1f'ffffull;
+    v = (v | (v << 32)) & 0x1f'0000'0000'ffffull;
+    v = (v | (v << 16)) & 0x1f'0000'ff00'00ffull;
+    v = (v | (v << 8)) & 0x100f'00f0'0f00'f00full;
+    v = (v | (v << 4)) & 0x10c3'0c30'c30c'30c3ull;
+    v = (v | (v << 2)) & 0x1249'2492'4924'9249ull;
+    return v;
+  };
+  const uint64b code = spread(x) | (spread(y) << 1) | (spread(z) << 2);
+  return code;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint64b WorkTraversal::numOfRuns() const noexcept
+{
+  const uint64b num_of_tiles = zisc::cast<uint64b>(num_of_tiles_[0]) *
+                               num_of_tiles_[1] *
+                               num_of_tiles_[2];
+  const uint64b runs = num_of_tiles * tile_size_[1] * tile_size_[2];
+  return runs;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint32b WorkTraversal::runLength() const noexcept
+{
+  return tile_size_[0];
+}
+
+/*!
+  \details The Hilbert curve is 2D, so the slices of tiles in z dimension
+  are visited in order
+
+  \param [in] tile_index No description.
+  \return No description
+  */
+uint64b WorkTraversal::getTileKey(const uint32b tile_index) const noexcept
+{
+  const uint32b tile_x = tile_index % num_of_tiles_[0];
+  const uint32b tile_y = (tile_index / num_of_tiles_[0]) % num_of_tiles_[1];
+  const uint32b tile_z = tile_index / (num_of_tiles_[0] * num_of_tiles_[1]);
+  uint64b key = 0;
+  if (order_ == TraversalOrder::kMorton) {
+    key = mortonCode(tile_x, tile_y, tile_z);
+  }
+  else {
+    key = (zisc::cast<uint64b>(tile_z) << (2 * curve_order_)) |
+          hilbertIndex(tile_x, tile_y, curve_order_);
+  }
+  return key;
+}
+
+/*!
+  \details The tiles are sorted by the curve keys, so the curve works on
+  the tiles of any number, not only of a power of 2
+  */
+void WorkTraversal::sortTiles() noexcept
+{
+  const uint32b n = std::max(num_of_tiles_[0], num_of_tiles_[1]);
+  curve_order_ = 0;
+  while ((1u << curve_order_) < n)
+    ++curve_order_;
+
+  const uint32b num_of_tiles = num_of_tiles_[0] * num_of_tiles_[1] * num_of_tiles_[2];
+  tile_list_.resize(num_of_tiles);
+  std::iota(tile_list_.begin(), tile_list_.end(), 0u);
+  std::sort(tile_list_.begin(), tile_list_.end(),
+  [this](const uint32b lhs, const uint32b rhs) noexcept
+  {
+    return getTileKey(lhs) < getTileKey(rhs);
+  });
+}
+
+} // namespace zinvul
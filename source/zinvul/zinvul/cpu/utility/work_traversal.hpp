@@ -0,0 +1,85 @@
+/*!
+  \file work_traversal.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_WORK_TRAVERSAL_HPP
+#define ZINVUL_WORK_TRAVERSAL_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "work_layout.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \brief Map the tiles of work-groups of a launch to a traversal order
+
+  The work-groups are split into tiles. A run is a row of work-groups in
+  x dimension of a tile, so the work-groups in a run have contiguous
+  row-major ids. The runs of a tile are visited in row-major order and
+  the tiles are visited in the order of the curve.
+  */
+class WorkTraversal : private zisc::NonCopyable<WorkTraversal>
+{
+ public:
+  //! Create a traversal of the work-groups
+  WorkTraversal(const WorkLayout& work_layout,
+                const std::array<uint32b, 3>& num_of_groups,
+                const std::array<uint32b, 3>& local_work_size,
+                zisc::pmr::memory_resource* mem_resource) noexcept;
+
+
+  //! Return the range of the row-major work-group ids of the run
+  void getRun(const uint64b run_index, uint32b* begin, uint32b* end) const noexcept;
+
+  //! Return the Hilbert curve index of a point in 2^order x 2^order grid
+  static uint64b hilbertIndex(const uint32b x,
+                              const uint32b y,
+                              const uint32b order) noexcept;
+
+  //! Return the Morton code of a point
+  static uint64b mortonCode(const uint32b x,
+                            const uint32b y,
+                            const uint32b z) noexcept;
+
+  //! Return the number of runs
+  uint64b numOfRuns() const noexcept;
+
+  //! Return the number of work-groups of a run in x dimension at most
+  uint32b runLength() const noexcept;
+
+ private:
+  //! Return the key of the tile in the curve order
+  uint64b getTileKey(const uint32b tile_index) const noexcept;
+
+  //! Sort the tiles in the curve order
+  void sortTiles() noexcept;
+
+
+  zisc::pmr::vector<uint32b> tile_list_;
+  std::array<uint32b, 3> num_of_groups_;
+  std::array<uint32b, 3> tile_size_; //!< The tile size in work-groups
+  std::array<uint32b, 3> num_of_tiles_;
+  TraversalOrder order_;
+  uint32b curve_order_ = 0;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_WORK_TRAVERSAL_HPP
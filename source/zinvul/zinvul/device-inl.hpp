@@ -23,7 +23,9 @@
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
 #include "buffer.hpp"
+#include "fence.hpp"
 #include "zinvul_config.hpp"
+#include "utility/memory_registry.hpp"
 
 namespace zinvul {
 
@@ -56,6 +58,28 @@ const DeviceInfo& Device::deviceInfo() const noexcept
   return *device_info_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+MemoryRegistry& Device::memoryRegistry() noexcept
+{
+  return *memory_registry_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const MemoryRegistry& Device::memoryRegistry() const noexcept
+{
+  return *memory_registry_;
+}
+
 } // namespace zinvul
 
 #endif // ZINVUL_DEVICE_INL_HPP
@@ -22,6 +22,7 @@
 #include "sub_platform.hpp"
 #include "zinvul_config.hpp"
 #include "utility/id_data.hpp"
+#include "utility/memory_registry.hpp"
 #include "utility/zinvul_object.hpp"
 
 namespace zinvul {
@@ -47,6 +48,7 @@ void Device::destroy() noexcept
 {
   destroyData();
   device_info_ = nullptr;
+  memory_registry_.reset();
   destroyObject();
 }
 
@@ -65,6 +67,11 @@ void Device::initialize(ZinvulObject::SharedPtr&& parent,
 
   initObject(std::move(parent), std::move(own));
   device_info_ = std::addressof(device_info);
+  {
+    auto mem_resource = memoryResource();
+    zisc::pmr::polymorphic_allocator<MemoryRegistry> alloc{mem_resource};
+    memory_registry_ = zisc::pmr::allocateUnique(alloc, mem_resource);
+  }
   initData();
 }
 
@@ -25,12 +25,14 @@
 #include "buffer.hpp"
 #include "zinvul_config.hpp"
 #include "utility/id_data.hpp"
+#include "utility/memory_registry.hpp"
 #include "utility/zinvul_object.hpp"
 
 namespace zinvul {
 
 // Forward declaration
 class DeviceInfo;
+class Fence;
 class SubPlatform;
 
 /*!
@@ -59,15 +61,28 @@ class Device : public ZinvulObject
   //! Return the underlying device info
   const DeviceInfo& deviceInfo() const noexcept;
 
+  //! Make the queue wait for the command of the fence before the next commands
+  virtual void enqueueWait(const uint32b queue_index,
+                           const Fence& fence) noexcept = 0;
+
   //! Initialize the device
   void initialize(ZinvulObject::SharedPtr&& parent,
                   WeakPtr&& own,
                   const DeviceInfo& device_info);
 
+  //! Check if the command of the given fence is completed
+  virtual bool isCompleted(const Fence& fence) const noexcept = 0;
+
   //! Make a buffer
   template <typename T>
   SharedBuffer<T> makeBuffer(const BufferUsage flag);
 
+  //! Return the registry of the memory of the buffers
+  MemoryRegistry& memoryRegistry() noexcept;
+
+  //! Return the registry of the memory of the buffers
+  const MemoryRegistry& memoryRegistry() const noexcept;
+
   //! Return the number of underlying command queues
   virtual std::size_t numOfQueues() const noexcept = 0;
 
@@ -77,15 +92,14 @@ class Device : public ZinvulObject
   //! Return the current memory usage of the heap of the given number
   virtual std::size_t totalMemoryUsage(const std::size_t number) const noexcept = 0;
 
-//  //! Wait this thread until all commands in the device are completed
-//  virtual void waitForCompletion() const noexcept = 0;
-//
-//  //! Wait this thread until all commands in the queues are completed
-//  virtual void waitForCompletion(const QueueType queue_type) const noexcept = 0;
-//
-//  //! Wait this thread until all commands in the queue are completed
-//  virtual void waitForCompletion(const QueueType queue_type,
-//                                 const uint32b queue_index) const noexcept = 0;
+  //! Wait this thread until all commands in the device are completed
+  virtual void waitForCompletion() const noexcept = 0;
+
+  //! Wait this thread until all commands in the queue are completed
+  virtual void waitForCompletion(const uint32b queue_index) const noexcept = 0;
+
+  //! Wait this thread until the command of the given fence is completed
+  virtual void waitForCompletion(const Fence& fence) const noexcept = 0;
 
  protected:
   //! Destroy the data
@@ -96,6 +110,7 @@ class Device : public ZinvulObject
 
  private:
   const DeviceInfo* device_info_ = nullptr;
+  zisc::pmr::unique_ptr<MemoryRegistry> memory_registry_;
 };
 
 // Type aliases
@@ -0,0 +1,119 @@
+/*!
+  \file fence-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_FENCE_INL_HPP
+#define ZINVUL_FENCE_INL_HPP
+
+#include "fence.hpp"
+// Zinvul
+#include "device.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+  */
+inline
+Fence::Fence() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] device No description.
+  \param [in] queue_index No description.
+  \param [in] number No description.
+  */
+inline
+Fence::Fence(const Device* device,
+             const uint32b queue_index,
+             const uint64b number) noexcept :
+    device_{device},
+    number_{number},
+    queue_index_{queue_index}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+Fence::operator bool() const noexcept
+{
+  const bool result = device_ != nullptr;
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const Device* Fence::device() const noexcept
+{
+  return device_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool Fence::isCompleted() const noexcept
+{
+  const bool result = (device_ == nullptr) || device_->isCompleted(*this);
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint64b Fence::number() const noexcept
+{
+  return number_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b Fence::queueIndex() const noexcept
+{
+  return queue_index_;
+}
+
+/*!
+  \details No detailed description
+  */
+inline
+void Fence::wait() const noexcept
+{
+  if (device_ != nullptr)
+    device_->waitForCompletion(*this);
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_FENCE_INL_HPP
@@ -0,0 +1,75 @@
+/*!
+  \file fence.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_FENCE_HPP
+#define ZINVUL_FENCE_HPP
+
+// Zinvul
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+class Device;
+
+/*!
+  \brief A handle of a command submitted to a device queue
+
+  A fence is identified by the queue index and the submission number of the
+  command in the queue. Commands in a queue are completed in submission order,
+  so a fence is signaled when the queue has completed the number of commands.
+  A fence without a device is always signaled.
+  */
+class Fence
+{
+ public:
+  //! Create a signaled fence
+  Fence() noexcept;
+
+  //! Create a fence of the given submission
+  Fence(const Device* device,
+        const uint32b queue_index,
+        const uint64b number) noexcept;
+
+
+  //! Check if the fence is associated with a submission
+  explicit operator bool() const noexcept;
+
+
+  //! Return the device which the command was submitted to
+  const Device* device() const noexcept;
+
+  //! Check if the command of the fence is completed
+  bool isCompleted() const noexcept;
+
+  //! Return the submission number of the command in the queue
+  uint64b number() const noexcept;
+
+  //! Return the index of the queue which the command was submitted to
+  uint32b queueIndex() const noexcept;
+
+  //! Wait this thread until the command of the fence is completed
+  void wait() const noexcept;
+
+ private:
+  const Device* device_ = nullptr;
+  uint64b number_ = 0;
+  uint32b queue_index_ = 0;
+};
+
+} // namespace zinvul
+
+#include "fence-inl.hpp"
+
+#endif // ZINVUL_FENCE_HPP
@@ -35,7 +35,10 @@ template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes
 inline
 Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 LaunchOptions::LaunchOptions() noexcept :
-    queue_index_{0}
+    global_offset_{},
+    tile_size_{defaultTileSize()},
+    queue_index_{0},
+    traversal_order_{TraversalOrder::kRowMajor}
 {
 }
 
@@ -49,7 +52,10 @@ inline
 Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 LaunchOptions::LaunchOptions(const std::array<uint32b, kDimension>& work_size) noexcept :
     work_size_{work_size},
-    queue_index_{0}
+    global_offset_{},
+    tile_size_{defaultTileSize()},
+    queue_index_{0},
+    traversal_order_{TraversalOrder::kRowMajor}
 {
 }
 
@@ -64,10 +70,31 @@ Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 LaunchOptions::LaunchOptions(const std::array<uint32b, kDimension>& work_size,
                              const uint32b queue_index) noexcept :
     work_size_{work_size},
-    queue_index_{queue_index}
+    global_offset_{},
+    tile_size_{defaultTileSize()},
+    queue_index_{queue_index},
+    traversal_order_{TraversalOrder::kRowMajor}
 {
 }
 
+/*!
+  \details A tile of 32 work-items in each dimension fits the working set of
+  a neighborhood kernel into the L1 or L2 cache
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+constexpr std::array<uint32b, kDimension>
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::defaultTileSize() noexcept
+{
+  std::array<uint32b, kDimension> tile_size{};
+  for (std::size_t i = 0; i < kDimension; ++i)
+    tile_size[i] = 32;
+  return tile_size;
+}
+
 /*!
   \details No detailed description
 
@@ -82,6 +109,20 @@ LaunchOptions::dimension() noexcept
   return kDimension;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+const std::array<uint32b, kDimension>&
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::globalOffset() const noexcept
+{
+  return global_offset_;
+}
+
 /*!
   \details No detailed description
 
@@ -110,6 +151,38 @@ LaunchOptions::queueIndex() const noexcept
   return queue_index_;
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] global_offset No description.
+  \param [in] dim No description.
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+void
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::setGlobalOffset(const uint32b global_offset,
+                               const std::size_t dim) noexcept
+{
+  global_offset_[dim] = global_offset;
+}
+
+/*!
+  \details The work-items of a launch have the global ids
+  [global_offset, global_offset + work_size), so a large range can be split
+  into sub-range launches. Vulkan kernels don't support a non-zero offset
+
+  \param [in] global_offset No description.
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+void
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::setGlobalOffset(const std::array<uint32b, kDimension>& global_offset) noexcept
+{
+  global_offset_ = global_offset;
+}
+
 /*!
   \details No detailed description
 
@@ -124,6 +197,35 @@ LaunchOptions::setQueueIndex(const uint32b queue_index) noexcept
   queue_index_ = queue_index;
 }
 
+/*!
+  \details The tile size is rounded up to a multiple of the local work-group
+  size of the device
+
+  \param [in] tile_size No description.
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+void
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::setTileSize(const std::array<uint32b, kDimension>& tile_size) noexcept
+{
+  tile_size_ = tile_size;
+}
+
+/*!
+  \details The order is a hint for cpu devices. Vulkan devices ignore it
+
+  \param [in] order No description.
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+void
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::setTraversalOrder(const TraversalOrder order) noexcept
+{
+  traversal_order_ = order;
+}
+
 /*!
   \details No detailed description
 
@@ -154,6 +256,34 @@ LaunchOptions::setWorkSize(const std::array<uint32b, kDimension>& work_size) noe
   work_size_ = work_size;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+const std::array<uint32b, kDimension>&
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::tileSize() const noexcept
+{
+  return tile_size_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+TraversalOrder
+Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+LaunchOptions::traversalOrder() const noexcept
+{
+  return traversal_order_;
+}
+
 /*!
   \details No detailed description
 
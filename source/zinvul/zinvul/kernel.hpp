@@ -23,6 +23,7 @@
 // Zisc
 #include "zisc/algorithm.hpp"
 // Zinvul
+#include "fence.hpp"
 #include "utility/id_data.hpp"
 #include "utility/zinvul_object.hpp"
 #include "zinvul/zinvul_config.hpp"
@@ -31,6 +32,7 @@ namespace zinvul {
 
 // Forward declaration
 template <typename Type> class Buffer;
+class CommandList;
 template <typename ...ArgTypes> class KernelInitParameters;
 template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
 class Kernel;
@@ -78,24 +80,48 @@ class Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...> :
                   const uint32b queue_index) noexcept;
 
 
+    //! Return the default tile size of a tiled traversal
+    static constexpr std::array<uint32b, kDimension> defaultTileSize() noexcept;
+
     //! Return the work-group dimension
     static constexpr std::size_t dimension() noexcept;
 
+    //! Return the global id of the first work-item
+    const std::array<uint32b, kDimension>& globalOffset() const noexcept;
+
     //! Return the number of kernel arguments
     static constexpr std::size_t numOfArgs() noexcept;
 
     //! Return the queue index
     uint32b queueIndex() const noexcept;
 
+    //! Set the global id of the first work-item
+    void setGlobalOffset(const uint32b global_offset, const std::size_t dim) noexcept;
+
+    //! Set the global id of the first work-item
+    void setGlobalOffset(const std::array<uint32b, kDimension>& global_offset) noexcept;
+
     //! Set the queue index which is used for a kernel execution
     void setQueueIndex(const uint32b queue_index) noexcept;
 
+    //! Set the number of work-items of a tile in each dimension
+    void setTileSize(const std::array<uint32b, kDimension>& tile_size) noexcept;
+
+    //! Set the order in which the work-groups are traversed
+    void setTraversalOrder(const TraversalOrder order) noexcept;
+
     //! Set the work group size
     void setWorkSize(const uint32b work_size, const std::size_t dim) noexcept;
 
     //! Set the work group size
     void setWorkSize(const std::array<uint32b, kDimension>& work_size) noexcept;
 
+    //! Return the number of work-items of a tile in each dimension
+    const std::array<uint32b, kDimension>& tileSize() const noexcept;
+
+    //! Return the order in which the work-groups are traversed
+    TraversalOrder traversalOrder() const noexcept;
+
     //! Return the work group size
     const std::array<uint32b, kDimension>& workSize() const noexcept;
 
@@ -104,7 +130,10 @@ class Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...> :
 
 
     std::array<uint32b, kDimension> work_size_;
+    std::array<uint32b, kDimension> global_offset_;
+    std::array<uint32b, kDimension> tile_size_;
     uint32b queue_index_ = 0;
+    TraversalOrder traversal_order_;
   };
 
 
@@ -132,9 +161,14 @@ class Kernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...> :
   //! Return the number of kernel arguments
   static constexpr std::size_t numOfArgs() noexcept;
 
-  //! Execute a kernel
-  virtual void run(BufferRef<ArgTypes>... args,
-                   const LaunchOptions& launch_options) = 0;
+  //! Record a launch of the kernel in the list, which vulkan kernels don't support
+  virtual void record(CommandList* command_list,
+                      BufferRef<ArgTypes>... args,
+                      const LaunchOptions& launch_options) = 0;
+
+  //! Execute a kernel asynchronously, which vulkan kernels don't support
+  virtual Fence run(BufferRef<ArgTypes>... args,
+                    const LaunchOptions& launch_options) = 0;
 
  protected:
   //! Clear the contents of the kernel
@@ -17,9 +17,11 @@
 
 #include "platform_options.hpp"
 // Standard C++ library
+#include <cstddef>
 #include <string>
 #include <string_view>
 // Zisc
+#include "zisc/error.hpp"
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
 #include "zinvul_config.hpp"
@@ -42,8 +44,19 @@ PlatformOptions::PlatformOptions(zisc::pmr::memory_resource* mem_resource)
         platform_version_patch_{0},
         debug_mode_enabled_{Config::scalarResultFalse()},
         cpu_num_of_threads_{0},
+        cpu_num_of_queues_{4},
         cpu_task_batch_size_{32},
+        cpu_task_batch_time_{50},
+        cpu_work_group_size_{1},
+        cpu_buffer_alignment_{64},
+        cpu_memory_policy_{CpuMemoryPolicy::kFirstTouch},
+        cpu_core_policy_{CpuCorePolicy::kAny},
+        cpu_huge_page_policy_{CpuHugePagePolicy::kNone},
+        cpu_huge_page_threshold_{8 * 1024 * 1024},
+        cpu_numa_pinning_enabled_{Config::scalarResultTrue()},
+        cpu_adaptive_task_batch_enabled_{Config::scalarResultFalse()},
         vulkan_sub_platform_enabled_{Config::scalarResultTrue()},
+        vulkan_memory_budget_ratio_{0.9},
         vulkan_instance_ptr_{nullptr},
         vulkan_get_proc_addr_ptr_{nullptr}
 {
@@ -64,8 +77,19 @@ PlatformOptions::PlatformOptions(PlatformOptions&& other) noexcept :
     platform_version_patch_{other.platform_version_patch_},
     debug_mode_enabled_{other.debug_mode_enabled_},
     cpu_num_of_threads_{other.cpu_num_of_threads_},
+    cpu_num_of_queues_{other.cpu_num_of_queues_},
     cpu_task_batch_size_{other.cpu_task_batch_size_},
+    cpu_task_batch_time_{other.cpu_task_batch_time_},
+    cpu_work_group_size_{other.cpu_work_group_size_},
+    cpu_buffer_alignment_{other.cpu_buffer_alignment_},
+    cpu_memory_policy_{other.cpu_memory_policy_},
+    cpu_core_policy_{other.cpu_core_policy_},
+    cpu_huge_page_policy_{other.cpu_huge_page_policy_},
+    cpu_huge_page_threshold_{other.cpu_huge_page_threshold_},
+    cpu_numa_pinning_enabled_{other.cpu_numa_pinning_enabled_},
+    cpu_adaptive_task_batch_enabled_{other.cpu_adaptive_task_batch_enabled_},
     vulkan_sub_platform_enabled_{other.vulkan_sub_platform_enabled_},
+    vulkan_memory_budget_ratio_{other.vulkan_memory_budget_ratio_},
     vulkan_instance_ptr_{other.vulkan_instance_ptr_},
     vulkan_get_proc_addr_ptr_{other.vulkan_get_proc_addr_ptr_}
 {
@@ -87,13 +111,115 @@ PlatformOptions& PlatformOptions::operator=(PlatformOptions&& other) noexcept
   platform_version_patch_ = other.platform_version_patch_;
   debug_mode_enabled_ = other.debug_mode_enabled_;
   cpu_num_of_threads_ = other.cpu_num_of_threads_;
+  cpu_num_of_queues_ = other.cpu_num_of_queues_;
   cpu_task_batch_size_ = other.cpu_task_batch_size_;
+  cpu_task_batch_time_ = other.cpu_task_batch_time_;
+  cpu_work_group_size_ = other.cpu_work_group_size_;
+  cpu_buffer_alignment_ = other.cpu_buffer_alignment_;
+  cpu_memory_policy_ = other.cpu_memory_policy_;
+  cpu_core_policy_ = other.cpu_core_policy_;
+  cpu_huge_page_policy_ = other.cpu_huge_page_policy_;
+  cpu_huge_page_threshold_ = other.cpu_huge_page_threshold_;
+  cpu_numa_pinning_enabled_ = other.cpu_numa_pinning_enabled_;
+  cpu_adaptive_task_batch_enabled_ = other.cpu_adaptive_task_batch_enabled_;
   vulkan_sub_platform_enabled_ = other.vulkan_sub_platform_enabled_;
+  vulkan_memory_budget_ratio_ = other.vulkan_memory_budget_ratio_;
   vulkan_instance_ptr_ = other.vulkan_instance_ptr_;
   vulkan_get_proc_addr_ptr_ = other.vulkan_get_proc_addr_ptr_;
   return *this;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool PlatformOptions::cpuAdaptiveTaskBatchEnabled() const noexcept
+{
+  const bool result =
+      cpu_adaptive_task_batch_enabled_ == Config::scalarResultTrue();
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b PlatformOptions::cpuBufferAlignment() const noexcept
+{
+  return cpu_buffer_alignment_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuCorePolicy PlatformOptions::cpuCorePolicy() const noexcept
+{
+  return cpu_core_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuMemoryPolicy PlatformOptions::cpuMemoryPolicy() const noexcept
+{
+  return cpu_memory_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool PlatformOptions::cpuNumaPinningEnabled() const noexcept
+{
+  const bool result = cpu_numa_pinning_enabled_ == Config::scalarResultTrue();
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+CpuHugePagePolicy PlatformOptions::cpuHugePagePolicy() const noexcept
+{
+  return cpu_huge_page_policy_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t PlatformOptions::cpuHugePageThreshold() const noexcept
+{
+  return cpu_huge_page_threshold_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b PlatformOptions::cpuNumOfQueues() const noexcept
+{
+  return cpu_num_of_queues_;
+}
+
 /*!
   \details No detailed description
 
@@ -116,6 +242,55 @@ uint32b PlatformOptions::cpuTaskBatchSize() const noexcept
   return cpu_task_batch_size_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b PlatformOptions::cpuTaskBatchTime() const noexcept
+{
+  return cpu_task_batch_time_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+uint32b PlatformOptions::cpuWorkGroupSize() const noexcept
+{
+  return cpu_work_group_size_;
+}
+
+/*!
+  \details The task batch size of a kernel starts from the cpu task batch
+  size and is adjusted so that a batch takes the cpu task batch time
+
+  \param [in] adaptive_enabled No description.
+  */
+inline
+void PlatformOptions::enableCpuAdaptiveTaskBatch(const bool adaptive_enabled)
+    noexcept
+{
+  cpu_adaptive_task_batch_enabled_ = adaptive_enabled
+      ? Config::scalarResultTrue()
+      : Config::scalarResultFalse();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] pinning_enabled No description.
+  */
+inline
+void PlatformOptions::enableCpuNumaPinning(const bool pinning_enabled) noexcept
+{
+  cpu_numa_pinning_enabled_ = pinning_enabled ? Config::scalarResultTrue() :
+                                                Config::scalarResultFalse();
+}
+
 /*!
   \details No detailed description
 
@@ -221,6 +396,75 @@ bool PlatformOptions::debugModeEnabled() const noexcept
   return result;
 }
 
+/*!
+  \details The alignment is rounded up to power of 2 and clamped between a
+  cache line and a page
+
+  \param [in] alignment No description.
+  */
+inline
+void PlatformOptions::setCpuBufferAlignment(const uint32b alignment) noexcept
+{
+  cpu_buffer_alignment_ = alignment;
+}
+
+/*!
+  \details The core policy is applied when the worker threads aren't pinned
+  to NUMA nodes
+
+  \param [in] policy No description.
+  */
+inline
+void PlatformOptions::setCpuCorePolicy(const CpuCorePolicy policy) noexcept
+{
+  cpu_core_policy_ = policy;
+}
+
+/*!
+  \details Huge pages are available only on Linux. The normal pages are used
+  on the other systems
+
+  \param [in] policy No description.
+  */
+inline
+void PlatformOptions::setCpuHugePagePolicy(const CpuHugePagePolicy policy) noexcept
+{
+  cpu_huge_page_policy_ = policy;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] threshold No description.
+  */
+inline
+void PlatformOptions::setCpuHugePageThreshold(const std::size_t threshold) noexcept
+{
+  cpu_huge_page_threshold_ = threshold;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] policy No description.
+  */
+inline
+void PlatformOptions::setCpuMemoryPolicy(const CpuMemoryPolicy policy) noexcept
+{
+  cpu_memory_policy_ = policy;
+}
+
+/*!
+  \details The number is clamped between 1 and 64
+
+  \param [in] num_of_queues No description.
+  */
+inline
+void PlatformOptions::setCpuNumOfQueues(const uint32b num_of_queues) noexcept
+{
+  cpu_num_of_queues_ = num_of_queues;
+}
+
 /*!
   \details No detailed description
 
@@ -243,6 +487,28 @@ void PlatformOptions::setCpuTaskBatchSize(const uint32b task_batch_size) noexcep
   cpu_task_batch_size_ = task_batch_size;
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] batch_time No description.
+  */
+inline
+void PlatformOptions::setCpuTaskBatchTime(const uint32b batch_time) noexcept
+{
+  cpu_task_batch_time_ = batch_time;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] work_group_size No description.
+  */
+inline
+void PlatformOptions::setCpuWorkGroupSize(const uint32b work_group_size) noexcept
+{
+  cpu_work_group_size_ = work_group_size;
+}
+
 /*!
   \details No detailed description
 
@@ -287,6 +553,21 @@ void PlatformOptions::setPlatformVersionPatch(const uint32b patch) noexcept
   platform_version_patch_ = patch;
 }
 
+/*!
+  \details The budget of a device heap is the ratio of the budget which the
+  driver reports through VK_EXT_memory_budget. When an allocation exceeds the
+  budget, the least recently used device-only buffers are moved to host memory
+
+  \param [in] ratio No description.
+  */
+inline
+void PlatformOptions::setVulkanMemoryBudgetRatio(const double ratio) noexcept
+{
+  ZISC_ASSERT((0.0 < ratio) && (ratio <= 1.0),
+              "The budget ratio is out of range: ", ratio);
+  vulkan_memory_budget_ratio_ = ratio;
+}
+
 /*!
   \details No detailed description
 
@@ -331,6 +612,17 @@ void* PlatformOptions::vulkanGetProcAddrPtr() noexcept
   return vulkan_get_proc_addr_ptr_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+double PlatformOptions::vulkanMemoryBudgetRatio() const noexcept
+{
+  return vulkan_memory_budget_ratio_;
+}
+
 /*!
   \details No detailed description
 
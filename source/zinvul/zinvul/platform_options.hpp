@@ -16,6 +16,7 @@
 #define ZINVUL_PLATFORM_OPTIONS_HPP
 
 // Standard C++ library
+#include <cstddef>
 #include <string>
 #include <string_view>
 // Zisc
@@ -45,12 +46,48 @@ class PlatformOptions : private zisc::NonCopyable<PlatformOptions>
   PlatformOptions& operator=(PlatformOptions&& other) noexcept;
 
 
+  //! Check whether the task batch size is adjusted at runtime
+  bool cpuAdaptiveTaskBatchEnabled() const noexcept;
+
+  //! Return the alignment of the storage of cpu buffers in bytes
+  uint32b cpuBufferAlignment() const noexcept;
+
+  //! Return the placement of the cpu worker threads on the cores
+  CpuCorePolicy cpuCorePolicy() const noexcept;
+
+  //! Return the use of huge pages for the memory of large cpu buffers
+  CpuHugePagePolicy cpuHugePagePolicy() const noexcept;
+
+  //! Return the size in bytes from which cpu buffers are backed by huge pages
+  std::size_t cpuHugePageThreshold() const noexcept;
+
+  //! Return the number of command queues of the cpu device
+  uint32b cpuNumOfQueues() const noexcept;
+
   //! Return the number of thread for kernel execution
   uint32b cpuNumOfThreads() const noexcept;
 
+  //! Return the memory policy of cpu buffers on NUMA systems
+  CpuMemoryPolicy cpuMemoryPolicy() const noexcept;
+
+  //! Check whether the cpu worker threads are pinned to NUMA nodes
+  bool cpuNumaPinningEnabled() const noexcept;
+
   //! Return the task batch size per thread
   uint32b cpuTaskBatchSize() const noexcept;
 
+  //! Return the target execution time of a task batch in microseconds
+  uint32b cpuTaskBatchTime() const noexcept;
+
+  //! Return the local work-group size of the cpu device
+  uint32b cpuWorkGroupSize() const noexcept;
+
+  //! Enable adjusting the task batch size of each kernel at runtime
+  void enableCpuAdaptiveTaskBatch(const bool adaptive_enabled) noexcept;
+
+  //! Enable pinning the cpu worker threads to NUMA nodes
+  void enableCpuNumaPinning(const bool pinning_enabled) noexcept;
+
   //! Enable the debug mode
   void enableDebugMode(const bool debug_mode_enabled) noexcept;
 
@@ -78,12 +115,36 @@ class PlatformOptions : private zisc::NonCopyable<PlatformOptions>
   //! Check whether the debug mode is enabled
   bool debugModeEnabled() const noexcept;
 
+  //! Set the alignment of the storage of cpu buffers in bytes
+  void setCpuBufferAlignment(const uint32b alignment) noexcept;
+
+  //! Set the placement of the cpu worker threads on the cores
+  void setCpuCorePolicy(const CpuCorePolicy policy) noexcept;
+
+  //! Set the use of huge pages for the memory of large cpu buffers
+  void setCpuHugePagePolicy(const CpuHugePagePolicy policy) noexcept;
+
+  //! Set the size in bytes from which cpu buffers are backed by huge pages
+  void setCpuHugePageThreshold(const std::size_t threshold) noexcept;
+
+  //! Set the memory policy of cpu buffers on NUMA systems
+  void setCpuMemoryPolicy(const CpuMemoryPolicy policy) noexcept;
+
+  //! Set the number of command queues of the cpu device
+  void setCpuNumOfQueues(const uint32b num_of_queues) noexcept;
+
   //! Set the number of threads for kernel execution
   void setCpuNumOfThreads(const uint32b num_of_threads) noexcept;
 
   //! Set the task batch size per thread
   void setCpuTaskBatchSize(const uint32b task_batch_size) noexcept;
 
+  //! Set the target execution time of a task batch in microseconds
+  void setCpuTaskBatchTime(const uint32b batch_time) noexcept;
+
+  //! Set the local work-group size of the cpu device
+  void setCpuWorkGroupSize(const uint32b work_group_size) noexcept;
+
   //! Set the platform name
   void setPlatformName(std::string_view name) noexcept;
 
@@ -96,6 +157,9 @@ class PlatformOptions : private zisc::NonCopyable<PlatformOptions>
   //! Set the value of the patch component of the platform version number
   void setPlatformVersionPatch(const uint32b patch) noexcept;
 
+  //! Set the ratio of the memory budget of the driver which vulkan devices use
+  void setVulkanMemoryBudgetRatio(const double ratio) noexcept;
+
   //! Set a ptr of a VkInstance object which is used instead of internal instance
   void setVulkanInstancePtr(void* instance_ptr) noexcept;
 
@@ -108,6 +172,9 @@ class PlatformOptions : private zisc::NonCopyable<PlatformOptions>
   //! Return a ptr of a PFN_vkGetInstanceProcAddr
   void* vulkanGetProcAddrPtr() noexcept;
 
+  //! Return the ratio of the memory budget of the driver which vulkan devices use
+  double vulkanMemoryBudgetRatio() const noexcept;
+
   //! Check whether the vulkan sub-platform is enabled
   bool vulkanSubPlatformEnabled() const noexcept;
 
@@ -123,8 +190,19 @@ class PlatformOptions : private zisc::NonCopyable<PlatformOptions>
   uint32b platform_version_patch_;
   int32b debug_mode_enabled_; //!< Enable debugging in Zinvul
   uint32b cpu_num_of_threads_ = 0;
+  uint32b cpu_num_of_queues_ = 4;
   uint32b cpu_task_batch_size_ = 32;
+  uint32b cpu_task_batch_time_ = 50;
+  uint32b cpu_work_group_size_ = 1;
+  uint32b cpu_buffer_alignment_ = 64;
+  CpuMemoryPolicy cpu_memory_policy_ = CpuMemoryPolicy::kFirstTouch;
+  CpuCorePolicy cpu_core_policy_ = CpuCorePolicy::kAny;
+  CpuHugePagePolicy cpu_huge_page_policy_ = CpuHugePagePolicy::kNone;
+  std::size_t cpu_huge_page_threshold_ = 8 * 1024 * 1024;
+  int32b cpu_numa_pinning_enabled_;
+  int32b cpu_adaptive_task_batch_enabled_;
   int32b vulkan_sub_platform_enabled_;
+  double vulkan_memory_budget_ratio_ = 0.9;
   void* vulkan_instance_ptr_ = nullptr;
   void* vulkan_get_proc_addr_ptr_ = nullptr;
 };
@@ -0,0 +1,108 @@
+/*!
+  \file split_launcher-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_SPLIT_LAUNCHER_INL_HPP
+#define ZINVUL_SPLIT_LAUNCHER_INL_HPP
+
+#include "split_launcher.hpp"
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/error.hpp"
+// Zinvul
+#include "buffer.hpp"
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details The range of the part is gathered from the same position of the
+  buffer, which is the position of the global ids of the part
+
+  \tparam Type No description.
+  \param [in] device_index No description.
+  \param [in] buffer The output buffer of the device.
+  \param [out] data The host memory of the output of the whole range.
+  \param [in] num_of_elements The number of elements of a work-item.
+  \param [in] queue_index No description.
+  */
+template <typename Type> inline
+void SplitLauncher::gather(const std::size_t device_index,
+                           const Buffer<Type>& buffer,
+                           Type* data,
+                           const std::size_t num_of_elements,
+                           const uint32b queue_index) const
+{
+  uint32b begin = 0,
+          end = 0;
+  getPart(device_index, &begin, &end);
+  const std::size_t slice_size = slice_size_ * num_of_elements;
+  const std::size_t offset = slice_size * begin;
+  const std::size_t count = slice_size * (end - begin);
+  if (0 < count)
+    buffer.read(data + offset, count, offset, queue_index);
+}
+
+/*!
+  \details The launch function is invoked for each device with a non-empty
+  part, and submits the kernel of the device with the offset and the size of
+  the part. The function returns after all parts are completed, and the
+  throughput of the devices is updated with the execution time of the parts
+
+  \tparam kDimension No description.
+  \tparam Function Fence (std::size_t device_index, const std::array<uint32b, kDimension>& global_offset, const std::array<uint32b, kDimension>& work_size)
+  \param [in] work_size No description.
+  \param [in] launch No description.
+  */
+template <std::size_t kDimension, typename Function> inline
+void SplitLauncher::run(const std::array<uint32b, kDimension>& work_size,
+                        Function&& launch)
+{
+  static_assert(std::is_invocable_r_v<Fence,
+                                      Function,
+                                      std::size_t,
+                                      const std::array<uint32b, kDimension>&,
+                                      const std::array<uint32b, kDimension>&>,
+                "The launch function doesn't have the signature.");
+  ZISC_ASSERT(0 < numOfDevices(), "The launcher doesn't have any device.");
+  constexpr std::size_t last = kDimension - 1;
+  slice_size_ = 1;
+  for (std::size_t i = 0; i < last; ++i)
+    slice_size_ *= work_size[i];
+  partition(work_size[last]);
+
+  for (std::size_t index = 0; index < numOfDevices(); ++index) {
+    auto& part = part_list_[index];
+    part.fence_ = Fence{};
+    part.start_time_ = Clock::time_point{};
+    part.end_time_ = Clock::time_point{};
+    if (part.begin_ == part.end_)
+      continue;
+    std::array<uint32b, kDimension> offset{};
+    offset[last] = part.begin_;
+    std::array<uint32b, kDimension> size = work_size;
+    size[last] = part.end_ - part.begin_;
+    part.start_time_ = Clock::now();
+    part.fence_ = launch(index, offset, size);
+  }
+  update();
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_SPLIT_LAUNCHER_INL_HPP
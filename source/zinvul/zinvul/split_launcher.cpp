@@ -0,0 +1,233 @@
+/*!
+  \file split_launcher.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "split_launcher.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "device.hpp"
+#include "device_info.hpp"
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+SplitLauncher::SplitLauncher(zisc::pmr::memory_resource* mem_resource) noexcept :
+    part_list_{decltype(part_list_)::allocator_type{mem_resource}}
+{
+}
+
+/*!
+  \details The initial throughput decides the split of the first launch.
+  Only the ratio of the throughput of the devices matters. The kernels of the
+  device must be dispatchable, so vulkan devices aren't accepted yet
+
+  \param [in] device No description.
+  \param [in] initial_throughput No description.
+  \return The index of the device
+  */
+std::size_t SplitLauncher::addDevice(Device* device,
+                                     const double initial_throughput)
+{
+  ZISC_ASSERT(device != nullptr, "The device is null.");
+  ZISC_ASSERT(device->deviceInfo().type() == SubPlatformType::kCpu,
+              "The kernels of the device can't be dispatched.");
+  ZISC_ASSERT(0.0 < initial_throughput,
+              "The initial throughput isn't positive: ", initial_throughput);
+  Part part;
+  part.device_ = device;
+  part.throughput_ = initial_throughput;
+  part_list_.emplace_back(part);
+  return part_list_.size() - 1;
+}
+
+/*!
+  \details No detailed description
+  */
+void SplitLauncher::clear() noexcept
+{
+  part_list_.clear();
+  slice_size_ = 0;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] device_index No description.
+  \return No description
+  */
+Device* SplitLauncher::device(const std::size_t device_index) const noexcept
+{
+  ZISC_ASSERT(device_index < numOfDevices(),
+              "The device index is out of range: ", device_index);
+  return part_list_[device_index].device_;
+}
+
+/*!
+  \details The time is zero if the device didn't process any part
+
+  \param [in] device_index No description.
+  \return No description
+  */
+std::chrono::nanoseconds SplitLauncher::executionTime(
+    const std::size_t device_index) const noexcept
+{
+  ZISC_ASSERT(device_index < numOfDevices(),
+              "The device index is out of range: ", device_index);
+  const auto& part = part_list_[device_index];
+  const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      part.end_time_ - part.start_time_);
+  return time;
+}
+
+/*!
+  \details The range is of the last launch
+
+  \param [in] device_index No description.
+  \param [out] begin No description.
+  \param [out] end No description.
+  */
+void SplitLauncher::getPart(const std::size_t device_index,
+                            uint32b* begin,
+                            uint32b* end) const noexcept
+{
+  ZISC_ASSERT(device_index < numOfDevices(),
+              "The device index is out of range: ", device_index);
+  const auto& part = part_list_[device_index];
+  *begin = part.begin_;
+  *end = part.end_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t SplitLauncher::numOfDevices() const noexcept
+{
+  return part_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] device_index No description.
+  \return No description
+  */
+double SplitLauncher::throughput(const std::size_t device_index) const noexcept
+{
+  ZISC_ASSERT(device_index < numOfDevices(),
+              "The device index is out of range: ", device_index);
+  return part_list_[device_index].throughput_;
+}
+
+/*!
+  \details The new throughput is the geometric mean of the current one and
+  the measured one, so a single noisy launch doesn't move the split far.
+  The throughput is kept if the launch function didn't submit a command or
+  the time isn't measurable, since the throughput would grow without bound
+
+  \param [in,out] part No description.
+  \param [in] end_time No description.
+  */
+void SplitLauncher::complete(Part* part, const Clock::time_point end_time) noexcept
+{
+  part->end_time_ = end_time;
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      part->end_time_ - part->start_time_);
+  const bool is_measured = static_cast<bool>(part->fence_) && (0 < elapsed.count());
+  if (is_measured) {
+    const double elapsed_time = zisc::cast<double>(elapsed.count());
+    const double num_of_works = zisc::cast<double>(slice_size_) *
+                                zisc::cast<double>(part->end_ - part->begin_);
+    const double measured = num_of_works / elapsed_time;
+    part->throughput_ = std::sqrt(part->throughput_ * measured);
+  }
+  part->fence_ = Fence{};
+  part->is_running_ = false;
+}
+
+/*!
+  \details The boundaries are rounded from the cumulative throughput, so the
+  parts cover the range exactly
+
+  \param [in] size No description.
+  */
+void SplitLauncher::partition(const uint32b size) noexcept
+{
+  double total = 0.0;
+  for (const auto& part : part_list_)
+    total += part.throughput_;
+
+  double sum = 0.0;
+  uint32b begin = 0;
+  for (auto& part : part_list_) {
+    sum += part.throughput_;
+    const double end = std::round(zisc::cast<double>(size) * (sum / total));
+    part.begin_ = begin;
+    part.end_ = std::clamp(zisc::cast<uint32b>(end), begin, size);
+    begin = part.end_;
+  }
+  part_list_.back().end_ = size;
+}
+
+/*!
+  \details The thread blocks on the fence of the part which is expected to
+  complete first by the throughput. When it wakes up, the other parts are
+  checked without blocking, so a part which has completed meanwhile is
+  recorded at that time. The split balances the parts, so they are expected
+  to complete at nearly the same time
+  */
+void SplitLauncher::update() noexcept
+{
+  for (auto& part : part_list_)
+    part.is_running_ = part.begin_ < part.end_;
+
+  auto expected_time = [this](const Part& part) noexcept
+  {
+    const double num_of_works = zisc::cast<double>(slice_size_) *
+                                zisc::cast<double>(part.end_ - part.begin_);
+    return num_of_works / part.throughput_;
+  };
+
+  for (Part* next = nullptr;; next = nullptr) {
+    for (auto& part : part_list_) {
+      if (part.is_running_ &&
+          ((next == nullptr) || (expected_time(part) < expected_time(*next))))
+        next = &part;
+    }
+    if (next == nullptr)
+      break;
+    next->fence_.wait();
+    complete(next, Clock::now());
+    for (auto& part : part_list_) {
+      if (part.is_running_ && part.fence_.isCompleted())
+        complete(&part, Clock::now());
+    }
+  }
+}
+
+} // namespace zinvul
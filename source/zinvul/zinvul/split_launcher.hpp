@@ -0,0 +1,124 @@
+/*!
+  \file split_launcher.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_SPLIT_LAUNCHER_HPP
+#define ZINVUL_SPLIT_LAUNCHER_HPP
+
+// Standard C++ library
+#include <array>
+#include <chrono>
+#include <cstddef>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+template <typename Type> class Buffer;
+class Device;
+
+/*!
+  \brief Split a launch across several devices by their throughput
+
+  The range of a launch is split into contiguous parts in the last
+  dimension, and each device processes a part with the global offset of the
+  part. So the part of a device is a contiguous range of row-major global
+  ids. The size of a part is proportional to the throughput of the device,
+  which is learned from the execution time of the previous launches.
+  */
+class SplitLauncher : private zisc::NonCopyable<SplitLauncher>
+{
+ public:
+  //! Create a launcher without devices
+  SplitLauncher(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+
+  //! Add a device which processes a part of the launches
+  std::size_t addDevice(Device* device, const double initial_throughput = 1.0);
+
+  //! Remove all devices
+  void clear() noexcept;
+
+  //! Return the device
+  Device* device(const std::size_t device_index) const noexcept;
+
+  //! Return the execution time of the part of the device in the last launch
+  std::chrono::nanoseconds executionTime(const std::size_t device_index) const noexcept;
+
+  //! Read the part of the device from the buffer into the host memory
+  template <typename Type>
+  void gather(const std::size_t device_index,
+              const Buffer<Type>& buffer,
+              Type* data,
+              const std::size_t num_of_elements = 1,
+              const uint32b queue_index = 0) const;
+
+  //! Return the range of the part of the device in the last dimension
+  void getPart(const std::size_t device_index,
+               uint32b* begin,
+               uint32b* end) const noexcept;
+
+  //! Return the number of devices
+  std::size_t numOfDevices() const noexcept;
+
+  //! Launch the parts of the range on the devices and wait for them
+  template <std::size_t kDimension, typename Function>
+  void run(const std::array<uint32b, kDimension>& work_size, Function&& launch);
+
+  //! Return the learned throughput of the device in work-items per nanosecond
+  double throughput(const std::size_t device_index) const noexcept;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+
+  /*!
+    \brief The part of a launch which a device processes
+    */
+  struct Part
+  {
+    Device* device_ = nullptr;
+    Fence fence_;
+    Clock::time_point start_time_;
+    Clock::time_point end_time_;
+    double throughput_ = 1.0;
+    uint32b begin_ = 0;
+    uint32b end_ = 0;
+    bool is_running_ = false;
+  };
+
+
+  //! Record the completion of the part and update the throughput of the device
+  void complete(Part* part, const Clock::time_point end_time) noexcept;
+
+  //! Split the range of the last dimension into the parts
+  void partition(const uint32b size) noexcept;
+
+  //! Wait for the parts and update the throughput of the devices
+  void update() noexcept;
+
+
+  zisc::pmr::vector<Part> part_list_;
+  std::size_t slice_size_ = 0; //!< The number of work-items of a slice
+};
+
+} // namespace zinvul
+
+#include "split_launcher-inl.hpp"
+
+#endif // ZINVUL_SPLIT_LAUNCHER_HPP
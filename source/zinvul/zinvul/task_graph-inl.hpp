@@ -0,0 +1,304 @@
+/*!
+  \file task_graph-inl.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_TASK_GRAPH_INL_HPP
+#define ZINVUL_TASK_GRAPH_INL_HPP
+
+#include "task_graph.hpp"
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "buffer.hpp"
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer No description.
+  \param [in] is_written No description.
+  */
+inline
+TaskGraph::BufferAccess::BufferAccess(const void* buffer,
+                                      const bool is_written) noexcept :
+    buffer_{buffer},
+    is_written_{is_written}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const void* TaskGraph::BufferAccess::buffer() const noexcept
+{
+  return buffer_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+bool TaskGraph::BufferAccess::isWritten() const noexcept
+{
+  return is_written_;
+}
+
+/*!
+  \details The src and dst buffers must be alive until the task is completed
+
+  \tparam Type No description.
+  \param [in] src No description.
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  \return The index of the task
+  */
+template <typename Type> inline
+std::size_t TaskGraph::addCopy(const Buffer<Type>& src,
+                               Buffer<Type>* dst,
+                               const std::size_t count,
+                               const std::size_t src_offset,
+                               const std::size_t dst_offset)
+{
+  const Buffer<Type>* s = std::addressof(src);
+  auto command = [s, dst, count, src_offset, dst_offset](const uint32b q)
+  {
+    return s->copyTo(dst, count, src_offset, dst_offset, q);
+  };
+  return addTask(std::move(command), {read(src), write(*dst)});
+}
+
+/*!
+  \details The buffers which the kernel accesses have to be declared in the
+  access list, since the kernel can only tell the types of the arguments.
+  The kernel and the buffers must be alive until the task is completed
+
+  \tparam kDimension No description.
+  \tparam FuncArgTypes No description.
+  \tparam ArgTypes No description.
+  \param [in] kernel No description.
+  \param [in] work_size No description.
+  \param [in] access_list No description.
+  \param [in] args No description.
+  \return The index of the task
+  */
+template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+inline
+std::size_t TaskGraph::addKernel(
+    Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+    const std::array<uint32b, kDimension>& work_size,
+    std::initializer_list<BufferAccess> access_list,
+    Buffer<ArgTypes>&... args)
+{
+  auto options = kernel->makeOptions();
+  options.setWorkSize(work_size);
+  return addKernel(kernel, options, access_list, args...);
+}
+
+/*!
+  \details The options are copied into the task, and only the queue index of
+  them is replaced with the queue which the task is submitted to. So the
+  global offset, the traversal order and the tile size are kept
+
+  \tparam kDimension No description.
+  \tparam FuncArgTypes No description.
+  \tparam ArgTypes No description.
+  \param [in] kernel No description.
+  \param [in] launch_options No description.
+  \param [in] access_list No description.
+  \param [in] args No description.
+  \return The index of the task
+  */
+template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+inline
+std::size_t TaskGraph::addKernel(
+    Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+    const typename Kernel<kDimension, FuncArgTypes, ArgTypes...>::LaunchOptions& launch_options,
+    std::initializer_list<BufferAccess> access_list,
+    Buffer<ArgTypes>&... args)
+{
+  auto arg_list = std::make_tuple(std::addressof(args)...);
+  auto command = [kernel, launch_options, arg_list](const uint32b q)
+  {
+    auto options = launch_options;
+    options.setQueueIndex(q);
+    auto launch = [kernel, &options](Buffer<ArgTypes>*... a)
+    {
+      return kernel->run(*a..., options);
+    };
+    return std::apply(launch, arg_list);
+  };
+  return addTask(std::move(command), access_list);
+}
+
+/*!
+  \details The command is invoked with the index of the queue which the task
+  is submitted to, and has to return the fence of the submitted command
+
+  \tparam Function No description.
+  \param [in] command No description.
+  \param [in] access_list No description.
+  \return The index of the task
+  */
+template <typename Function> inline
+std::size_t TaskGraph::addTask(Function&& command,
+                               std::initializer_list<BufferAccess> access_list)
+{
+  using TaskT = FunctionTask<std::decay_t<Function>>;
+  zisc::pmr::polymorphic_allocator<TaskT> alloc{mem_resource_};
+  TaskT* task = alloc.allocate(1);
+  ::new (task) TaskT{std::forward<Function>(command)};
+  return addNode(task, access_list);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+Device* TaskGraph::device() const noexcept
+{
+  return device_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] task_index No description.
+  \return No description
+  */
+inline
+const Fence& TaskGraph::fence(const std::size_t task_index) const noexcept
+{
+  return node_list_[task_index].fence_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+std::size_t TaskGraph::numOfTasks() const noexcept
+{
+  return node_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] task_index No description.
+  \return No description
+  */
+inline
+uint32b TaskGraph::queueIndex(const std::size_t task_index) const noexcept
+{
+  return node_list_[task_index].queue_index_;
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type No description.
+  \param [in] buffer No description.
+  \return No description
+  */
+template <typename Type> inline
+auto TaskGraph::read(const Buffer<Type>& buffer) noexcept -> BufferAccess
+{
+  return BufferAccess{std::addressof(buffer), false};
+}
+
+/*!
+  \details No detailed description
+
+  \tparam Type No description.
+  \param [in] buffer No description.
+  \return No description
+  */
+template <typename Type> inline
+auto TaskGraph::write(const Buffer<Type>& buffer) noexcept -> BufferAccess
+{
+  return BufferAccess{std::addressof(buffer), true};
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr uint32b TaskGraph::invalidIndex() noexcept
+{
+  return std::numeric_limits<uint32b>::max();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] function No description.
+  */
+template <typename Function> inline
+TaskGraph::FunctionTask<Function>::FunctionTask(Function function) noexcept :
+    function_{std::move(function)}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+template <typename Function> inline
+void TaskGraph::FunctionTask<Function>::release(
+    zisc::pmr::memory_resource* mem_resource) noexcept
+{
+  zisc::pmr::polymorphic_allocator<FunctionTask> alloc{mem_resource};
+  this->~FunctionTask();
+  alloc.deallocate(this, 1);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+template <typename Function> inline
+Fence TaskGraph::FunctionTask<Function>::run(const uint32b queue_index)
+{
+  return function_(queue_index);
+}
+
+} // namespace zinvul
+
+#endif // ZINVUL_TASK_GRAPH_INL_HPP
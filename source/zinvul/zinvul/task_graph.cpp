@@ -0,0 +1,243 @@
+/*!
+  \file task_graph.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "task_graph.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "device.hpp"
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] device No description.
+  \param [in] mem_resource No description.
+  */
+TaskGraph::TaskGraph(Device* device,
+                     zisc::pmr::memory_resource* mem_resource) noexcept :
+    device_{device},
+    mem_resource_{mem_resource},
+    node_list_{decltype(node_list_)::allocator_type{mem_resource}},
+    dependency_list_{decltype(dependency_list_)::allocator_type{mem_resource}},
+    buffer_state_list_{decltype(buffer_state_list_)::allocator_type{mem_resource}}
+{
+  ZISC_ASSERT(device_ != nullptr, "The device is null.");
+}
+
+/*!
+  \details No detailed description
+  */
+TaskGraph::~TaskGraph() noexcept
+{
+  clear();
+}
+
+/*!
+  \details The tasks of the last run are completed before they are released
+  */
+void TaskGraph::clear() noexcept
+{
+  waitForCompletion();
+  for (auto& node : node_list_) {
+    if (node.task_ != nullptr)
+      node.task_->release(mem_resource_);
+  }
+  node_list_.clear();
+  dependency_list_.clear();
+  buffer_state_list_.clear();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] task_index No description.
+  \param [out] num_of_dependencies No description.
+  \return The sorted indices of the tasks which the task depends on
+  */
+const uint32b* TaskGraph::dependencies(
+    const std::size_t task_index,
+    std::size_t* num_of_dependencies) const noexcept
+{
+  ZISC_ASSERT(task_index < numOfTasks(),
+              "The task index is out of range: ", task_index);
+  const Node& node = node_list_[task_index];
+  if (num_of_dependencies != nullptr)
+    *num_of_dependencies = node.dependency_end_ - node.dependency_begin_;
+  return dependency_list_.data() + node.dependency_begin_;
+}
+
+/*!
+  \details The graph can be run repeatedly. A run waits for the completion
+  of the previous run
+  */
+void TaskGraph::run()
+{
+  waitForCompletion();
+
+  const std::size_t num_of_queues = std::max(device_->numOfQueues(),
+                                             std::size_t{1});
+  // The last task submitted to each queue in this run
+  zisc::pmr::vector<uint32b> queue_tail_list{
+      num_of_queues,
+      invalidIndex(),
+      decltype(queue_tail_list)::allocator_type{mem_resource_}};
+  // The latest fence of each queue which the task has to wait for
+  zisc::pmr::vector<Fence> wait_list{
+      num_of_queues,
+      Fence{},
+      decltype(wait_list)::allocator_type{mem_resource_}};
+
+  for (std::size_t i = 0; i < numOfTasks(); ++i) {
+    Node& node = node_list_[i];
+    const uint32b queue_index = selectQueue(i, queue_tail_list);
+
+    std::fill(wait_list.begin(), wait_list.end(), Fence{});
+    for (uint32b d = node.dependency_begin_; d < node.dependency_end_; ++d) {
+      const Fence& f = node_list_[dependency_list_[d]].fence_;
+      if (!f)
+        continue;
+      Fence& w = wait_list[f.queueIndex()];
+      if (!w || (w.number() < f.number()))
+        w = f;
+    }
+    for (const Fence& w : wait_list) {
+      if (w)
+        device_->enqueueWait(queue_index, w);
+    }
+
+    node.fence_ = node.task_->run(queue_index);
+    node.queue_index_ = node.fence_ ? node.fence_.queueIndex() : queue_index;
+    if (node.queue_index_ < num_of_queues)
+      queue_tail_list[node.queue_index_] = zisc::cast<uint32b>(i);
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void TaskGraph::waitForCompletion() const noexcept
+{
+  for (const auto& node : node_list_) {
+    if (node.fence_)
+      node.fence_.wait();
+  }
+}
+
+/*!
+  \details A task which writes a buffer depends on the last writer and the
+  readers after it. A task which reads a buffer depends on the last writer
+
+  \param [in] task No description.
+  \param [in] access_list No description.
+  \return The index of the task
+  */
+std::size_t TaskGraph::addNode(Task* task,
+                               std::initializer_list<BufferAccess> access_list)
+{
+  const auto task_index = zisc::cast<uint32b>(numOfTasks());
+  const auto begin = zisc::cast<uint32b>(dependency_list_.size());
+  for (const BufferAccess& access : access_list) {
+    auto state = buffer_state_list_.find(access.buffer());
+    if (state == buffer_state_list_.end())
+      state = buffer_state_list_.emplace(access.buffer(), mem_resource_).first;
+    BufferState& s = state->second;
+    if (s.last_writer_ != invalidIndex())
+      dependency_list_.emplace_back(s.last_writer_);
+    if (access.isWritten()) {
+      for (const uint32b reader : s.reader_list_)
+        dependency_list_.emplace_back(reader);
+      s.reader_list_.clear();
+      s.last_writer_ = task_index;
+    }
+    else {
+      s.reader_list_.emplace_back(task_index);
+    }
+  }
+  // Remove the task itself and the duplicates
+  auto first = dependency_list_.begin() + begin;
+  auto last = std::remove(first, dependency_list_.end(), task_index);
+  std::sort(first, last);
+  last = std::unique(first, last);
+  dependency_list_.erase(last, dependency_list_.end());
+
+  Node node;
+  node.task_ = task;
+  node.dependency_begin_ = begin;
+  node.dependency_end_ = zisc::cast<uint32b>(dependency_list_.size());
+  node_list_.emplace_back(std::move(node));
+  return task_index;
+}
+
+/*!
+  \details A task is appended to the queue whose last task is a dependency,
+  since the queue orders them without waiting. Otherwise an idle queue or
+  the queue whose last task is the oldest is selected
+
+  \param [in] task_index No description.
+  \param [in] queue_tail_list No description.
+  \return No description
+  */
+uint32b TaskGraph::selectQueue(
+    const std::size_t task_index,
+    const zisc::pmr::vector<uint32b>& queue_tail_list) const noexcept
+{
+  const Node& node = node_list_[task_index];
+  // Follow the latest dependency
+  for (uint32b d = node.dependency_end_; node.dependency_begin_ < d; --d) {
+    const uint32b dependency = dependency_list_[d - 1];
+    const uint32b q = node_list_[dependency].queue_index_;
+    if ((q < queue_tail_list.size()) && (queue_tail_list[q] == dependency))
+      return q;
+  }
+  uint32b queue_index = 0;
+  for (std::size_t q = 0; q < queue_tail_list.size(); ++q) {
+    const uint32b tail = queue_tail_list[q];
+    if (tail == invalidIndex())
+      return zisc::cast<uint32b>(q);
+    if (tail < queue_tail_list[queue_index])
+      queue_index = zisc::cast<uint32b>(q);
+  }
+  return queue_index;
+}
+
+/*!
+  \details No detailed description
+  */
+TaskGraph::Task::~Task() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  */
+TaskGraph::BufferState::BufferState(zisc::pmr::memory_resource* mem_resource)
+    noexcept :
+        reader_list_{decltype(reader_list_)::allocator_type{mem_resource}}
+{
+}
+
+} // namespace zinvul
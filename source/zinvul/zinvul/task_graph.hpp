@@ -0,0 +1,227 @@
+/*!
+  \file task_graph.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_TASK_GRAPH_HPP
+#define ZINVUL_TASK_GRAPH_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "fence.hpp"
+#include "zinvul_config.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+template <typename Type> class Buffer;
+class Device;
+template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+class Kernel;
+
+/*!
+  \brief A graph of device commands which is ordered by buffer dependencies
+
+  A task is a command which is submitted to a queue of the device, such as
+  a kernel launch or a buffer transfer, with the buffers which the command
+  reads or writes. A task depends on the previous tasks which write the
+  buffers it accesses and on the previous tasks which read the buffers it
+  writes. The tasks are submitted in the order they were added and the
+  independent tasks are distributed to different queues, so that they are
+  executed concurrently. A dependency across queues is resolved by
+  Device::enqueueWait.
+  */
+class TaskGraph : private zisc::NonCopyable<TaskGraph>
+{
+ public:
+  /*!
+    \brief A declaration of a buffer access of a task
+    */
+  class BufferAccess
+  {
+   public:
+    //! Create an access of the buffer
+    BufferAccess(const void* buffer, const bool is_written) noexcept;
+
+
+    //! Return the accessed buffer
+    const void* buffer() const noexcept;
+
+    //! Check if the buffer is written by the task
+    bool isWritten() const noexcept;
+
+   private:
+    const void* buffer_;
+    bool is_written_;
+  };
+
+
+  //! Create an empty graph of the device
+  TaskGraph(Device* device, zisc::pmr::memory_resource* mem_resource) noexcept;
+
+  //! Destroy the graph
+  ~TaskGraph() noexcept;
+
+
+  //! Add a task which copies the elements of the src buffer to the dst buffer
+  template <typename Type>
+  std::size_t addCopy(const Buffer<Type>& src,
+                      Buffer<Type>* dst,
+                      const std::size_t count,
+                      const std::size_t src_offset,
+                      const std::size_t dst_offset);
+
+  //! Add a task which launches the kernel
+  template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+  std::size_t addKernel(Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+                        const std::array<uint32b, kDimension>& work_size,
+                        std::initializer_list<BufferAccess> access_list,
+                        Buffer<ArgTypes>&... args);
+
+  //! Add a task which launches the kernel with the given options
+  template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
+  std::size_t addKernel(
+      Kernel<kDimension, FuncArgTypes, ArgTypes...>* kernel,
+      const typename Kernel<kDimension, FuncArgTypes, ArgTypes...>::LaunchOptions& launch_options,
+      std::initializer_list<BufferAccess> access_list,
+      Buffer<ArgTypes>&... args);
+
+  //! Add a task which submits a command to the given queue and returns its fence
+  template <typename Function>
+  std::size_t addTask(Function&& command,
+                      std::initializer_list<BufferAccess> access_list);
+
+  //! Remove all tasks
+  void clear() noexcept;
+
+  //! Return the dependencies of the task
+  const uint32b* dependencies(const std::size_t task_index,
+                              std::size_t* num_of_dependencies) const noexcept;
+
+  //! Return the device
+  Device* device() const noexcept;
+
+  //! Return the fence of the task which is submitted in the last run
+  const Fence& fence(const std::size_t task_index) const noexcept;
+
+  //! Return the number of tasks
+  std::size_t numOfTasks() const noexcept;
+
+  //! Return the index of the queue which the task is submitted to
+  uint32b queueIndex(const std::size_t task_index) const noexcept;
+
+  //! Declare that the task reads the buffer
+  template <typename Type>
+  static BufferAccess read(const Buffer<Type>& buffer) noexcept;
+
+  //! Submit all tasks to the device
+  void run();
+
+  //! Wait this thread until all tasks of the last run are completed
+  void waitForCompletion() const noexcept;
+
+  //! Declare that the task writes the buffer
+  template <typename Type>
+  static BufferAccess write(const Buffer<Type>& buffer) noexcept;
+
+ private:
+  /*!
+    \brief A command of a task
+    */
+  class Task
+  {
+   public:
+    //! Finalize the task
+    virtual ~Task() noexcept;
+
+    //! Destroy the task and deallocate the memory
+    virtual void release(zisc::pmr::memory_resource* mem_resource) noexcept = 0;
+
+    //! Submit the command to the queue
+    virtual Fence run(const uint32b queue_index) = 0;
+  };
+
+  /*!
+    \brief A task which invokes a function object
+    */
+  template <typename Function>
+  class FunctionTask : public Task
+  {
+   public:
+    //! Create a task
+    FunctionTask(Function function) noexcept;
+
+
+    //! Destroy the task and deallocate the memory
+    void release(zisc::pmr::memory_resource* mem_resource) noexcept override;
+
+    //! Submit the command to the queue
+    Fence run(const uint32b queue_index) override;
+
+   private:
+    Function function_;
+  };
+
+  /*!
+    \brief The tasks which accessed a buffer last
+    */
+  struct BufferState
+  {
+    BufferState(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+    zisc::pmr::vector<uint32b> reader_list_; //!< Readers after the last writer
+    uint32b last_writer_ = std::numeric_limits<uint32b>::max();
+  };
+
+  /*!
+    \brief A task and its dependencies
+    */
+  struct Node
+  {
+    Task* task_ = nullptr;
+    Fence fence_;
+    uint32b dependency_begin_ = 0;
+    uint32b dependency_end_ = 0;
+    uint32b queue_index_ = 0;
+  };
+
+
+  //! Add a task with the buffer accesses
+  std::size_t addNode(Task* task, std::initializer_list<BufferAccess> access_list);
+
+  //! Return the invalid task index
+  static constexpr uint32b invalidIndex() noexcept;
+
+  //! Select the queue which the task is submitted to
+  uint32b selectQueue(const std::size_t task_index,
+                      const zisc::pmr::vector<uint32b>& queue_tail_list) const noexcept;
+
+
+  Device* device_;
+  zisc::pmr::memory_resource* mem_resource_;
+  zisc::pmr::vector<Node> node_list_;
+  zisc::pmr::vector<uint32b> dependency_list_;
+  zisc::pmr::map<const void*, BufferState> buffer_state_list_;
+};
+
+} // namespace zinvul
+
+#include "task_graph-inl.hpp"
+
+#endif // ZINVUL_TASK_GRAPH_HPP
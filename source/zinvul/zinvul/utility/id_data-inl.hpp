@@ -233,7 +233,8 @@ void IdData::setData(void* data, const std::size_t index) noexcept
 }
 
 /*!
-  \details No detailed description
+  \details A long file name keeps its tail, which tells the file of a long
+  path apart
 
   \param [in] file_name No description.
   \param [in] line_number No description.
@@ -242,7 +243,9 @@ inline
 void IdData::setFileInfo(std::string_view file_name,
                          const uint32b line_number) noexcept
 {
-  std::strcpy(file_name_, file_name.data());
+  const std::size_t s = (std::min)(file_name.size(), kMaxNameLength - 1);
+  std::copy_n(file_name.end() - s, s, file_name_);
+  file_name_[s] = '\0';
   line_number_ = line_number;
 }
 
@@ -254,7 +257,9 @@ void IdData::setFileInfo(std::string_view file_name,
 inline
 void IdData::setName(std::string_view data_name) noexcept
 {
-  std::strcpy(name_, data_name.data());
+  const std::size_t s = (std::min)(data_name.size(), kMaxNameLength - 1);
+  std::copy_n(data_name.begin(), s, name_);
+  name_[s] = '\0';
 }
 
 } // namespace zinvul
@@ -38,6 +38,21 @@ KernelInitParameters<ArgTypes...>::KernelInitParameters(Function ptr) noexcept :
   initialize();
 }
 
+/*!
+  \details A lock-step kernel processes the lanes of
+  zinvul::getGlobalLaneIdX() in an invocation. The CPU backend runs the kernel
+  once for every lane size work-items of x dimension. GPU backends run the
+  kernel for each work-item, where all lanes have the same ID
+
+  \param [in] lock_step_enabled No description.
+  */
+template <typename ...ArgTypes> inline
+void KernelInitParameters<ArgTypes...>::enableLockStep(
+    const bool lock_step_enabled) noexcept
+{
+  lock_step_enabled_ = lock_step_enabled;
+}
+
 /*!
   \details No detailed description
 
@@ -61,6 +76,17 @@ std::string_view KernelInitParameters<ArgTypes...>::kernelName() const noexcept
   return name;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename ...ArgTypes> inline
+bool KernelInitParameters<ArgTypes...>::lockStepEnabled() const noexcept
+{
+  return lock_step_enabled_;
+}
+
 /*!
   \details No detailed description
 
@@ -106,6 +132,7 @@ template <typename ...ArgTypes> inline
 void KernelInitParameters<ArgTypes...>::initialize() noexcept
 {
   kernel_name_.fill('\0');
+  lock_step_enabled_ = false;
 }
 
 } // namespace zinvul
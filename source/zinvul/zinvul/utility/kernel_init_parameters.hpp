@@ -41,12 +41,18 @@ class KernelInitParameters
   KernelInitParameters(Function ptr) noexcept;
 
 
+  //! Declare that the kernel can process adjacent work-items in lock-step
+  void enableLockStep(const bool lock_step_enabled) noexcept;
+
   //! Return the underlying function
   Function func() const noexcept;
 
   //! Return the kernel name
   std::string_view kernelName() const noexcept;
 
+  //! Check whether the kernel can process adjacent work-items in lock-step
+  bool lockStepEnabled() const noexcept;
+
   //! Return the maximum kernel name length
   static constexpr std::size_t maxKernelNameLength() noexcept;
 
@@ -66,6 +72,7 @@ class KernelInitParameters
 
   Function function_;
   std::array<char, kMaxKernelNameLength> kernel_name_;
+  bool lock_step_enabled_;
 };
 
 } // namespace zinvul
@@ -16,20 +16,23 @@
 #define ZINVUL_MAPPED_MEMORY_INL_HPP
 
 #include "mapped_memory.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <type_traits>
 // Zisc
 #include "zisc/error.hpp"
 #include "zisc/utility.hpp"
 // Zinvul
-#include "buffer.hpp"
-#include "zinvul_config.hpp"
+#include "zinvul/buffer.hpp"
+#include "zinvul/zinvul_config.hpp"
 
 namespace zinvul {
 
 /*!
   \details No detailed description
   */
-template <DescriptorType kDescriptor, typename T> inline
-MappedMemory<kDescriptor, T>::MappedMemory() noexcept
+template <typename T> inline
+MappedMemory<T>::MappedMemory() noexcept
 {
 }
 
@@ -38,9 +41,9 @@ MappedMemory<kDescriptor, T>::MappedMemory() noexcept
 
   \param [in] buffer No description.
   */
-template <DescriptorType kDescriptor, typename T> inline
-MappedMemory<kDescriptor, T>::MappedMemory(ConstBufferP buffer) noexcept :
-    data_{buffer ? buffer->mappedMemory() : nullptr},
+template <typename T> inline
+MappedMemory<T>::MappedMemory(ConstBufferP buffer) noexcept :
+    data_{buffer ? zisc::cast<Pointer>(buffer->mappedMemory()) : nullptr},
     buffer_{buffer}
 {
   if (buffer_) {
@@ -53,8 +56,8 @@ MappedMemory<kDescriptor, T>::MappedMemory(ConstBufferP buffer) noexcept :
 
   \param [in,out] other No description.
   */
-template <DescriptorType kDescriptor, typename T> inline
-MappedMemory<kDescriptor, T>::MappedMemory(MappedMemory&& other) noexcept
+template <typename T> inline
+MappedMemory<T>::MappedMemory(MappedMemory&& other) noexcept
 {
   zisc::swap(data_, other.data_);
   zisc::swap(buffer_, other.buffer_);
@@ -63,8 +66,8 @@ MappedMemory<kDescriptor, T>::MappedMemory(MappedMemory&& other) noexcept
 /*!
   \details No detailed description
   */
-template <DescriptorType kDescriptor, typename T> inline
-MappedMemory<kDescriptor, T>::~MappedMemory() noexcept
+template <typename T> inline
+MappedMemory<T>::~MappedMemory() noexcept
 {
   unmap();
 }
@@ -74,8 +77,8 @@ MappedMemory<kDescriptor, T>::~MappedMemory() noexcept
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::begin() noexcept -> Iterator
+template <typename T> inline
+auto MappedMemory<T>::begin() noexcept -> Iterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -87,8 +90,8 @@ auto MappedMemory<kDescriptor, T>::begin() noexcept -> Iterator
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::begin() const noexcept -> ConstIterator
+template <typename T> inline
+auto MappedMemory<T>::begin() const noexcept -> ConstIterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -100,8 +103,8 @@ auto MappedMemory<kDescriptor, T>::begin() const noexcept -> ConstIterator
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::cbegin() const noexcept -> ConstIterator
+template <typename T> inline
+auto MappedMemory<T>::cbegin() const noexcept -> ConstIterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -113,8 +116,8 @@ auto MappedMemory<kDescriptor, T>::cbegin() const noexcept -> ConstIterator
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::end() noexcept -> Iterator
+template <typename T> inline
+auto MappedMemory<T>::end() noexcept -> Iterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -127,8 +130,8 @@ auto MappedMemory<kDescriptor, T>::end() noexcept -> Iterator
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::end() const noexcept -> ConstIterator
+template <typename T> inline
+auto MappedMemory<T>::end() const noexcept -> ConstIterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -141,8 +144,8 @@ auto MappedMemory<kDescriptor, T>::end() const noexcept -> ConstIterator
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::cend() const noexcept -> ConstIterator
+template <typename T> inline
+auto MappedMemory<T>::cend() const noexcept -> ConstIterator
 {
   auto ite = data();
   ZISC_ASSERT(ite != nullptr, "The data is null.");
@@ -156,8 +159,8 @@ auto MappedMemory<kDescriptor, T>::cend() const noexcept -> ConstIterator
   \param [in,out] other No description.
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::operator=(MappedMemory&& other) noexcept
+template <typename T> inline
+auto MappedMemory<T>::operator=(MappedMemory&& other) noexcept
     -> MappedMemory&
 {
   zisc::swap(data_, other.data_);
@@ -171,8 +174,8 @@ auto MappedMemory<kDescriptor, T>::operator=(MappedMemory&& other) noexcept
   \param [in] index No description.
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::operator[](const std::size_t index) noexcept
+template <typename T> inline
+auto MappedMemory<T>::operator[](const std::size_t index) noexcept
     -> Reference
 {
   return get(index);
@@ -184,8 +187,8 @@ auto MappedMemory<kDescriptor, T>::operator[](const std::size_t index) noexcept
   \param [in] index No description.
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::operator[](const std::size_t index) const noexcept
+template <typename T> inline
+auto MappedMemory<T>::operator[](const std::size_t index) const noexcept
     -> ConstReference
 {
   return get(index);
@@ -196,8 +199,8 @@ auto MappedMemory<kDescriptor, T>::operator[](const std::size_t index) const noe
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::data() noexcept -> Pointer
+template <typename T> inline
+auto MappedMemory<T>::data() noexcept -> Pointer
 {
   return data_;
 }
@@ -207,8 +210,8 @@ auto MappedMemory<kDescriptor, T>::data() noexcept -> Pointer
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::data() const noexcept -> ConstPointer
+template <typename T> inline
+auto MappedMemory<T>::data() const noexcept -> ConstPointer
 {
   return data_;
 }
@@ -219,8 +222,8 @@ auto MappedMemory<kDescriptor, T>::data() const noexcept -> ConstPointer
   \param [in] index No description.
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::get(const std::size_t index) noexcept
+template <typename T> inline
+auto MappedMemory<T>::get(const std::size_t index) noexcept
     -> Reference
 {
   auto d = data();
@@ -236,8 +239,8 @@ auto MappedMemory<kDescriptor, T>::get(const std::size_t index) noexcept
   \param [in] index No description.
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-auto MappedMemory<kDescriptor, T>::get(const std::size_t index) const noexcept
+template <typename T> inline
+auto MappedMemory<T>::get(const std::size_t index) const noexcept
     -> ConstReference
 {
   auto d = data();
@@ -253,8 +256,8 @@ auto MappedMemory<kDescriptor, T>::get(const std::size_t index) const noexcept
   \param [in] index No description.
   \param [in] value No description.
   */
-template <DescriptorType kDescriptor, typename T> inline
-void MappedMemory<kDescriptor, T>::set(const std::size_t index,
+template <typename T> inline
+void MappedMemory<T>::set(const std::size_t index,
                                        ConstReference value) noexcept
 {
   auto d = data();
@@ -268,8 +271,8 @@ void MappedMemory<kDescriptor, T>::set(const std::size_t index,
 
   \return No description
   */
-template <DescriptorType kDescriptor, typename T> inline
-std::size_t MappedMemory<kDescriptor, T>::size() const noexcept
+template <typename T> inline
+std::size_t MappedMemory<T>::size() const noexcept
 {
   const std::size_t s = (buffer_ != nullptr) ? buffer_->size() : 0;
   return s;
@@ -278,11 +281,13 @@ std::size_t MappedMemory<kDescriptor, T>::size() const noexcept
 /*!
   \details No detailed description
   */
-template <DescriptorType kDescriptor, typename T> inline
-void MappedMemory<kDescriptor, T>::unmap() noexcept
+template <typename T> inline
+void MappedMemory<T>::unmap() noexcept
 {
-  if (buffer_ != nullptr)
-    buffer_->unmapMemory();
+  if (buffer_ != nullptr) {
+    constexpr bool is_writable = !std::is_const_v<T>;
+    buffer_->unmapMemory(is_writable);
+  }
   data_ = nullptr;
   buffer_ = nullptr;
 }
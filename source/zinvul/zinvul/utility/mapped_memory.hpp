@@ -16,27 +16,30 @@
 #define ZINVUL_MAPPED_MEMORY_HPP
 
 // Standard C++ library
+#include <cstddef>
 #include <type_traits>
 // Zisc
 #include "zisc/non_copyable.hpp"
 // Zinvul
-#include "zinvul_config.hpp"
+#include "zinvul/zinvul_config.hpp"
 
 namespace zinvul {
 
 // Forward declaration
-template <DescriptorType, typename> class Buffer;
+template <typename> class Buffer;
 
 /*!
-  \brief No brief description
+  \brief A view of the memory of a buffer which is mapped to the host
 
-  No detailed description.
+  The memory is accessed in place without copying. The memory of a non
+  coherent buffer is invalidated on mapping and is flushed on unmapping if
+  the view is writable. The commands which access to the buffer must be
+  completed while the memory is mapped.
 
-  \tparam kDescriptor No description.
   \tparam T No description.
   */
-template <DescriptorType kDescriptor, typename T>
-class MappedMemory : private zisc::NonCopyable<MappedMemory<kDescriptor, T>>
+template <typename T>
+class MappedMemory : private zisc::NonCopyable<MappedMemory<T>>
 {
  public:
   using Type = std::remove_volatile_t<T>;
@@ -47,7 +50,7 @@ class MappedMemory : private zisc::NonCopyable<MappedMemory<kDescriptor, T>>
   using ConstPointer = std::add_pointer_t<ConstType>;
   using Iterator = Pointer;
   using ConstIterator = ConstPointer;
-  using Buffer = zinvul::Buffer<kDescriptor, std::remove_cv_t<T>>;
+  using Buffer = zinvul::Buffer<std::remove_cv_t<T>>;
   using ConstBuffer = std::add_const_t<Buffer>;
   using BufferP = std::add_pointer_t<Buffer>;
   using ConstBufferP = std::add_pointer_t<ConstBuffer>;
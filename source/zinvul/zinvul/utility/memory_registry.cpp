@@ -0,0 +1,380 @@
+/*!
+  \file memory_registry.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "memory_registry.hpp"
+// Standard C++ library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+// Zisc
+#include "zisc/error.hpp"
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "id_data.hpp"
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::string_view MemoryRegistry::Entry::fileName() const noexcept
+{
+  std::string_view n{file_name_.data()};
+  return n;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::string_view MemoryRegistry::Entry::name() const noexcept
+{
+  std::string_view n{name_.data()};
+  return n;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in,out] mem_resource No description.
+  */
+MemoryRegistry::MemoryRegistry(zisc::pmr::memory_resource* mem_resource) noexcept :
+    entry_list_{decltype(entry_list_)::allocator_type{mem_resource}},
+    index_list_{decltype(index_list_)::allocator_type{mem_resource}},
+    retired_entry_list_{decltype(retired_entry_list_)::allocator_type{mem_resource}}
+{
+}
+
+/*!
+  \details No detailed description
+  */
+void MemoryRegistry::clear() noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  entry_list_.clear();
+  index_list_.clear();
+  retired_entry_list_.clear();
+  total_size_ = 0;
+  peak_size_ = 0;
+  version_ = 0;
+  peak_version_ = 0;
+}
+
+/*!
+  \details No detailed description
+
+  \param [out] entry_list No description.
+  */
+void MemoryRegistry::getPeakEntries(zisc::pmr::vector<Entry>* entry_list) const
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  copyPeakEntries(entry_list);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] n No description.
+  \param [out] entry_list No description.
+  */
+void MemoryRegistry::getTopEntries(const std::size_t n,
+                                   zisc::pmr::vector<Entry>* entry_list) const
+{
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    entry_list->assign(entry_list_.begin(), entry_list_.end());
+  }
+  auto is_larger = [](const Entry& lhs, const Entry& rhs) noexcept
+  {
+    return (lhs.size_ > rhs.size_) ||
+           ((lhs.size_ == rhs.size_) && (lhs.id_ < rhs.id_));
+  };
+  const std::size_t s = std::min(n, entry_list->size());
+  std::partial_sort(entry_list->begin(),
+                    entry_list->begin() + s,
+                    entry_list->end(),
+                    is_larger);
+  entry_list->resize(s);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t MemoryRegistry::numOfEntries() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return entry_list_.size();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t MemoryRegistry::peakSize() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return peak_size_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] id No description.
+  */
+void MemoryRegistry::remove(const IdData& id) noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto index = index_list_.find(id.id());
+  if (index != index_list_.end()) {
+    auto& entry = entry_list_[index->second];
+    retire(entry);
+    total_size_ -= entry.size_;
+    entry = entry_list_.back();
+    index_list_[entry.id_] = index->second;
+    index_list_.erase(index);
+    entry_list_.pop_back();
+    ++version_;
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t MemoryRegistry::totalSize() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return total_size_;
+}
+
+/*!
+  \details The name and the creation site of the buffer are copied, so the
+  entries are valid after the buffer is destroyed. An entry of zero size is
+  removed
+
+  \param [in] id No description.
+  \param [in] size No description.
+  \param [in] usage No description.
+  \param [in] memory_type No description.
+  \param [in] heap_index No description.
+  */
+void MemoryRegistry::update(const IdData& id,
+                            const std::size_t size,
+                            const BufferUsage usage,
+                            const uint32b memory_type,
+                            const std::size_t heap_index)
+{
+  if (size == 0) {
+    remove(id);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  auto [index, is_new] = index_list_.emplace(id.id(), entry_list_.size());
+  if (is_new)
+    entry_list_.emplace_back();
+  auto entry = entry_list_.begin() + zisc::cast<std::ptrdiff_t>(index->second);
+  if (!is_new)
+    retire(*entry);
+  total_size_ = total_size_ - entry->size_ + size;
+
+  // A long string keeps its tail, which tells the file of a long path apart
+  auto copy_str = [](std::string_view src, std::array<char, kMaxNameLength>* dst)
+  {
+    const std::size_t s = std::min(src.size(), dst->size() - 1);
+    std::copy_n(src.end() - s, s, dst->begin());
+    (*dst)[s] = '\0';
+  };
+  entry->size_ = size;
+  entry->version_ = ++version_;
+  entry->heap_index_ = heap_index;
+  entry->id_ = id.id();
+  entry->memory_type_ = memory_type;
+  entry->line_number_ = id.hasFileInfo() ? id.lineNumber() : 0;
+  entry->usage_ = usage;
+  copy_str(id.hasName() ? id.name() : std::string_view{}, &entry->name_);
+  copy_str(id.hasFileInfo() ? id.fileName() : std::string_view{},
+           &entry->file_name_);
+
+  if (peak_size_ < total_size_) {
+    peak_size_ = total_size_;
+    peak_version_ = version_;
+    retired_entry_list_.clear();
+  }
+}
+
+/*!
+  \details The snapshot consists of the total size, the peak size, the live
+  buffers in descending order of the size and the buffers which were live at
+  the peak
+
+  \param [out] output No description.
+  */
+void MemoryRegistry::writeJson(std::ostream& output) const
+{
+  auto mem_resource = entry_list_.get_allocator().resource();
+  zisc::pmr::vector<Entry> entry_list{
+      zisc::pmr::vector<Entry>::allocator_type{mem_resource}};
+  zisc::pmr::vector<Entry> peak_entry_list{
+      zisc::pmr::vector<Entry>::allocator_type{mem_resource}};
+  std::size_t total_size = 0,
+              peak_size = 0;
+  {
+    std::unique_lock<std::mutex> lock{mutex_};
+    total_size = total_size_;
+    peak_size = peak_size_;
+    copyPeakEntries(&peak_entry_list);
+  }
+  getTopEntries(std::numeric_limits<std::size_t>::max(), &entry_list);
+
+  output << "{\"total_size\": " << total_size
+         << ", \"peak_size\": " << peak_size
+         << ", \"buffers\": ";
+  writeJsonEntries(output, entry_list);
+  output << ", \"peak_buffers\": ";
+  writeJsonEntries(output, peak_entry_list);
+  output << "}";
+}
+
+/*!
+  \details The entries which haven't changed since the peak are live, and the
+  others are retired
+
+  \param [out] entry_list No description.
+  */
+void MemoryRegistry::copyPeakEntries(zisc::pmr::vector<Entry>* entry_list) const
+{
+  entry_list->assign(retired_entry_list_.begin(), retired_entry_list_.end());
+  for (const auto& entry : entry_list_) {
+    if (entry.version_ <= peak_version_)
+      entry_list->emplace_back(entry);
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] usage No description.
+  \return No description
+  */
+std::string_view MemoryRegistry::getUsageName(const BufferUsage usage) noexcept
+{
+  std::string_view name = "";
+  switch (usage) {
+   case BufferUsage::kDeviceOnly: {
+    name = "device_only";
+    break;
+   }
+   case BufferUsage::kHostOnly: {
+    name = "host_only";
+    break;
+   }
+   case BufferUsage::kHostToDevice: {
+    name = "host_to_device";
+    break;
+   }
+   case BufferUsage::kDeviceToHost: {
+    name = "device_to_host";
+    break;
+   }
+  }
+  return name;
+}
+
+/*!
+  \details An entry is retired only at the first change after the peak, so
+  the retired entries don't exceed the entries at the peak.
+  The mutex must be locked by the caller
+
+  \param [in] entry No description.
+  */
+void MemoryRegistry::retire(const Entry& entry)
+{
+  if (entry.version_ <= peak_version_)
+    retired_entry_list_.emplace_back(entry);
+}
+
+/*!
+  \details No detailed description
+
+  \param [out] output No description.
+  \param [in] entry_list No description.
+  */
+void MemoryRegistry::writeJsonEntries(std::ostream& output,
+                                      const zisc::pmr::vector<Entry>& entry_list)
+{
+  output << "[";
+  for (std::size_t i = 0; i < entry_list.size(); ++i) {
+    const auto& entry = entry_list[i];
+    output << ((i == 0) ? "" : ", ") << "{\"id\": " << entry.id_
+           << ", \"name\": ";
+    writeJsonString(output, entry.name());
+    output << ", \"size\": " << entry.size_
+           << ", \"usage\": \"" << getUsageName(entry.usage_) << "\""
+           << ", \"memory_type\": " << entry.memory_type_
+           << ", \"heap\": " << entry.heap_index_
+           << ", \"file\": ";
+    writeJsonString(output, entry.fileName());
+    output << ", \"line\": " << entry.line_number_ << "}";
+  }
+  output << "]";
+}
+
+/*!
+  \details No detailed description
+
+  \param [out] output No description.
+  \param [in] str No description.
+  */
+void MemoryRegistry::writeJsonString(std::ostream& output, std::string_view str)
+{
+  constexpr std::string_view hex = "0123456789abcdef";
+  output << "\"";
+  for (const char c : str) {
+    switch (c) {
+     case '"': {
+      output << "\\\"";
+      break;
+     }
+     case '\\': {
+      output << "\\\\";
+      break;
+     }
+     default: {
+      const auto u = zisc::cast<unsigned char>(c);
+      if (u < 0x20)
+        output << "\\u00" << hex[u >> 4] << hex[u & 0xfu];
+      else
+        output << c;
+      break;
+     }
+    }
+  }
+  output << "\"";
+}
+
+} // namespace zinvul
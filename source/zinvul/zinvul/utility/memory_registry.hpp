@@ -0,0 +1,142 @@
+/*!
+  \file memory_registry.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_MEMORY_REGISTRY_HPP
+#define ZINVUL_MEMORY_REGISTRY_HPP
+
+// Standard C++ library
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+// Zisc
+#include "zisc/non_copyable.hpp"
+#include "zisc/std_memory_resource.hpp"
+// Zinvul
+#include "zinvul/zinvul_config.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+class IdData;
+
+/*!
+  \brief The registry of the memory of the live buffers of a device
+
+  A buffer updates its entry when its memory is reallocated and removes it
+  when the buffer is destroyed. The entries which were live at the peak of
+  the total size are kept as the peak composition. The composition isn't
+  copied at each peak. Each entry records the version of the registry when
+  it is updated, and only the entries which were live at the peak are
+  retired into a list when they change after the peak. The composition is
+  rebuilt from them on demand.
+  */
+class MemoryRegistry : private zisc::NonCopyable<MemoryRegistry>
+{
+ public:
+  static constexpr std::size_t kMaxNameLength = 128;
+
+
+  /*!
+    \brief The memory of a buffer
+    */
+  struct Entry
+  {
+    //! Return the file name where the buffer is created
+    std::string_view fileName() const noexcept;
+
+    //! Return the name of the buffer
+    std::string_view name() const noexcept;
+
+
+    std::size_t size_ = 0; //!< The memory size in bytes
+    uint64b version_ = 0; //!< The version of the registry when the entry is updated
+    std::size_t heap_index_ = 0;
+    uint32b id_ = 0;
+    uint32b memory_type_ = 0;
+    uint32b line_number_ = 0;
+    BufferUsage usage_ = BufferUsage::kDeviceOnly;
+    std::array<char, kMaxNameLength> name_{};
+    std::array<char, kMaxNameLength> file_name_{};
+  };
+
+
+  //! Create an empty registry
+  MemoryRegistry(zisc::pmr::memory_resource* mem_resource) noexcept;
+
+
+  //! Remove all entries and reset the peak
+  void clear() noexcept;
+
+  //! Copy the entries which were live at the peak of the total size
+  void getPeakEntries(zisc::pmr::vector<Entry>* entry_list) const;
+
+  //! Copy the largest entries in descending order of the size
+  void getTopEntries(const std::size_t n,
+                     zisc::pmr::vector<Entry>* entry_list) const;
+
+  //! Return the number of the live buffers
+  std::size_t numOfEntries() const noexcept;
+
+  //! Return the peak of the total size in bytes
+  std::size_t peakSize() const noexcept;
+
+  //! Remove the entry of the buffer
+  void remove(const IdData& id) noexcept;
+
+  //! Return the total size of the live buffers in bytes
+  std::size_t totalSize() const noexcept;
+
+  //! Add or update the entry of the buffer
+  void update(const IdData& id,
+              const std::size_t size,
+              const BufferUsage usage,
+              const uint32b memory_type,
+              const std::size_t heap_index);
+
+  //! Write a snapshot of the entries in JSON
+  void writeJson(std::ostream& output) const;
+
+ private:
+  //! Copy the entries which were live at the peak. The mutex must be locked
+  void copyPeakEntries(zisc::pmr::vector<Entry>* entry_list) const;
+
+  //! Return the name of the buffer usage
+  static std::string_view getUsageName(const BufferUsage usage) noexcept;
+
+  //! Keep the entry in the peak composition before it's changed
+  void retire(const Entry& entry);
+
+  //! Write a list of entries as a JSON array
+  static void writeJsonEntries(std::ostream& output,
+                               const zisc::pmr::vector<Entry>& entry_list);
+
+  //! Write a string as a JSON string
+  static void writeJsonString(std::ostream& output, std::string_view str);
+
+
+  zisc::pmr::vector<Entry> entry_list_;
+  zisc::pmr::map<uint32b, std::size_t> index_list_; //!< The entry index of an id
+  zisc::pmr::vector<Entry> retired_entry_list_; //!< Changed after the peak
+  mutable std::mutex mutex_;
+  std::size_t total_size_ = 0;
+  std::size_t peak_size_ = 0;
+  uint64b version_ = 0;
+  uint64b peak_version_ = 0;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_MEMORY_REGISTRY_HPP
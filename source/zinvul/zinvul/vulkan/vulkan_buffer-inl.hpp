@@ -17,17 +17,24 @@
 
 #include "vulkan_buffer.hpp"
 // Standard C++ library
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <type_traits>
 #include <utility>
 // Vulkan
 #include <vulkan/vulkan.h>
 // Zisc
+#include "zisc/error.hpp"
 #include "zisc/std_memory_resource.hpp"
 #include "zisc/utility.hpp"
 // Zinvul
+#include "vulkan_command_list.hpp"
 #include "vulkan_device.hpp"
 #include "vulkan_device_info.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/sub_platform.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -49,6 +56,8 @@ VulkanBuffer<T>::VulkanBuffer(IdData&& id) noexcept : Buffer<T>(std::move(id))
 template <typename T> inline
 VulkanBuffer<T>::~VulkanBuffer() noexcept
 {
+  if (isFrameBuffer())
+    parentImpl().removeFrameBuffer(this);
   Buffer<T>::destroy();
 }
 
@@ -107,6 +116,59 @@ const VkBuffer& VulkanBuffer<T>::buffer() const noexcept
   return buffer_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+std::size_t VulkanBuffer<T>::capacity() const noexcept
+{
+  return capacity_;
+}
+
+/*!
+  \details The copy is executed asynchronously after the commands which were
+  submitted to the queue before. Both buffers must be alive until the
+  returned fence is signaled. The device doesn't evict the buffers during the
+  submission and waits for the copy before an eviction
+
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  \param [in] queue_index No description.
+  \return No description
+  */
+template <typename T> inline
+Fence VulkanBuffer<T>::copyTo(Buffer<T>* dst,
+                              const std::size_t count,
+                              const std::size_t src_offset,
+                              const std::size_t dst_offset,
+                              const uint32b queue_index) const
+{
+  ZISC_ASSERT(dst->type() == SubPlatformType::kVulkan,
+              "The dst buffer isn't a vulkan buffer.");
+  ZISC_ASSERT((src_offset + count) <= size(), "The src range is out of bounds.");
+  ZISC_ASSERT((dst_offset + count) <= dst->size(), "The dst range is out of bounds.");
+  Fence fence;
+  if (0 < count) {
+    auto dst_buffer = zisc::cast<VulkanBuffer*>(dst);
+    beginTransfer();
+    dst_buffer->beginTransfer();
+    markUsed();
+    dst_buffer->markUsed();
+    const VkBufferCopy region{offset() + sizeof(Type) * src_offset,
+                              dst_buffer->offset() + sizeof(Type) * dst_offset,
+                              sizeof(Type) * count};
+    auto& device = const_cast<VulkanDevice&>(parentImpl());
+    fence = device.copyBuffer(buffer(), dst_buffer->buffer(), region, queue_index);
+    dst_buffer->endTransfer();
+    endTransfer();
+  }
+  return fence;
+}
+
 /*!
   \details No detailed description
 
@@ -119,6 +181,17 @@ bool VulkanBuffer<T>::isDeviceLocal() const noexcept
   return result;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+bool VulkanBuffer<T>::isFrameBuffer() const noexcept
+{
+  return is_frame_buffer_;
+}
+
 /*!
   \details No detailed description
 
@@ -156,27 +229,130 @@ bool VulkanBuffer<T>::isHostVisible() const noexcept
 }
 
 /*!
-  \details No detailed description
+  \details A frame buffer is a range of a frame block of the device.
+  Otherwise the offset is always 0
+
+  \return No description
+  */
+template <typename T> inline
+std::size_t VulkanBuffer<T>::offset() const noexcept
+{
+  return offset_;
+}
+
+/*!
+  \details A host visible buffer is copied directly from the persistently
+  mapped memory, the commands which write to the buffer must be completed.
+  Otherwise the elements are transferred through a staging buffer of the
+  device on the queue
+
+  \param [out] data No description.
+  \param [in] count No description.
+  \param [in] offset No description.
+  \param [in] queue_index No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::read(Pointer data,
+                           const std::size_t count,
+                           const std::size_t offset,
+                           const uint32b queue_index) const
+{
+  static_assert(std::is_trivially_copyable_v<Type>,
+                "The buffer type isn't trivially copyable.");
+  ZISC_ASSERT((offset + count) <= size(), "The range is out of bounds.");
+  const std::size_t offset_size = sizeof(Type) * offset;
+  const std::size_t s = sizeof(Type) * count;
+  auto& device = const_cast<VulkanDevice&>(parentImpl());
+  beginTransfer();
+  markUsed();
+  if (isHostVisible()) {
+    const auto& info = allocationInfo();
+    ZISC_ASSERT(info.pMappedData != nullptr, "The buffer isn't mapped.");
+    if (!isHostCoherent())
+      vmaInvalidateAllocation(device.memoryAllocator(), allocation(),
+                              offset() + offset_size, s);
+    const auto mapped_memory = zisc::cast<const uint8b*>(info.pMappedData);
+    std::memcpy(data, mapped_memory + offset_size, s);
+  }
+  else {
+    device.readBuffer(buffer(), offset() + offset_size, s, data, queue_index);
+  }
+  endTransfer();
+}
+
+/*!
+  \details The buffer handles are recorded, so the buffers must not be
+  resized until the command list is cleared. The device doesn't evict the
+  buffers until then
+
+  \param [in,out] command_list No description.
+  \param [out] dst No description.
+  \param [in] count No description.
+  \param [in] src_offset No description.
+  \param [in] dst_offset No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::recordCopyTo(CommandList* command_list,
+                                   Buffer<T>* dst,
+                                   const std::size_t count,
+                                   const std::size_t src_offset,
+                                   const std::size_t dst_offset) const
+{
+  ZISC_ASSERT(command_list->type() == SubPlatformType::kVulkan,
+              "The command list isn't a vulkan command list.");
+  ZISC_ASSERT(dst->type() == SubPlatformType::kVulkan,
+              "The dst buffer isn't a vulkan buffer.");
+  ZISC_ASSERT((src_offset + count) <= size(), "The src range is out of bounds.");
+  ZISC_ASSERT((dst_offset + count) <= dst->size(), "The dst range is out of bounds.");
+  auto list = zisc::cast<VulkanCommandList*>(command_list);
+  auto dst_buffer = zisc::cast<VulkanBuffer*>(dst);
+  // The buffers are pinned before the handles are taken
+  auto& device = const_cast<VulkanDevice&>(parentImpl());
+  device.pinBuffer(this, list);
+  device.pinBuffer(dst_buffer, list);
+  markUsed();
+  dst_buffer->markUsed();
+  const VkBufferCopy region{offset() + sizeof(Type) * src_offset,
+                            dst_buffer->offset() + sizeof(Type) * dst_offset,
+                            sizeof(Type) * count};
+  list->copyBuffer(buffer(), dst_buffer->buffer(), region);
+}
+
+/*!
+  \details The elements are kept
+
+  \param [in] s No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::reserve(const std::size_t s)
+{
+  if (capacity() < s)
+    reallocate(s);
+}
+
+/*!
+  \details The memory is reallocated only if the size exceeds the capacity,
+  so shrinking the buffer doesn't release the memory. The elements are kept
+  and the new elements are left uninitialized
 
   \param [in] s No description.
   */
 template <typename T> inline
 void VulkanBuffer<T>::setSize(const std::size_t s)
 {
-  const std::size_t prev_size = size();
-  if (s != prev_size) {
-    Buffer<T>::clear();
-    if (0 < s) {
-      const std::size_t mem_size = sizeof(Type) * s;
-      auto& device = parentImpl();
-      device.allocateMemory(mem_size,
-                            Buffer<T>::usage(),
-                            std::addressof(Buffer<T>::id()),
-                            std::addressof(buffer()),
-                            std::addressof(allocation()),
-                            std::addressof(vm_alloc_info_));
-    }
-  }
+  if (capacity() < s)
+    reallocate(s);
+  size_ = s;
+}
+
+/*!
+  \details The elements are kept
+  */
+template <typename T> inline
+void VulkanBuffer<T>::shrinkToFit()
+{
+  if (size() < capacity())
+    reallocate(size());
 }
 
 /*!
@@ -187,22 +363,76 @@ void VulkanBuffer<T>::setSize(const std::size_t s)
 template <typename T> inline
 std::size_t VulkanBuffer<T>::size() const noexcept
 {
-  const auto& info = allocationInfo();
-  const std::size_t s = info.size / sizeof(Type);
-  return s;
+  return size_;
 }
 
 /*!
   \details No detailed description
+
+  \return No description
+  */
+template <typename T> inline
+SubPlatformType VulkanBuffer<T>::type() const noexcept
+{
+  return SubPlatformType::kVulkan;
+}
+
+/*!
+  \details A host visible buffer is copied directly to the persistently
+  mapped memory, the commands which access to the buffer must be completed.
+  Otherwise the elements are transferred through a staging buffer of the
+  device on the queue
+
+  \param [in] data No description.
+  \param [in] count No description.
+  \param [in] offset No description.
+  \param [in] queue_index No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::write(ConstPointer data,
+                            const std::size_t count,
+                            const std::size_t offset,
+                            const uint32b queue_index)
+{
+  static_assert(std::is_trivially_copyable_v<Type>,
+                "The buffer type isn't trivially copyable.");
+  ZISC_ASSERT((offset + count) <= size(), "The range is out of bounds.");
+  const std::size_t offset_size = sizeof(Type) * offset;
+  const std::size_t s = sizeof(Type) * count;
+  auto& device = parentImpl();
+  beginTransfer();
+  markUsed();
+  if (isHostVisible()) {
+    const auto& info = allocationInfo();
+    ZISC_ASSERT(info.pMappedData != nullptr, "The buffer isn't mapped.");
+    const auto mapped_memory = zisc::cast<uint8b*>(info.pMappedData);
+    std::memcpy(mapped_memory + offset_size, data, s);
+    if (!isHostCoherent())
+      vmaFlushAllocation(device.memoryAllocator(), allocation(),
+                         offset() + offset_size, s);
+  }
+  else {
+    device.writeBuffer(data, s, buffer(), offset() + offset_size, queue_index);
+  }
+  endTransfer();
+}
+
+/*!
+  \details The range of a frame buffer is released by the reset of
+  the frame pool of the device, so only the registry entry is removed
   */
 template <typename T> inline
 void VulkanBuffer<T>::destroyData() noexcept
 {
   if (buffer_ != VK_NULL_HANDLE) {
     auto& device = parentImpl();
-    device.deallocateMemory(std::addressof(buffer()),
-                            std::addressof(allocation()),
-                            std::addressof(vm_alloc_info_));
+    // The eviction updates the entry, so the entry is removed after it
+    if (!isFrameBuffer())
+      device.removeEvictableBuffer(this);
+    device.memoryRegistry().remove(Buffer<T>::id());
+    if (!isFrameBuffer())
+      device.deallocateMemory(std::addressof(buffer()),
+                              std::addressof(allocation()));
     initData();
   }
 }
@@ -221,6 +451,68 @@ void VulkanBuffer<T>::initData()
   vm_alloc_info_.size = 0;
   vm_alloc_info_.pMappedData = nullptr;
   vm_alloc_info_.pUserData = nullptr;
+  offset_ = 0;
+  size_ = 0;
+  capacity_ = 0;
+}
+
+/*!
+  \details If the device is evicting the buffer, this function waits for the
+  end of the eviction
+  */
+template <typename T> inline
+void VulkanBuffer<T>::beginTransfer() const
+{
+  if (isEvictable()) {
+    auto& device = const_cast<VulkanDevice&>(parentImpl());
+    device.beginBufferTransfer(this);
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+template <typename T> inline
+void VulkanBuffer<T>::endTransfer() const noexcept
+{
+  if (isEvictable()) {
+    auto& device = const_cast<VulkanDevice&>(parentImpl());
+    device.endBufferTransfer(this);
+  }
+}
+
+/*!
+  \details The elements are copied to host memory on the queue 0. The buffer
+  handle is changed, so the device doesn't evict a buffer which a command
+  list refers. The buffer stays in host memory until it is reallocated
+  */
+template <typename T> inline
+void VulkanBuffer<T>::evict()
+{
+  VkBuffer b = VK_NULL_HANDLE;
+  VmaAllocation vm_allocation = VK_NULL_HANDLE;
+  VmaAllocationInfo alloc_info;
+  auto& device = parentImpl();
+  const bool is_allocated = device.allocateMemory(sizeof(Type) * capacity(),
+                                                  BufferUsage::kHostOnly,
+                                                  std::addressof(Buffer<T>::id()),
+                                                  std::addressof(b),
+                                                  std::addressof(vm_allocation),
+                                                  std::addressof(alloc_info));
+  if (is_allocated) {
+    if (0 < size()) {
+      const VkBufferCopy region{offset(), 0, sizeof(Type) * size()};
+      const auto fence = device.copyBuffer(buffer(), b, region, 0);
+      fence.wait();
+    }
+    device.deallocateMemory(std::addressof(buffer()),
+                            std::addressof(allocation()));
+    buffer_ = b;
+    vm_allocation_ = vm_allocation;
+    vm_alloc_info_ = alloc_info;
+    offset_ = 0;
+    updateMemoryRegistry();
+  }
 }
 
 /*!
@@ -242,6 +534,61 @@ bool VulkanBuffer<T>::hasMemoryProperty(const VkMemoryPropertyFlagBits flag) con
   return has_property;
 }
 
+/*!
+  \details The frame pool mutex of the device is locked
+  */
+template <typename T> inline
+void VulkanBuffer<T>::invalidateFrameRange() noexcept
+{
+  Buffer<T>::clear();
+}
+
+/*!
+  \details The device evicts only device-only buffers which aren't frame
+  buffers. The function doesn't refer the memory, which the device replaces
+  on an eviction
+
+  \return No description
+  */
+template <typename T> inline
+bool VulkanBuffer<T>::isEvictable() const noexcept
+{
+  const bool result = !isFrameBuffer() &&
+                      (Buffer<T>::usage() == BufferUsage::kDeviceOnly);
+  return result;
+}
+
+/*!
+  \details The memory is persistently mapped on the allocation,
+  so only the invalidation is needed for a non coherent memory
+
+  \return No description
+  */
+template <typename T> inline
+auto VulkanBuffer<T>::mappedMemory() const noexcept -> Pointer
+{
+  const auto& info = allocationInfo();
+  ZISC_ASSERT(info.pMappedData != nullptr, "The buffer isn't mapped.");
+  markUsed();
+  if (!isHostCoherent()) {
+    const auto& device = parentImpl();
+    vmaInvalidateAllocation(device.memoryAllocator(), allocation(),
+                            offset(), info.size);
+  }
+  Pointer d = zisc::cast<Pointer>(info.pMappedData);
+  return d;
+}
+
+/*!
+  \details No detailed description
+  */
+template <typename T> inline
+void VulkanBuffer<T>::markUsed() const noexcept
+{
+  auto& device = const_cast<VulkanDevice&>(parentImpl());
+  device.markBufferUsed(this);
+}
+
 /*!
   \details No detailed description
 
@@ -266,6 +613,102 @@ const VulkanDevice& VulkanBuffer<T>::parentImpl() const noexcept
   return *zisc::treatAs<const VulkanDevice*>(p);
 }
 
+/*!
+  \details The elements are copied to the new memory on the queue 0 and
+  this function waits for the completion of the copy. If the memory can't be
+  allocated, the buffer is left unchanged
+
+  \param [in] cap No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::reallocate(const std::size_t cap)
+{
+  if (cap == 0) {
+    Buffer<T>::clear();
+  }
+  else {
+    VkBuffer b = VK_NULL_HANDLE;
+    VmaAllocation vm_allocation = VK_NULL_HANDLE;
+    VmaAllocationInfo alloc_info;
+    std::size_t o = 0;
+    const std::size_t mem_size = sizeof(Type) * cap;
+    auto& device = parentImpl();
+    beginTransfer();
+    const bool is_allocated = isFrameBuffer()
+        ? device.allocateFrameMemory(mem_size,
+                                     Buffer<T>::usage(),
+                                     std::addressof(b),
+                                     std::addressof(vm_allocation),
+                                     std::addressof(alloc_info),
+                                     std::addressof(o))
+        : device.allocateMemory(mem_size,
+                                Buffer<T>::usage(),
+                                std::addressof(Buffer<T>::id()),
+                                std::addressof(b),
+                                std::addressof(vm_allocation),
+                                std::addressof(alloc_info));
+    // The buffer keeps the current memory if the allocation fails
+    if (!is_allocated) {
+      endTransfer();
+      return;
+    }
+    const std::size_t s = std::min(size(), cap);
+    if (0 < s) {
+      const VkBufferCopy region{offset(), o, sizeof(Type) * s};
+      const auto fence = device.copyBuffer(buffer(), b, region, 0);
+      fence.wait();
+    }
+
+    Buffer<T>::clear();
+    endTransfer();
+    buffer_ = b;
+    vm_allocation_ = vm_allocation;
+    vm_alloc_info_ = alloc_info;
+    offset_ = o;
+    size_ = s;
+    capacity_ = cap;
+    updateMemoryRegistry();
+
+    if (isEvictable() && isDeviceLocal())
+      device.addEvictableBuffer(this, vm_alloc_info_);
+  }
+}
+
+/*!
+  \details The memory is kept mapped until the buffer is destroyed,
+  so only the written memory is flushed for a non coherent memory
+
+  \param [in] is_written No description.
+  */
+template <typename T> inline
+void VulkanBuffer<T>::unmapMemory(const bool is_written) const noexcept
+{
+  if (is_written && !isHostCoherent()) {
+    const auto& device = parentImpl();
+    const auto& info = allocationInfo();
+    vmaFlushAllocation(device.memoryAllocator(), allocation(),
+                       offset(), info.size);
+  }
+}
+
+/*!
+  \details The memory of a frame buffer is attributed to the buffer although
+  it's a range of a frame block
+  */
+template <typename T> inline
+void VulkanBuffer<T>::updateMemoryRegistry()
+{
+  auto& device = parentImpl();
+  const auto& mem_props = device.deviceInfoData().memoryProperties().properties1_;
+  const auto& info = allocationInfo();
+  const std::size_t heap_index = mem_props.memoryTypes[info.memoryType].heapIndex;
+  device.memoryRegistry().update(Buffer<T>::id(),
+                                 sizeof(Type) * capacity(),
+                                 Buffer<T>::usage(),
+                                 info.memoryType,
+                                 heap_index);
+}
+
 // Device
 
 /*!
@@ -289,6 +732,30 @@ SharedBuffer<T> VulkanDevice::makeBuffer(const BufferUsage flag)
   return buffer;
 }
 
+/*!
+  \details The memory of the buffer is a range of a frame block, which is
+  allocated linearly. The buffer is cleared by resetFramePool()
+
+  \tparam T No description.
+  \param [in] flag No description.
+  \return No description
+  */
+template <typename T> inline
+SharedBuffer<T> VulkanDevice::makeFrameBuffer(const BufferUsage flag)
+{
+  using BufferType = VulkanBuffer<T>;
+  zisc::pmr::polymorphic_allocator<BufferType> alloc{memoryResource()};
+  auto buffer = std::allocate_shared<BufferType>(alloc, issueId());
+  buffer->is_frame_buffer_ = true;
+
+  ZinvulObject::SharedPtr parent{getOwn()};
+  WeakBuffer<T> own{buffer};
+  buffer->initialize(std::move(parent), std::move(own), flag);
+  addFrameBuffer(buffer.get());
+
+  return buffer;
+}
+
 } // namespace zinvul
 
 #endif // ZINVUL_VULKAN_BUFFER_INL_HPP
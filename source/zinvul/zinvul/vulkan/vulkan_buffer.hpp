@@ -25,17 +25,30 @@
 // Zisc
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
+#include "vulkan_device.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
 
 namespace zinvul {
 
 // Forward declaration
-class VulkanDevice;
+class CommandList;
 
+/*!
+  \brief No brief description
+
+  A device-only buffer is evicted to host memory by the device when the
+  device memory exceeds the budget, unless a command list refers it.
+  A frame buffer is cleared by the device when the frame pool is reset.
+
+  \tparam T No description.
+  */
 template <typename T>
-class VulkanBuffer : public Buffer<T>
+class VulkanBuffer : public Buffer<T>,
+                     private VulkanDevice::EvictableBuffer,
+                     private VulkanDevice::FrameBuffer
 {
  public:
   // Type aliases
@@ -67,9 +80,22 @@ class VulkanBuffer : public Buffer<T>
   //! Return the buffer data
   const VkBuffer& buffer() const noexcept;
 
+  //! Return the number of elements which the buffer can hold without reallocation
+  std::size_t capacity() const noexcept override;
+
+  //! Copy the elements of the buffer to the dst buffer on the queue
+  Fence copyTo(Buffer<T>* dst,
+               const std::size_t count,
+               const std::size_t src_offset,
+               const std::size_t dst_offset,
+               const uint32b queue_index) const override;
+
   //! Check if the buffer is the most efficient for the device access
   bool isDeviceLocal() const noexcept override;
 
+  //! Check if the buffer is sub-allocated from the frame pool of the device
+  bool isFrameBuffer() const noexcept;
+
   //! Check if the buffer is cached on the host
   bool isHostCached() const noexcept override;
 
@@ -79,12 +105,43 @@ class VulkanBuffer : public Buffer<T>
   //! Check if the buffer can be mapped for the host access
   bool isHostVisible() const noexcept override;
 
-  //! Change the number of elements
+  //! Return the offset of the buffer range in the underlying buffer in bytes
+  std::size_t offset() const noexcept;
+
+  //! Read the elements of the buffer to the host memory
+  void read(Pointer data,
+            const std::size_t count,
+            const std::size_t offset,
+            const uint32b queue_index) const override;
+
+  //! Record a copy of the elements of the buffer to the dst buffer in the list
+  void recordCopyTo(CommandList* command_list,
+                    Buffer<T>* dst,
+                    const std::size_t count,
+                    const std::size_t src_offset,
+                    const std::size_t dst_offset) const override;
+
+  //! Reserve the memory for at least the given number of elements
+  void reserve(const std::size_t s) override;
+
+  //! Change the number of elements without initializing the new elements
   void setSize(const std::size_t s) override;
 
+  //! Release the memory which isn't used by the elements
+  void shrinkToFit() override;
+
   //! Return the number of elements
   std::size_t size() const noexcept override;
 
+  //! Return the sub-platform type of the buffer
+  SubPlatformType type() const noexcept override;
+
+  //! Write the elements of the host memory to the buffer
+  void write(ConstPointer data,
+             const std::size_t count,
+             const std::size_t offset,
+             const uint32b queue_index) override;
+
  protected:
   //! Clear the contents of the buffer
   void destroyData() noexcept override;
@@ -93,19 +150,56 @@ class VulkanBuffer : public Buffer<T>
   void initData() override;
 
  private:
+  friend VulkanDevice;
+
+
+  //! Keep the buffer in device memory during a transfer of the elements
+  void beginTransfer() const;
+
+  //! Finish the transfer of the elements
+  void endTransfer() const noexcept;
+
+  //! Move the memory of the buffer to host memory
+  void evict() override;
+
   //! Check if the buffer has the given memory property flag
   bool hasMemoryProperty(const VkMemoryPropertyFlagBits flag) const noexcept;
 
+  //! Release the range of the frame buffer
+  void invalidateFrameRange() noexcept override;
+
+  //! Check if the device can evict the buffer
+  bool isEvictable() const noexcept;
+
+  //! Return the pointer to the mapped memory of the buffer
+  Pointer mappedMemory() const noexcept override;
+
+  //! Mark the buffer as used for the eviction order of the device
+  void markUsed() const noexcept;
+
   //! Return the device
   VulkanDevice& parentImpl() noexcept;
 
   //! Return the device
   const VulkanDevice& parentImpl() const noexcept;
 
+  //! Reallocate the memory with the given capacity and keep the elements
+  void reallocate(const std::size_t cap);
+
+  //! Release the mapped memory of the buffer
+  void unmapMemory(const bool is_written) const noexcept override;
+
+  //! Update the entry of the buffer in the memory registry of the device
+  void updateMemoryRegistry();
+
 
   VkBuffer buffer_ = VK_NULL_HANDLE;
   VmaAllocation vm_allocation_ = VK_NULL_HANDLE;
   VmaAllocationInfo vm_alloc_info_;
+  std::size_t offset_ = 0;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+  bool is_frame_buffer_ = false;
 };
 
 } // namespace zinvul
@@ -0,0 +1,271 @@
+/*!
+  \file vulkan_command_list.cpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#include "vulkan_command_list.hpp"
+// Standard C++ library
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <utility>
+// Vulkan
+#include <vulkan/vulkan.h>
+// Zisc
+#include "zisc/std_memory_resource.hpp"
+#include "zisc/utility.hpp"
+// Zinvul
+#include "vulkan_device.hpp"
+#include "vulkan_sub_platform.hpp"
+#include "utility/vulkan.hpp"
+#include "utility/vulkan_dispatch_loader.hpp"
+#include "zinvul/command_list.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/utility/id_data.hpp"
+#include "zinvul/utility/zinvul_object.hpp"
+
+namespace zinvul {
+
+/*!
+  \details No detailed description
+
+  \param [in] id No description.
+  */
+VulkanCommandList::VulkanCommandList(IdData&& id) noexcept :
+    CommandList(std::move(id))
+{
+}
+
+/*!
+  \details No detailed description
+  */
+VulkanCommandList::~VulkanCommandList() noexcept
+{
+  destroy();
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+const VkCommandBuffer& VulkanCommandList::commandBuffer() const noexcept
+{
+  return command_buffer_;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] src No description.
+  \param [in] dst No description.
+  \param [in] region No description.
+  */
+void VulkanCommandList::copyBuffer(const VkBuffer& src,
+                                   const VkBuffer& dst,
+                                   const VkBufferCopy& region)
+{
+  beginCommand();
+  const auto loader = parentImpl().dispatcher().loaderImpl();
+  zinvulvk::CommandBuffer command{command_buffer_};
+  const auto copy_region = zisc::treatAs<const zinvulvk::BufferCopy*>(
+      std::addressof(region));
+  command.copyBuffer(zinvulvk::Buffer{src},
+                     zinvulvk::Buffer{dst},
+                     1,
+                     copy_region,
+                     *loader);
+  ++num_of_commands_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+std::size_t VulkanCommandList::numOfCommands() const noexcept
+{
+  return num_of_commands_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+SubPlatformType VulkanCommandList::type() const noexcept
+{
+  return SubPlatformType::kVulkan;
+}
+
+/*!
+  \details The command buffer is kept for the next recording. The recorded
+  buffers can be evicted again
+  */
+void VulkanCommandList::clearCommands() noexcept
+{
+  if (zinvulvk::CommandBuffer{command_buffer_}) {
+    const auto loader = parentImpl().dispatcher().loaderImpl();
+    zinvulvk::CommandBuffer command{command_buffer_};
+    if (is_recording_)
+      command.end(*loader);
+    command.reset(zinvulvk::CommandBufferResetFlags{}, *loader);
+    parentImpl().unpinBuffers(this);
+  }
+  num_of_commands_ = 0;
+  is_recording_ = false;
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanCommandList::destroyData() noexcept
+{
+  clearCommands();
+  if (zinvulvk::CommandPool{command_pool_}) {
+    auto& device = parentImpl();
+    zinvulvk::Device d{device.device()};
+    zinvulvk::AllocationCallbacks alloc{device.parentImpl().makeAllocator()};
+    const auto loader = device.dispatcher().loaderImpl();
+    // The command buffer is freed with the pool
+    d.destroyCommandPool(zinvulvk::CommandPool{command_pool_}, alloc, *loader);
+    command_pool_ = VK_NULL_HANDLE;
+    command_buffer_ = VK_NULL_HANDLE;
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanCommandList::initData()
+{
+  auto& device = parentImpl();
+  zinvulvk::Device d{device.device()};
+  zinvulvk::AllocationCallbacks alloc{device.parentImpl().makeAllocator()};
+  const auto loader = device.dispatcher().loaderImpl();
+  const zinvulvk::CommandPoolCreateInfo create_info{
+      zinvulvk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+      device.queueFamilyIndex()};
+  auto command_pool = d.createCommandPool(create_info, alloc, *loader);
+  command_pool_ = zisc::cast<VkCommandPool>(command_pool);
+
+  const zinvulvk::CommandBufferAllocateInfo alloc_info{
+      zinvulvk::CommandPool{command_pool_},
+      zinvulvk::CommandBufferLevel::ePrimary,
+      1};
+  zinvulvk::CommandBuffer command;
+  const auto r = d.allocateCommandBuffers(std::addressof(alloc_info),
+                                          std::addressof(command),
+                                          *loader);
+  if (r != zinvulvk::Result::eSuccess) {
+    //! \todo Handle exception
+    printf("[Warning]: Command buffer allocation failed.\n");
+  }
+  command_buffer_ = zisc::cast<VkCommandBuffer>(command);
+}
+
+/*!
+  \details The recording is finished at the first replay. The command buffer
+  can be pending in several replays at the same time
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+Fence VulkanCommandList::replayCommands(const uint32b queue_index)
+{
+  auto& device = parentImpl();
+  if (is_recording_) {
+    const auto loader = device.dispatcher().loaderImpl();
+    zinvulvk::CommandBuffer command{command_buffer_};
+    command.end(*loader);
+    is_recording_ = false;
+  }
+  const auto fence = device.submit(queue_index, command_buffer_);
+  return fence;
+}
+
+/*!
+  \details A recording is begun at the first command. The later commands
+  wait for the memory writes of the previous commands
+  */
+void VulkanCommandList::beginCommand()
+{
+  const auto loader = parentImpl().dispatcher().loaderImpl();
+  zinvulvk::CommandBuffer command{command_buffer_};
+  if (!is_recording_) {
+    const zinvulvk::CommandBufferBeginInfo begin_info{
+        zinvulvk::CommandBufferUsageFlagBits::eSimultaneousUse};
+    command.begin(begin_info, *loader);
+    is_recording_ = true;
+  }
+  else {
+    const zinvulvk::MemoryBarrier barrier{
+        zinvulvk::AccessFlagBits::eMemoryWrite,
+        zinvulvk::AccessFlagBits::eMemoryRead |
+        zinvulvk::AccessFlagBits::eMemoryWrite};
+    command.pipelineBarrier(zinvulvk::PipelineStageFlagBits::eAllCommands,
+                            zinvulvk::PipelineStageFlagBits::eAllCommands,
+                            zinvulvk::DependencyFlags{},
+                            1,
+                            std::addressof(barrier),
+                            0,
+                            nullptr,
+                            0,
+                            nullptr,
+                            *loader);
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+VulkanDevice& VulkanCommandList::parentImpl() noexcept
+{
+  auto p = getParent();
+  return *zisc::treatAs<VulkanDevice*>(p);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+const VulkanDevice& VulkanCommandList::parentImpl() const noexcept
+{
+  const auto p = getParent();
+  return *zisc::treatAs<const VulkanDevice*>(p);
+}
+
+// Device
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+SharedCommandList VulkanDevice::makeCommandList()
+{
+  zisc::pmr::polymorphic_allocator<VulkanCommandList> alloc{memoryResource()};
+  std::shared_ptr<VulkanCommandList> list =
+      std::allocate_shared<VulkanCommandList>(alloc, issueId());
+
+  ZinvulObject::SharedPtr parent{getOwn()};
+  WeakCommandList own{list};
+  list->initialize(std::move(parent), std::move(own));
+
+  return list;
+}
+
+} // namespace zinvul
@@ -0,0 +1,98 @@
+/*!
+  \file vulkan_command_list.hpp
+  \author Sho Ikeda
+  \brief No brief description
+
+  \details
+  No detailed description.
+
+  \copyright
+  Copyright (c) 2015-2020 Sho Ikeda
+  This software is released under the MIT License.
+  http://opensource.org/licenses/mit-license.php
+  */
+
+#ifndef ZINVUL_VULKAN_COMMAND_LIST_HPP
+#define ZINVUL_VULKAN_COMMAND_LIST_HPP
+
+// Standard C++ library
+#include <cstddef>
+// Vulkan
+#include <vulkan/vulkan.h>
+// Zinvul
+#include "zinvul/command_list.hpp"
+#include "zinvul/fence.hpp"
+#include "zinvul/zinvul_config.hpp"
+#include "zinvul/utility/id_data.hpp"
+
+namespace zinvul {
+
+// Forward declaration
+class VulkanDevice;
+
+/*!
+  \brief A command list of a vulkan device
+
+  The commands are recorded in a command buffer which is submitted at each
+  replay without recording again. The command buffer is allocated from the
+  own command pool of the list, so lists can be recorded on different
+  threads. A barrier is placed between the commands so that they are
+  executed in order.
+  */
+class VulkanCommandList : public CommandList
+{
+ public:
+  //! Initialize the command list
+  VulkanCommandList(IdData&& id) noexcept;
+
+  //! Finalize the command list
+  ~VulkanCommandList() noexcept override;
+
+
+  //! Return the underlying command buffer
+  const VkCommandBuffer& commandBuffer() const noexcept;
+
+  //! Record a copy command
+  void copyBuffer(const VkBuffer& src,
+                  const VkBuffer& dst,
+                  const VkBufferCopy& region);
+
+  //! Return the number of recorded commands
+  std::size_t numOfCommands() const noexcept override;
+
+  //! Return the sub-platform type of the command list
+  SubPlatformType type() const noexcept override;
+
+ protected:
+  //! Remove all recorded commands of the device
+  void clearCommands() noexcept override;
+
+  //! Clear the contents of the command list
+  void destroyData() noexcept override;
+
+  //! Initialize the command list
+  void initData() override;
+
+  //! Submit the recorded commands of the device to the queue
+  Fence replayCommands(const uint32b queue_index) override;
+
+ private:
+  //! Prepare the command buffer for the next command
+  void beginCommand();
+
+  //! Return the device
+  VulkanDevice& parentImpl() noexcept;
+
+  //! Return the device
+  const VulkanDevice& parentImpl() const noexcept;
+
+
+  VkCommandPool command_pool_ = VK_NULL_HANDLE;
+  VkCommandBuffer command_buffer_ = VK_NULL_HANDLE;
+  std::size_t num_of_commands_ = 0;
+  bool is_recording_ = false;
+};
+
+} // namespace zinvul
+
+#endif // ZINVUL_VULKAN_COMMAND_LIST_HPP
@@ -31,6 +31,28 @@
 
 namespace zinvul {
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+VkCommandPool& VulkanDevice::commandPool() noexcept
+{
+  return command_pool_;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+const VkCommandPool& VulkanDevice::commandPool() const noexcept
+{
+  return command_pool_;
+}
+
 /*!
   \details No detailed description
 
@@ -110,6 +132,66 @@ const VmaAllocator& VulkanDevice::memoryAllocator() const noexcept
   return vm_allocator_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr std::size_t VulkanDevice::bufferPoolBlockSize() noexcept
+{
+  const std::size_t size = 16 * 1024 * 1024;
+  return size;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr std::size_t VulkanDevice::maxNumOfStagingBuffers() noexcept
+{
+  const std::size_t n = 4;
+  return n;
+}
+
+/*!
+  \details Larger buffers are allocated from the default pools of VMA
+
+  \return No description
+  */
+inline
+constexpr std::size_t VulkanDevice::maxPoolBufferSize() noexcept
+{
+  const std::size_t size = 256 * 1024;
+  return size;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr std::size_t VulkanDevice::minFrameBlockSize() noexcept
+{
+  const std::size_t size = 4 * 1024 * 1024;
+  return size;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+constexpr std::size_t VulkanDevice::minStagingBufferSize() noexcept
+{
+  const std::size_t size = 64 * 1024;
+  return size;
+}
+
 /*!
   \details No detailed description
 
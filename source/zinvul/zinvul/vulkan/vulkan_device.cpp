@@ -15,10 +15,14 @@
 #include "vulkan_device.hpp"
 // Standard C++ library
 #include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <tuple>
 #include <utility>
@@ -37,6 +41,7 @@
 #include "utility/vulkan.hpp"
 #include "utility/vulkan_dispatch_loader.hpp"
 #include "zinvul/device_info.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
 
@@ -64,7 +69,11 @@ VulkanDevice::~VulkanDevice() noexcept
 }
 
 /*!
-  \details No detailed description
+  \details A buffer which is smaller than maxPoolBufferSize() is
+  sub-allocated from the buffer pool of the usage, so that small buffers
+  don't allocate device memory one by one. A device-only buffer which doesn't
+  fit in the memory budget is placed in host memory, so the device gets slower
+  instead of running out of memory
 
   \param [in] size No description.
   \param [in] buffer_usage No description.
@@ -72,64 +81,121 @@ VulkanDevice::~VulkanDevice() noexcept
   \param [out] buffer No description.
   \param [out] vm_allocation No description.
   \param [out] alloc_info No description.
+  \return True if the memory is allocated
   */
-void VulkanDevice::allocateMemory(const std::size_t size,
+bool VulkanDevice::allocateMemory(const std::size_t size,
                                   const BufferUsage buffer_usage,
                                   void* user_data,
                                   VkBuffer* buffer,
                                   VmaAllocation* vm_allocation,
                                   VmaAllocationInfo* alloc_info)
 {
-  // Buffer create info
-  zinvulvk::BufferCreateInfo buffer_create_info;
-  buffer_create_info.size = size;
-  buffer_create_info.usage = zinvulvk::BufferUsageFlagBits::eTransferSrc |
-                             zinvulvk::BufferUsageFlagBits::eTransferDst |
-                             zinvulvk::BufferUsageFlagBits::eStorageBuffer;
-  buffer_create_info.sharingMode = zinvulvk::SharingMode::eExclusive;
-  const uint32b queue_family_index = queueFamilyIndex();
-  buffer_create_info.queueFamilyIndexCount = 1;
-  buffer_create_info.pQueueFamilyIndices = std::addressof(queue_family_index);
+  const VkBufferCreateInfo binfo = makeBufferCreateInfo(size);
 
   // VMA allocation create info
   VmaAllocationCreateInfo alloc_create_info;
-  alloc_create_info.flags = 0;
-  switch (buffer_usage) {
-   case BufferUsage::kDeviceOnly: {
-    alloc_create_info.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    break;
-   }
-   case BufferUsage::kHostOnly: {
-    alloc_create_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-    break;
-   }
-   case BufferUsage::kHostToDevice: {
-    alloc_create_info.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-    break;
-   }
-   case BufferUsage::kDeviceToHost: {
-    alloc_create_info.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
-    break;
-   }
-  }
+  // Host visible memory is mapped for the lifetime of the allocation.
+  // The flag is ignored if the memory type isn't host visible
+  alloc_create_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  alloc_create_info.usage = getVmaMemoryUsage(buffer_usage);
   alloc_create_info.requiredFlags = 0;
   alloc_create_info.preferredFlags = 0;
   alloc_create_info.memoryTypeBits = 0;
-  alloc_create_info.pool = VK_NULL_HANDLE;
+  alloc_create_info.pool = (size <= maxPoolBufferSize())
+      ? buffer_pool_list_[getBufferUsageIndex(buffer_usage)]
+      : VK_NULL_HANDLE;
   alloc_create_info.pUserData = user_data;
 
-  // 
-  const auto binfo = zisc::cast<VkBufferCreateInfo>(buffer_create_info);
-  const auto result = vmaCreateBuffer(memoryAllocator(),
-                                      std::addressof(binfo),
-                                      std::addressof(alloc_create_info),
-                                      buffer,
-                                      vm_allocation,
-                                      alloc_info);
-  if (result != VK_SUCCESS) {
+  const bool is_device_only = buffer_usage == BufferUsage::kDeviceOnly;
+  const bool is_in_budget = !is_device_only ||
+                            reserveDeviceMemory(binfo, alloc_create_info);
+  VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+  if (is_in_budget) {
+    result = vmaCreateBuffer(memoryAllocator(),
+                             std::addressof(binfo),
+                             std::addressof(alloc_create_info),
+                             buffer,
+                             vm_allocation,
+                             alloc_info);
+  }
+  if ((result != VK_SUCCESS) && is_device_only) {
+    alloc_create_info.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    alloc_create_info.pool = VK_NULL_HANDLE;
+    result = vmaCreateBuffer(memoryAllocator(),
+                             std::addressof(binfo),
+                             std::addressof(alloc_create_info),
+                             buffer,
+                             vm_allocation,
+                             alloc_info);
+  }
+  const bool is_allocated = result == VK_SUCCESS;
+  if (!is_allocated) {
     //! \todo Handle exception
     printf("[Warning]: Device memory allocation failed.\n");
+    *buffer = VK_NULL_HANDLE;
+    *vm_allocation = VK_NULL_HANDLE;
+  }
+  return is_allocated;
+}
+
+/*!
+  \details The range shares the buffer and the allocation of a frame block,
+  and the allocation info describes the range. The range is valid until
+  resetFramePool() is called. If a new block can't be allocated, the pool
+  isn't changed
+
+  \param [in] size No description.
+  \param [in] buffer_usage No description.
+  \param [out] buffer No description.
+  \param [out] vm_allocation No description.
+  \param [out] alloc_info No description.
+  \param [out] offset No description.
+  \return True if the range is allocated
+  */
+bool VulkanDevice::allocateFrameMemory(const std::size_t size,
+                                       const BufferUsage buffer_usage,
+                                       VkBuffer* buffer,
+                                       VmaAllocation* vm_allocation,
+                                       VmaAllocationInfo* alloc_info,
+                                       std::size_t* offset)
+{
+  const std::size_t alignment = frameBufferAlignment();
+  std::unique_lock<std::mutex> lock{frame_mutex_};
+  auto& pool = (*frame_pool_list_)[getBufferUsageIndex(buffer_usage)];
+  std::size_t o = ((pool.used_size_ + alignment - 1) / alignment) * alignment;
+  if (pool.block_list_.empty() ||
+      (pool.block_list_.back().vm_alloc_info_.size < (o + size))) {
+    std::size_t s = std::max(minFrameBlockSize(), pool.reserved_size_);
+    while (s < size)
+      s = s << 1;
+    FrameBlock block;
+    const bool is_allocated = allocateMemory(s,
+                                             buffer_usage,
+                                             nullptr,
+                                             std::addressof(block.buffer_),
+                                             std::addressof(block.vm_allocation_),
+                                             std::addressof(block.vm_alloc_info_));
+    if (!is_allocated) {
+      *buffer = VK_NULL_HANDLE;
+      *vm_allocation = VK_NULL_HANDLE;
+      *offset = 0;
+      return false;
+    }
+    pool.block_list_.emplace_back(block);
+    o = 0;
   }
+  pool.used_size_ = o + size;
+
+  const auto& block = pool.block_list_.back();
+  *buffer = block.buffer_;
+  *vm_allocation = block.vm_allocation_;
+  *alloc_info = block.vm_alloc_info_;
+  alloc_info->offset += o;
+  alloc_info->size = size;
+  if (alloc_info->pMappedData != nullptr)
+    alloc_info->pMappedData = zisc::cast<uint8b*>(alloc_info->pMappedData) + o;
+  *offset = o;
+  return true;
 }
 
 ///*!
@@ -170,12 +236,19 @@ void VulkanDevice::allocateMemory(const std::size_t size,
 //  return command_pool_list_[ref_index];
 //}
 
+/*!
+  \details No detailed description
+
+  \param [in,out] buffer No description.
+  \param [in,out] vm_allocation No description.
+  */
 void VulkanDevice::deallocateMemory(VkBuffer* buffer,
-                                    VmaAllocation* vm_allocation,
-                                    VmaAllocationInfo* alloc_info) noexcept
+                                    VmaAllocation* vm_allocation) noexcept
 {
   if (zinvulvk::Buffer{*buffer}) {
     vmaDestroyBuffer(memoryAllocator(), *buffer, *vm_allocation);
+    *buffer = VK_NULL_HANDLE;
+    *vm_allocation = VK_NULL_HANDLE;
   }
 }
 
@@ -206,6 +279,80 @@ void VulkanDevice::deallocateMemory(VkBuffer* buffer,
 //  }
 //}
 
+/*!
+  \details The copy is executed asynchronously after the commands which
+  were submitted to the queue before
+
+  \param [in] src No description.
+  \param [in] dst No description.
+  \param [in] region No description.
+  \param [in] queue_index No description.
+  \return No description
+  */
+Fence VulkanDevice::copyBuffer(const VkBuffer& src,
+                               const VkBuffer& dst,
+                               const VkBufferCopy& region,
+                               const uint32b queue_index)
+{
+  auto& queue = getQueue(queue_index);
+  const uint64b number = queue.copyBuffer(src, dst, region);
+  return Fence{this, queue_index, number};
+}
+
+/*!
+  \details The semaphore is signaled after all commands which were submitted
+  to the queue of the fence, so the wait may be longer than required.
+  A fence of another device is waited on the host
+
+  \param [in] queue_index No description.
+  \param [in] fence No description.
+  */
+void VulkanDevice::enqueueWait(const uint32b queue_index, const Fence& fence) noexcept
+{
+  if (!fence || fence.isCompleted())
+    return;
+  if (fence.device() != this) {
+    fence.wait();
+    return;
+  }
+  auto& dst = getQueue(queue_index);
+  auto& src = getQueue(fence.queueIndex());
+  // The queues are locked one by one so that two waits don't deadlock
+  const VkSemaphore semaphore = dst.takeSemaphore();
+  src.signal(semaphore);
+  dst.addWaitSemaphore(semaphore);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] fence No description.
+  \return No description
+  */
+bool VulkanDevice::isCompleted(const Fence& fence) const noexcept
+{
+  ZISC_ASSERT(fence.device() == this, "The fence isn't of the device.");
+  auto& queue = getQueue(fence.queueIndex());
+  const bool result = queue.isCompleted(fence.number());
+  return result;
+}
+
+/*!
+  \details The commands of a lost device never complete, so the waits of
+  the device return without the completion
+
+  \return No description
+  */
+bool VulkanDevice::isLost() const noexcept
+{
+  bool result = false;
+  if (queue_list_) {
+    for (const auto& queue : *queue_list_)
+      result = result || queue->isLost();
+  }
+  return result;
+}
+
 /*!
   \details No detailed description
 
@@ -238,6 +385,71 @@ std::size_t VulkanDevice::peakMemoryUsage(const std::size_t number) const noexce
   return s;
 }
 
+/*!
+  \details The data is copied to a staging buffer on the queue, so the copy
+  is executed after the commands which were submitted to the queue before.
+  This function waits for the completion of the copy
+
+  \param [in] src No description.
+  \param [in] offset No description.
+  \param [in] size No description.
+  \param [out] data No description.
+  \param [in] queue_index No description.
+  */
+void VulkanDevice::readBuffer(const VkBuffer& src,
+                              const std::size_t offset,
+                              const std::size_t size,
+                              void* data,
+                              const uint32b queue_index)
+{
+  if (0 < size) {
+    auto staging_buffer = takeStagingBuffer(size, BufferUsage::kDeviceToHost);
+    const VkBufferCopy region{offset, 0, size};
+    const auto fence = copyBuffer(src, staging_buffer.buffer_, region, queue_index);
+    waitForCompletion(fence);
+
+    const void* mapped_memory = staging_buffer.vm_alloc_info_.pMappedData;
+    ZISC_ASSERT(mapped_memory != nullptr, "The staging buffer isn't mapped.");
+    // VMA invalidates the memory only if it isn't host coherent
+    vmaInvalidateAllocation(memoryAllocator(), staging_buffer.vm_allocation_,
+                            0, size);
+    std::memcpy(data, mapped_memory, size);
+    returnStagingBuffer(staging_buffer);
+  }
+}
+
+/*!
+  \details The device waits for the completion of all commands first.
+  The live frame buffers are cleared, so their size and capacity become 0 and
+  they don't refer the blocks anymore. If a frame pool had several blocks,
+  they are merged into one block at the next allocation
+  */
+void VulkanDevice::resetFramePool() noexcept
+{
+  waitForCompletion();
+
+  std::unique_lock<std::mutex> lock{frame_mutex_};
+  if (frame_buffer_list_) {
+    for (auto buffer : *frame_buffer_list_)
+      buffer->invalidateFrameRange();
+  }
+  if (frame_pool_list_) {
+    for (auto& pool : *frame_pool_list_) {
+      if (1 < pool.block_list_.size()) {
+        std::size_t total_size = 0;
+        for (auto& block : pool.block_list_) {
+          total_size += block.vm_alloc_info_.size;
+          deallocateMemory(std::addressof(block.buffer_),
+                           std::addressof(block.vm_allocation_));
+        }
+        pool.block_list_.clear();
+        pool.reserved_size_ = total_size;
+      }
+      pool.used_size_ = 0;
+    }
+  }
+}
+
 /*!
   \details No detailed description
 
@@ -254,11 +466,114 @@ std::size_t VulkanDevice::totalMemoryUsage(const std::size_t number) const noexc
   return s;
 }
 
+/*!
+  \details The command buffer is executed asynchronously after the commands
+  which were submitted to the queue before
+
+  \param [in] queue_index No description.
+  \param [in] command_buffer No description.
+  \return No description
+  */
+Fence VulkanDevice::submit(const uint32b queue_index,
+                           const VkCommandBuffer& command_buffer)
+{
+  auto& queue = getQueue(queue_index);
+  const uint64b number = queue.submit(command_buffer);
+  return Fence{this, queue_index, number};
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanDevice::waitForCompletion() const noexcept
+{
+  const std::size_t num_of_queues = numOfQueues();
+  for (std::size_t i = 0; i < num_of_queues; ++i)
+    waitForCompletion(zisc::cast<uint32b>(i));
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] queue_index No description.
+  */
+void VulkanDevice::waitForCompletion(const uint32b queue_index) const noexcept
+{
+  auto& queue = getQueue(queue_index);
+  queue.wait(queue.submittedNumber());
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] fence No description.
+  */
+void VulkanDevice::waitForCompletion(const Fence& fence) const noexcept
+{
+  ZISC_ASSERT(fence.device() == this, "The fence isn't of the device.");
+  auto& queue = getQueue(fence.queueIndex());
+  queue.wait(fence.number());
+}
+
+/*!
+  \details The data is copied from a staging buffer on the queue, so the copy
+  is executed after the commands which were submitted to the queue before.
+  This function waits for the completion of the copy
+
+  \param [in] data No description.
+  \param [in] size No description.
+  \param [in] dst No description.
+  \param [in] offset No description.
+  \param [in] queue_index No description.
+  */
+void VulkanDevice::writeBuffer(const void* data,
+                               const std::size_t size,
+                               const VkBuffer& dst,
+                               const std::size_t offset,
+                               const uint32b queue_index)
+{
+  if (0 < size) {
+    auto staging_buffer = takeStagingBuffer(size, BufferUsage::kHostOnly);
+    void* mapped_memory = staging_buffer.vm_alloc_info_.pMappedData;
+    ZISC_ASSERT(mapped_memory != nullptr, "The staging buffer isn't mapped.");
+    std::memcpy(mapped_memory, data, size);
+    // VMA flushes the memory only if it isn't host coherent
+    vmaFlushAllocation(memoryAllocator(), staging_buffer.vm_allocation_,
+                       0, size);
+
+    const VkBufferCopy region{0, offset, size};
+    const auto fence = copyBuffer(staging_buffer.buffer_, dst, region, queue_index);
+    waitForCompletion(fence);
+    returnStagingBuffer(staging_buffer);
+  }
+}
+
 /*!
   \details No detailed description
   */
 void VulkanDevice::destroyData() noexcept
 {
+  if (queue_list_) {
+    // A queue may signal a semaphore which is owned by another queue
+    waitForCompletion();
+    for (auto& queue : *queue_list_)
+      queue->destroy();
+    queue_list_.reset();
+  }
+
+  destroyStagingBuffers();
+  destroyFramePools();
+  destroyBufferPools();
+
+  if (zinvulvk::CommandPool{commandPool()}) {
+    zinvulvk::Device d{device()};
+    auto& sub_platform = parentImpl();
+    zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+    const auto loader = dispatcher().loaderImpl();
+    d.destroyCommandPool(zinvulvk::CommandPool{commandPool()}, alloc, *loader);
+    command_pool_ = VK_NULL_HANDLE;
+  }
+
   queue_family_index_ = invalidQueueIndex();
 
   if (vm_allocator_) {
@@ -295,6 +610,9 @@ void VulkanDevice::destroyData() noexcept
 
   dispatcher_.reset();
   heap_usage_list_.reset();
+  evictable_buffer_list_.reset();
+  pinned_buffer_list_.reset();
+  frame_buffer_list_.reset();
 }
 
 /*!
@@ -314,13 +632,61 @@ void VulkanDevice::initData()
     const auto& info = deviceInfoData();
     heap_usage_list_->resize(info.numOfHeaps());
   }
+  {
+    auto mem_resource = memoryResource();
+    using StagingBufferList = decltype(staging_buffer_list_)::element_type;
+    StagingBufferList buffer_list{
+        StagingBufferList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<StagingBufferList> alloc{mem_resource};
+    staging_buffer_list_ = zisc::pmr::allocateUnique(alloc,
+                                                     std::move(buffer_list));
+  }
+  {
+    auto mem_resource = memoryResource();
+    using FramePoolList = decltype(frame_pool_list_)::element_type;
+    FramePoolList pool_list{FramePoolList::allocator_type{mem_resource}};
+    pool_list.reserve(buffer_pool_list_.size());
+    for (std::size_t i = 0; i < buffer_pool_list_.size(); ++i) {
+      using BlockList = zisc::pmr::vector<FrameBlock>;
+      FramePool pool{BlockList{BlockList::allocator_type{mem_resource}}};
+      pool_list.emplace_back(std::move(pool));
+    }
+    zisc::pmr::polymorphic_allocator<FramePoolList> alloc{mem_resource};
+    frame_pool_list_ = zisc::pmr::allocateUnique(alloc, std::move(pool_list));
+  }
+  {
+    auto mem_resource = memoryResource();
+    using BufferList = decltype(frame_buffer_list_)::element_type;
+    BufferList buffer_list{BufferList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<BufferList> alloc{mem_resource};
+    frame_buffer_list_ = zisc::pmr::allocateUnique(alloc,
+                                                   std::move(buffer_list));
+  }
+  {
+    auto mem_resource = memoryResource();
+    using BufferList = decltype(evictable_buffer_list_)::element_type;
+    BufferList buffer_list{BufferList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<BufferList> alloc{mem_resource};
+    evictable_buffer_list_ = zisc::pmr::allocateUnique(alloc,
+                                                       std::move(buffer_list));
+  }
+  {
+    auto mem_resource = memoryResource();
+    using BufferList = decltype(pinned_buffer_list_)::element_type;
+    BufferList buffer_list{BufferList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<BufferList> alloc{mem_resource};
+    pinned_buffer_list_ = zisc::pmr::allocateUnique(alloc,
+                                                    std::move(buffer_list));
+  }
 
   initDispatcher();
   initLocalWorkGroupSize();
   initQueueFamilyIndexList();
   initDevice();
   initMemoryAllocator();
-//  initCommandPool();
+  initBufferPools();
+  initQueueList();
+  initCommandPool();
 }
 
 ///*!
@@ -417,60 +783,6 @@ void VulkanDevice::initData()
 //  shader_module_list_[index] = shader_module;
 //}
 
-///*!
-//  */
-//inline
-//void VulkanDevice::submit(const QueueType queue_type,
-//                          const uint32b queue_index,
-//                          const vk::CommandBuffer& command) const noexcept
-//{
-//  auto q = getQueue(queue_type, queue_index);
-//  const vk::SubmitInfo info{0, nullptr, nullptr, 1, &command};
-//  const auto result = q.submit(1, &info, nullptr);
-//  ZISC_ASSERT(result == vk::Result::eSuccess, "Command submission failed.");
-//  (void)result;
-//}
-
-///*!
-//  \details No detailed description
-//  */
-//void VulkanDevice::waitForCompletion() const noexcept
-//{
-////  const auto result = device_.waitIdle();
-////  ZISC_ASSERT(result == vk::Result::eSuccess, "Device waiting failed.");
-////  (void)result;
-//}
-//
-///*!
-//  \details No detailed description
-//
-//  \param [in] queue_type No description.
-//  */
-//void VulkanDevice::waitForCompletion(const QueueType queue_type) const noexcept
-//{
-////  const uint32b family_index = queueFamilyIndex(queue_type);
-////  const auto& info = physicalDeviceInfo();
-////  const auto& family_info_list = info.queueFamilyPropertiesList();
-////  const auto& family_info = family_info_list[family_index].properties1_;
-////  for (uint32b i = 0; i < family_info.queueCount; ++i)
-////    waitForCompletion(queue_type, i);
-//}
-//
-///*!
-//  \details No detailed description
-//
-//  \param [in] queue_type No description.
-//  \param [in] queue_index No description.
-//  */
-//void VulkanDevice::waitForCompletion(const QueueType queue_type,
-//                                     const uint32b queue_index) const noexcept
-//{
-////  auto q = getQueue(queue_type, queue_index);
-////  const auto result = q.waitIdle();
-////  ZISC_ASSERT(result == vk::Result::eSuccess, "Queue waiting failed.");
-////  (void)result;
-//}
-
 /*!
   \details No detailed description
 
@@ -537,6 +849,128 @@ void VulkanDevice::Callbacks::notifyOfDeviceMemoryFreeing(
     (*device->heap_usage_list_)[heap_index].release(size);
 }
 
+/*!
+  \details No detailed description
+
+  \param [in,out] buffer No description.
+  \param [in] alloc_info No description.
+  */
+void VulkanDevice::addEvictableBuffer(EvictableBuffer* buffer,
+                                      const VmaAllocationInfo& alloc_info)
+{
+  const auto& mem_props = deviceInfoData().memoryProperties().properties1_;
+  buffer->heap_index_ = mem_props.memoryTypes[alloc_info.memoryType].heapIndex;
+  buffer->memory_size_ = zisc::cast<std::size_t>(alloc_info.size);
+  markBufferUsed(buffer);
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  evictable_buffer_list_->emplace_back(buffer);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::addFrameBuffer(FrameBuffer* buffer)
+{
+  std::unique_lock<std::mutex> lock{frame_mutex_};
+  frame_buffer_list_->emplace_back(buffer);
+}
+
+/*!
+  \details If the buffer is being evicted, the handle which the owner uses is
+  replaced, so the transfer waits for the end of the eviction
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::beginBufferTransfer(const EvictableBuffer* buffer)
+{
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  budget_condition_.wait(lock, [buffer]() noexcept
+  {
+    return !buffer->is_evicting_;
+  });
+  ++buffer->num_of_transfers_;
+}
+
+/*!
+  \details All buffers which are sub-allocated from the pools must be
+  destroyed before
+  */
+void VulkanDevice::destroyBufferPools() noexcept
+{
+  for (auto& pool : buffer_pool_list_) {
+    if (pool != VK_NULL_HANDLE) {
+      vmaDestroyPool(memoryAllocator(), pool);
+      pool = VK_NULL_HANDLE;
+    }
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanDevice::destroyFramePools() noexcept
+{
+  if (frame_pool_list_) {
+    for (auto& pool : *frame_pool_list_) {
+      for (auto& block : pool.block_list_) {
+        deallocateMemory(std::addressof(block.buffer_),
+                         std::addressof(block.vm_allocation_));
+      }
+    }
+    frame_pool_list_.reset();
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanDevice::destroyStagingBuffers() noexcept
+{
+  if (staging_buffer_list_) {
+    for (auto& b : *staging_buffer_list_) {
+      deallocateMemory(std::addressof(b.buffer_),
+                       std::addressof(b.vm_allocation_));
+    }
+    staging_buffer_list_.reset();
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::endBufferTransfer(const EvictableBuffer* buffer) noexcept
+{
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  ZISC_ASSERT(0 < buffer->num_of_transfers_, "The buffer isn't transferred.");
+  --buffer->num_of_transfers_;
+}
+
+/*!
+  \details The budget mutex must not be locked. The buffers must be taken
+  by takeEvictionCandidate() before. The device waits for the completion of
+  all commands once before the eviction, since the commands may still access
+  the buffers. The threads which remove, pin or transfer the buffers wait for
+  the end of the eviction
+
+  \param [in] buffer_list No description.
+  */
+void VulkanDevice::evictBuffers(const zisc::pmr::vector<EvictableBuffer*>& buffer_list)
+{
+  waitForCompletion();
+  for (auto buffer : buffer_list)
+    buffer->evict();
+  {
+    std::unique_lock<std::mutex> lock{budget_mutex_};
+    for (auto buffer : buffer_list)
+      buffer->is_evicting_ = false;
+  }
+  budget_condition_.notify_all();
+}
+
 /*!
   \details No detailed description
 
@@ -591,40 +1025,85 @@ uint32b VulkanDevice::findQueueFamily() const noexcept
 }
 
 /*!
-  \details No detailed description
+  \details A range is aligned so that it can be bound as a storage buffer
 
   \return No description
   */
-VmaVulkanFunctions VulkanDevice::getVmaVulkanFunctions() noexcept
+std::size_t VulkanDevice::frameBufferAlignment() const noexcept
 {
-  const auto loader = dispatcher().loaderImpl();
-  VmaVulkanFunctions functions;
-  functions.vkGetPhysicalDeviceProperties = loader->vkGetPhysicalDeviceProperties;
-  functions.vkGetPhysicalDeviceMemoryProperties = loader->vkGetPhysicalDeviceMemoryProperties;
-  functions.vkAllocateMemory = loader->vkAllocateMemory;
-  functions.vkFreeMemory = loader->vkFreeMemory;
-  functions.vkMapMemory = loader->vkMapMemory;
-  functions.vkUnmapMemory = loader->vkUnmapMemory;
-  functions.vkFlushMappedMemoryRanges = loader->vkFlushMappedMemoryRanges;
-  functions.vkInvalidateMappedMemoryRanges = loader->vkInvalidateMappedMemoryRanges;
-  functions.vkBindBufferMemory = loader->vkBindBufferMemory;
-  functions.vkBindImageMemory = loader->vkBindImageMemory;
-  functions.vkGetBufferMemoryRequirements = loader->vkGetBufferMemoryRequirements;
-  functions.vkGetImageMemoryRequirements = loader->vkGetImageMemoryRequirements;
-  functions.vkCreateBuffer = loader->vkCreateBuffer;
-  functions.vkDestroyBuffer = loader->vkDestroyBuffer;
-  functions.vkCreateImage = loader->vkCreateImage;
-  functions.vkDestroyImage = loader->vkDestroyImage;
-  functions.vkCmdCopyBuffer = loader->vkCmdCopyBuffer;
+  const auto& info = deviceInfoData();
+  const auto& limits = info.properties().properties1_.limits;
+  const std::size_t alignment = std::max(
+      zisc::cast<std::size_t>(limits.minStorageBufferOffsetAlignment),
+      alignof(std::max_align_t));
+  return alignment;
+}
 
-  if (loader->vkGetBufferMemoryRequirements2)
-    functions.vkGetBufferMemoryRequirements2KHR = loader->vkGetBufferMemoryRequirements2;
-  else
-    functions.vkGetBufferMemoryRequirements2KHR = loader->vkGetBufferMemoryRequirements2KHR;
-  if (loader->vkGetImageMemoryRequirements2)
-    functions.vkGetImageMemoryRequirements2KHR = loader->vkGetImageMemoryRequirements2;
-  else 
-    functions.vkGetImageMemoryRequirements2KHR = loader->vkGetImageMemoryRequirements2KHR;
+/*!
+  \details No detailed description
+
+  \param [in] buffer_usage No description.
+  \return No description
+  */
+std::size_t VulkanDevice::getBufferUsageIndex(const BufferUsage buffer_usage) noexcept
+{
+  std::size_t index = 0;
+  switch (buffer_usage) {
+   case BufferUsage::kDeviceOnly: {
+    index = 0;
+    break;
+   }
+   case BufferUsage::kHostOnly: {
+    index = 1;
+    break;
+   }
+   case BufferUsage::kHostToDevice: {
+    index = 2;
+    break;
+   }
+   case BufferUsage::kDeviceToHost: {
+    index = 3;
+    break;
+   }
+  }
+  return index;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+VmaVulkanFunctions VulkanDevice::getVmaVulkanFunctions() noexcept
+{
+  const auto loader = dispatcher().loaderImpl();
+  VmaVulkanFunctions functions;
+  functions.vkGetPhysicalDeviceProperties = loader->vkGetPhysicalDeviceProperties;
+  functions.vkGetPhysicalDeviceMemoryProperties = loader->vkGetPhysicalDeviceMemoryProperties;
+  functions.vkAllocateMemory = loader->vkAllocateMemory;
+  functions.vkFreeMemory = loader->vkFreeMemory;
+  functions.vkMapMemory = loader->vkMapMemory;
+  functions.vkUnmapMemory = loader->vkUnmapMemory;
+  functions.vkFlushMappedMemoryRanges = loader->vkFlushMappedMemoryRanges;
+  functions.vkInvalidateMappedMemoryRanges = loader->vkInvalidateMappedMemoryRanges;
+  functions.vkBindBufferMemory = loader->vkBindBufferMemory;
+  functions.vkBindImageMemory = loader->vkBindImageMemory;
+  functions.vkGetBufferMemoryRequirements = loader->vkGetBufferMemoryRequirements;
+  functions.vkGetImageMemoryRequirements = loader->vkGetImageMemoryRequirements;
+  functions.vkCreateBuffer = loader->vkCreateBuffer;
+  functions.vkDestroyBuffer = loader->vkDestroyBuffer;
+  functions.vkCreateImage = loader->vkCreateImage;
+  functions.vkDestroyImage = loader->vkDestroyImage;
+  functions.vkCmdCopyBuffer = loader->vkCmdCopyBuffer;
+
+  if (loader->vkGetBufferMemoryRequirements2)
+    functions.vkGetBufferMemoryRequirements2KHR = loader->vkGetBufferMemoryRequirements2;
+  else
+    functions.vkGetBufferMemoryRequirements2KHR = loader->vkGetBufferMemoryRequirements2KHR;
+  if (loader->vkGetImageMemoryRequirements2)
+    functions.vkGetImageMemoryRequirements2KHR = loader->vkGetImageMemoryRequirements2;
+  else 
+    functions.vkGetImageMemoryRequirements2KHR = loader->vkGetImageMemoryRequirements2KHR;
   if (loader->vkBindBufferMemory2)
     functions.vkBindBufferMemory2KHR = loader->vkBindBufferMemory2;
   else
@@ -640,36 +1119,113 @@ VmaVulkanFunctions VulkanDevice::getVmaVulkanFunctions() noexcept
   return functions;
 }
 
-///*!
-//  */
-//inline
-//vk::Queue VulkanDevice::getQueue(const QueueType queue_type,
-//                                 const uint32b queue_index) const noexcept
-//{
-//  const uint32b family_index = queueFamilyIndex(queue_type);
-//  const auto& info = physicalDeviceInfo();
-//  const auto& family_info_list = info.queueFamilyPropertiesList();
-//  const auto& family_info = family_info_list[family_index].properties1_;
-//  const uint32b index = queue_index % family_info.queueCount;
-//  auto q = device_.getQueue(family_index, index);
-//  return q;
-//}
-//
-///*!
-//  */
-//inline
-//void VulkanDevice::initCommandPool() noexcept
-//{
-//  command_pool_list_.reserve(queue_family_index_list_.size());
-//  for (std::size_t i = 0; i < queue_family_index_list_.size(); ++i) {
-//    const vk::CommandPoolCreateInfo pool_info{
-//        vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-//        queue_family_index_list_[i]};
-//    auto [result, command_pool] = device_.createCommandPool(pool_info);
-//    ZISC_ASSERT(result == vk::Result::eSuccess, "Command pool creation failed.");
-//    command_pool_list_.emplace_back(command_pool);
-//  }
-//}
+/*!
+  \details No detailed description
+
+  \param [in] queue_index No description.
+  \return No description
+  */
+auto VulkanDevice::getQueue(const uint32b queue_index) const noexcept -> Queue&
+{
+  ZISC_ASSERT(queue_index < queue_list_->size(),
+              "The queue index is out of range: ", queue_index);
+  return *(*queue_list_)[queue_index];
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer_usage No description.
+  \return No description
+  */
+VmaMemoryUsage VulkanDevice::getVmaMemoryUsage(const BufferUsage buffer_usage) noexcept
+{
+  VmaMemoryUsage usage = VMA_MEMORY_USAGE_UNKNOWN;
+  switch (buffer_usage) {
+   case BufferUsage::kDeviceOnly: {
+    usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    break;
+   }
+   case BufferUsage::kHostOnly: {
+    usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    break;
+   }
+   case BufferUsage::kHostToDevice: {
+    usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    break;
+   }
+   case BufferUsage::kDeviceToHost: {
+    usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+    break;
+   }
+  }
+  return usage;
+}
+
+/*!
+  \details A pool is made for each buffer usage with the memory type which
+  VMA chooses for the usage. Memory blocks of a pool are allocated on demand
+  */
+void VulkanDevice::initBufferPools()
+{
+  constexpr std::array<BufferUsage, 4> usage_list{{BufferUsage::kDeviceOnly,
+                                                   BufferUsage::kHostOnly,
+                                                   BufferUsage::kHostToDevice,
+                                                   BufferUsage::kDeviceToHost}};
+  const VkBufferCreateInfo binfo = makeBufferCreateInfo(maxPoolBufferSize());
+  for (const BufferUsage usage : usage_list) {
+    VmaAllocationCreateInfo alloc_create_info;
+    alloc_create_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    alloc_create_info.usage = getVmaMemoryUsage(usage);
+    alloc_create_info.requiredFlags = 0;
+    alloc_create_info.preferredFlags = 0;
+    alloc_create_info.memoryTypeBits = 0;
+    alloc_create_info.pool = VK_NULL_HANDLE;
+    alloc_create_info.pUserData = nullptr;
+
+    uint32b memory_type_index = 0;
+    auto result = vmaFindMemoryTypeIndexForBufferInfo(
+        memoryAllocator(),
+        std::addressof(binfo),
+        std::addressof(alloc_create_info),
+        std::addressof(memory_type_index));
+    auto& pool = buffer_pool_list_[getBufferUsageIndex(usage)];
+    if (result == VK_SUCCESS) {
+      VmaPoolCreateInfo create_info;
+      create_info.memoryTypeIndex = memory_type_index;
+      create_info.flags = 0;
+      create_info.blockSize = bufferPoolBlockSize();
+      create_info.minBlockCount = 0;
+      create_info.maxBlockCount = 0;
+      create_info.frameInUseCount = 0;
+      result = vmaCreatePool(memoryAllocator(),
+                             std::addressof(create_info),
+                             std::addressof(pool));
+    }
+    if (result != VK_SUCCESS) {
+      //! \todo Handle exception
+      printf("[Warning]: Buffer pool creation failed.\n");
+      // Buffers of the usage are allocated from the default pools
+      pool = VK_NULL_HANDLE;
+    }
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+void VulkanDevice::initCommandPool()
+{
+  zinvulvk::Device d{device()};
+  auto& sub_platform = parentImpl();
+  zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+  const auto loader = dispatcher().loaderImpl();
+  const zinvulvk::CommandPoolCreateInfo create_info{
+      zinvulvk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+      queueFamilyIndex()};
+  auto command_pool = d.createCommandPool(create_info, alloc, *loader);
+  command_pool_ = zisc::cast<VkCommandPool>(command_pool);
+}
 
 /*!
   \details No detailed description
@@ -800,6 +1356,32 @@ void VulkanDevice::initQueueFamilyIndexList() noexcept
   queue_family_index_ = findQueueFamily();
 }
 
+/*!
+  \details No detailed description
+  */
+void VulkanDevice::initQueueList() noexcept
+{
+  auto mem_resource = memoryResource();
+  using QueueList = decltype(queue_list_)::element_type;
+  {
+    QueueList queue_list{QueueList::allocator_type{mem_resource}};
+    zisc::pmr::polymorphic_allocator<QueueList> alloc{mem_resource};
+    queue_list_ = zisc::pmr::allocateUnique(alloc, std::move(queue_list));
+  }
+
+  zinvulvk::Device d{device()};
+  const auto loader = dispatcher().loaderImpl();
+  const uint32b family_index = queueFamilyIndex();
+  const std::size_t num_of_queues = numOfQueues();
+  queue_list_->reserve(num_of_queues);
+  for (std::size_t i = 0; i < num_of_queues; ++i) {
+    auto q = d.getQueue(family_index, zisc::cast<uint32b>(i), *loader);
+    zisc::pmr::polymorphic_allocator<Queue> alloc{mem_resource};
+    auto queue = zisc::pmr::allocateUnique(alloc, this, zisc::cast<VkQueue>(q));
+    queue_list_->emplace_back(std::move(queue));
+  }
+}
+
 /*!
   \details No detailed description
   */
@@ -847,4 +1429,745 @@ VmaDeviceMemoryCallbacks VulkanDevice::makeAllocationNotifier() noexcept
   return notifier;
 }
 
+/*!
+  \details The budget mutex must be locked
+
+  \param [in] buffer No description.
+  \return No description
+  */
+bool VulkanDevice::isPinned(const EvictableBuffer* buffer) const noexcept
+{
+  const auto& buffer_list = *pinned_buffer_list_;
+  auto pinned = std::find_if(buffer_list.begin(), buffer_list.end(),
+  [buffer](const PinnedBuffer& p) noexcept
+  {
+    return p.buffer_ == buffer;
+  });
+  return pinned != buffer_list.end();
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::markBufferUsed(const EvictableBuffer* buffer) noexcept
+{
+  const uint64b number = use_number_.fetch_add(1, std::memory_order_relaxed);
+  buffer->last_use_.store(number + 1, std::memory_order_relaxed);
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] size No description.
+  \return No description
+  */
+VkBufferCreateInfo VulkanDevice::makeBufferCreateInfo(const std::size_t size) const noexcept
+{
+  zinvulvk::BufferCreateInfo create_info;
+  create_info.size = size;
+  create_info.usage = zinvulvk::BufferUsageFlagBits::eTransferSrc |
+                      zinvulvk::BufferUsageFlagBits::eTransferDst |
+                      zinvulvk::BufferUsageFlagBits::eStorageBuffer;
+  create_info.sharingMode = zinvulvk::SharingMode::eExclusive;
+  create_info.queueFamilyIndexCount = 1;
+  create_info.pQueueFamilyIndices = std::addressof(queue_family_index_);
+  return zisc::cast<VkBufferCreateInfo>(create_info);
+}
+
+/*!
+  \details If the buffer is being evicted, the handle which the command list
+  records is replaced, so the pinning waits for the end of the eviction
+
+  \param [in] buffer No description.
+  \param [in] command_list No description.
+  */
+void VulkanDevice::pinBuffer(const EvictableBuffer* buffer,
+                             const VulkanCommandList* command_list)
+{
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  budget_condition_.wait(lock, [buffer]() noexcept
+  {
+    return !buffer->is_evicting_;
+  });
+  pinned_buffer_list_->emplace_back(PinnedBuffer{buffer, command_list});
+}
+
+/*!
+  \details The buffer isn't destroyed until the eviction of it finishes
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::removeEvictableBuffer(EvictableBuffer* buffer) noexcept
+{
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  budget_condition_.wait(lock, [buffer]() noexcept
+  {
+    return !buffer->is_evicting_;
+  });
+  if (evictable_buffer_list_) {
+    auto& buffer_list = *evictable_buffer_list_;
+    auto b = std::find(buffer_list.begin(), buffer_list.end(), buffer);
+    if (b != buffer_list.end()) {
+      *b = buffer_list.back();
+      buffer_list.pop_back();
+    }
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] buffer No description.
+  */
+void VulkanDevice::removeFrameBuffer(FrameBuffer* buffer) noexcept
+{
+  std::unique_lock<std::mutex> lock{frame_mutex_};
+  if (frame_buffer_list_) {
+    auto& buffer_list = *frame_buffer_list_;
+    auto b = std::find(buffer_list.begin(), buffer_list.end(), buffer);
+    if (b != buffer_list.end()) {
+      *b = buffer_list.back();
+      buffer_list.pop_back();
+    }
+  }
+}
+
+/*!
+  \details The budget of a heap is the ratio of the budget which VMA
+  reports. VMA fetches the budget from VK_EXT_memory_budget if the device
+  supports it, otherwise it estimates the budget from the heap size.
+  The least recently used buffers of the heap are chosen until the
+  allocation fits in the budget. The victims are chosen under the budget
+  mutex, but they're evicted together without the mutex, so the other threads
+  can allocate meanwhile. The buffers aren't evicted if the device has no host
+  heap, since the host memory is the same heap then
+
+  \param [in] buffer_create_info No description.
+  \param [in] alloc_create_info No description.
+  \return True if the allocation fits in the budget
+  */
+bool VulkanDevice::reserveDeviceMemory(
+    const VkBufferCreateInfo& buffer_create_info,
+    const VmaAllocationCreateInfo& alloc_create_info)
+{
+  uint32b memory_type = 0;
+  const auto result = vmaFindMemoryTypeIndexForBufferInfo(
+      memoryAllocator(),
+      std::addressof(buffer_create_info),
+      std::addressof(alloc_create_info),
+      std::addressof(memory_type));
+  if (result != VK_SUCCESS)
+    return true;
+
+  const auto& mem_props = deviceInfoData().memoryProperties().properties1_;
+  bool has_host_heap = false;
+  for (uint32b i = 0; i < mem_props.memoryHeapCount; ++i) {
+    const zinvulvk::MemoryHeap heap{mem_props.memoryHeaps[i]};
+    if (!(heap.flags & zinvulvk::MemoryHeapFlagBits::eDeviceLocal))
+      has_host_heap = true;
+  }
+  const std::size_t heap_index = mem_props.memoryTypes[memory_type].heapIndex;
+  const zinvulvk::MemoryHeap heap{mem_props.memoryHeaps[heap_index]};
+  if (!has_host_heap || !(heap.flags & zinvulvk::MemoryHeapFlagBits::eDeviceLocal))
+    return true;
+
+  const double ratio = parentImpl().memoryBudgetRatio();
+  const std::size_t size = buffer_create_info.size;
+  bool is_in_budget = false;
+  using BufferList = zisc::pmr::vector<EvictableBuffer*>;
+  BufferList victim_list{BufferList::allocator_type{memoryResource()}};
+  {
+    std::unique_lock<std::mutex> lock{budget_mutex_};
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budget_list;
+    vmaGetBudget(memoryAllocator(), budget_list.data());
+    const auto& budget = budget_list[heap_index];
+    const double limit = ratio * zisc::cast<double>(budget.budget);
+    std::size_t usage = zisc::cast<std::size_t>(budget.usage) + size;
+    is_in_budget = zisc::cast<double>(usage) <= limit;
+    for (bool has_candidate = true; !is_in_budget && has_candidate;) {
+      EvictableBuffer* buffer = takeEvictionCandidate(heap_index);
+      has_candidate = buffer != nullptr;
+      if (has_candidate) {
+        victim_list.emplace_back(buffer);
+        usage = usage - std::min(buffer->memory_size_, usage);
+        is_in_budget = zisc::cast<double>(usage) <= limit;
+      }
+    }
+  }
+  if (!victim_list.empty())
+    evictBuffers(victim_list);
+  return is_in_budget;
+}
+
+/*!
+  \details The budget mutex must be locked. The buffers which are referred by
+  command lists or are transferred by the owners are skipped. The candidate is marked as being evicted
+
+  \param [in] heap_index No description.
+  \return The buffer, or nullptr if the heap has no candidate
+  */
+auto VulkanDevice::takeEvictionCandidate(const std::size_t heap_index) noexcept
+    -> EvictableBuffer*
+{
+  auto& buffer_list = *evictable_buffer_list_;
+  auto last_use = [](const EvictableBuffer* b) noexcept
+  {
+    return b->last_use_.load(std::memory_order_relaxed);
+  };
+  auto candidate = buffer_list.end();
+  for (auto b = buffer_list.begin(); b != buffer_list.end(); ++b) {
+    const bool is_candidate = ((*b)->heap_index_ == heap_index) &&
+                              ((candidate == buffer_list.end()) ||
+                               (last_use(*b) < last_use(*candidate))) &&
+                              ((*b)->num_of_transfers_ == 0) &&
+                              !isPinned(*b);
+    if (is_candidate)
+      candidate = b;
+  }
+
+  EvictableBuffer* buffer = nullptr;
+  if (candidate != buffer_list.end()) {
+    buffer = *candidate;
+    *candidate = buffer_list.back();
+    buffer_list.pop_back();
+    buffer->is_evicting_ = true;
+  }
+  return buffer;
+}
+
+/*!
+  \details The buffer is destroyed if the pool is full
+
+  \param [in] staging_buffer No description.
+  */
+void VulkanDevice::returnStagingBuffer(const StagingBuffer& staging_buffer) noexcept
+{
+  std::unique_lock<std::mutex> lock{staging_mutex_};
+  auto& buffer_list = *staging_buffer_list_;
+  buffer_list.emplace_back(staging_buffer);
+  if (maxNumOfStagingBuffers() < buffer_list.size()) {
+    // Destroy the smallest buffer
+    auto b = std::min_element(buffer_list.begin(), buffer_list.end(),
+    [](const StagingBuffer& lhs, const StagingBuffer& rhs) noexcept
+    {
+      return lhs.vm_alloc_info_.size < rhs.vm_alloc_info_.size;
+    });
+    deallocateMemory(std::addressof(b->buffer_),
+                     std::addressof(b->vm_allocation_));
+    buffer_list.erase(b);
+  }
+}
+
+/*!
+  \details The smallest buffer which fits the size is taken from the pool.
+  If there is no such buffer, a new buffer is allocated with the size
+  rounded up to power of 2, so that the buffer can be reused for
+  the transfers of similar sizes
+
+  \param [in] size No description.
+  \param [in] usage No description.
+  \return No description
+  */
+auto VulkanDevice::takeStagingBuffer(const std::size_t size,
+                                     const BufferUsage usage) -> StagingBuffer
+{
+  StagingBuffer staging_buffer;
+  bool is_found = false;
+  {
+    std::unique_lock<std::mutex> lock{staging_mutex_};
+    auto& buffer_list = *staging_buffer_list_;
+    auto candidate = buffer_list.end();
+    for (auto b = buffer_list.begin(); b != buffer_list.end(); ++b) {
+      const bool is_fit = (b->usage_ == usage) && (size <= b->vm_alloc_info_.size);
+      if (is_fit && ((candidate == buffer_list.end()) ||
+                     (b->vm_alloc_info_.size < candidate->vm_alloc_info_.size)))
+        candidate = b;
+    }
+    is_found = candidate != buffer_list.end();
+    if (is_found) {
+      staging_buffer = *candidate;
+      buffer_list.erase(candidate);
+    }
+  }
+
+  if (!is_found) {
+    std::size_t s = minStagingBufferSize();
+    while (s < size)
+      s = s << 1;
+    staging_buffer.usage_ = usage;
+    allocateMemory(s,
+                   usage,
+                   nullptr,
+                   std::addressof(staging_buffer.buffer_),
+                   std::addressof(staging_buffer.vm_allocation_),
+                   std::addressof(staging_buffer.vm_alloc_info_));
+  }
+  return staging_buffer;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] command_list No description.
+  */
+void VulkanDevice::unpinBuffers(const VulkanCommandList* command_list) noexcept
+{
+  std::unique_lock<std::mutex> lock{budget_mutex_};
+  if (pinned_buffer_list_) {
+    auto& buffer_list = *pinned_buffer_list_;
+    auto end = std::remove_if(buffer_list.begin(), buffer_list.end(),
+    [command_list](const PinnedBuffer& p) noexcept
+    {
+      return p.command_list_ == command_list;
+    });
+    buffer_list.erase(end, buffer_list.end());
+  }
+}
+
+/*!
+  \details No detailed description
+  */
+VulkanDevice::EvictableBuffer::~EvictableBuffer() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+  */
+VulkanDevice::FrameBuffer::~FrameBuffer() noexcept
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] device No description.
+  \param [in] queue No description.
+  */
+VulkanDevice::Queue::Queue(VulkanDevice* device, VkQueue queue) noexcept :
+    device_{device},
+    queue_{queue},
+    fence_list_{zisc::pmr::vector<VkFence>::allocator_type{
+        device->memoryResource()}},
+    free_fence_list_{zisc::pmr::vector<VkFence>::allocator_type{
+        device->memoryResource()}},
+    retired_fence_list_{zisc::pmr::vector<VkFence>::allocator_type{
+        device->memoryResource()}},
+    command_list_{zisc::pmr::vector<VkCommandBuffer>::allocator_type{
+        device->memoryResource()}},
+    free_command_list_{zisc::pmr::vector<VkCommandBuffer>::allocator_type{
+        device->memoryResource()}},
+    wait_semaphore_list_{zisc::pmr::vector<VkSemaphore>::allocator_type{
+        device->memoryResource()}},
+    used_semaphore_list_{decltype(used_semaphore_list_)::allocator_type{
+        device->memoryResource()}},
+    free_semaphore_list_{zisc::pmr::vector<VkSemaphore>::allocator_type{
+        device->memoryResource()}},
+    completed_number_{0},
+    is_lost_{false}
+{
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] semaphore No description.
+  */
+void VulkanDevice::Queue::addWaitSemaphore(const VkSemaphore& semaphore) noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  wait_semaphore_list_.emplace_back(semaphore);
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint64b VulkanDevice::Queue::completedNumber() const noexcept
+{
+  const uint64b number = completed_number_.load(std::memory_order_acquire);
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] src No description.
+  \param [in] dst No description.
+  \param [in] region No description.
+  \return No description
+  */
+uint64b VulkanDevice::Queue::copyBuffer(const VkBuffer& src,
+                                        const VkBuffer& dst,
+                                        const VkBufferCopy& region)
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+
+  const auto loader = device_->dispatcher().loaderImpl();
+  zinvulvk::CommandBuffer command{takeCommandBuffer()};
+  const zinvulvk::CommandBufferBeginInfo begin_info{
+      zinvulvk::CommandBufferUsageFlagBits::eOneTimeSubmit};
+  command.begin(begin_info, *loader);
+  const auto copy_region = zisc::treatAs<const zinvulvk::BufferCopy*>(
+      std::addressof(region));
+  command.copyBuffer(zinvulvk::Buffer{src},
+                     zinvulvk::Buffer{dst},
+                     1,
+                     copy_region,
+                     *loader);
+  command.end(*loader);
+
+  const uint64b number = submitImpl(zisc::cast<VkCommandBuffer>(command),
+                                    true,
+                                    VK_NULL_HANDLE);
+  return number;
+}
+
+/*!
+  \details The fences of the pending submissions remain only if the device
+  is lost
+  */
+void VulkanDevice::Queue::destroy() noexcept
+{
+  wait(submittedNumber());
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  zinvulvk::Device d{device_->device()};
+  auto& sub_platform = device_->parentImpl();
+  zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+  const auto loader = device_->dispatcher().loaderImpl();
+  for (auto* fence_list : {&fence_list_, &retired_fence_list_, &free_fence_list_}) {
+    for (const auto fence : *fence_list)
+      d.destroyFence(zinvulvk::Fence{fence}, alloc, *loader);
+    fence_list->clear();
+  }
+  command_list_.clear();
+  // The pending semaphores have been signaled since the device is idle
+  for (const auto& used : used_semaphore_list_)
+    free_semaphore_list_.emplace_back(used.second);
+  used_semaphore_list_.clear();
+  free_semaphore_list_.insert(free_semaphore_list_.end(),
+                              wait_semaphore_list_.begin(),
+                              wait_semaphore_list_.end());
+  wait_semaphore_list_.clear();
+  for (const auto semaphore : free_semaphore_list_)
+    d.destroySemaphore(zinvulvk::Semaphore{semaphore}, alloc, *loader);
+  free_semaphore_list_.clear();
+  // The command buffers are freed with the pool
+  free_command_list_.clear();
+  if (zinvulvk::CommandPool{command_pool_}) {
+    d.destroyCommandPool(zinvulvk::CommandPool{command_pool_}, alloc, *loader);
+    command_pool_ = VK_NULL_HANDLE;
+  }
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] number No description.
+  \return No description
+  */
+bool VulkanDevice::Queue::isCompleted(const uint64b number) noexcept
+{
+  bool result = number <= completedNumber();
+  if (!result) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    ZISC_ASSERT(number <= submitted_number_, "The submission doesn't exist.");
+    const uint64b completed = completedNumber();
+    if (completed < number) {
+      const auto fence = zinvulvk::Fence{fence_list_[number - completed - 1]};
+      zinvulvk::Device d{device_->device()};
+      const auto loader = device_->dispatcher().loaderImpl();
+      const auto r = d.getFenceStatus(fence, *loader);
+      if (r == zinvulvk::Result::eSuccess)
+        retire(number);
+      else if (r == zinvulvk::Result::eErrorDeviceLost)
+        is_lost_.store(true, std::memory_order_release);
+    }
+    result = number <= completedNumber();
+  }
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+bool VulkanDevice::Queue::isLost() const noexcept
+{
+  const bool result = is_lost_.load(std::memory_order_acquire);
+  return result;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] command_buffer No description.
+  \return No description
+  */
+uint64b VulkanDevice::Queue::signal(const VkSemaphore& semaphore)
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  const uint64b number = submitImpl(VK_NULL_HANDLE, false, semaphore);
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] command_buffer No description.
+  \return No description
+  */
+uint64b VulkanDevice::Queue::submit(const VkCommandBuffer& command_buffer)
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  const uint64b number = submitImpl(command_buffer, false, VK_NULL_HANDLE);
+  return number;
+}
+
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+uint64b VulkanDevice::Queue::submittedNumber() const noexcept
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  return submitted_number_;
+}
+
+/*!
+  \details A semaphore is recycled when the submission which waits for it
+  is completed
+
+  \return No description
+  */
+VkSemaphore VulkanDevice::Queue::takeSemaphore()
+{
+  std::unique_lock<std::mutex> lock{mutex_};
+  VkSemaphore semaphore = VK_NULL_HANDLE;
+  if (free_semaphore_list_.empty()) {
+    zinvulvk::Device d{device_->device()};
+    const auto loader = device_->dispatcher().loaderImpl();
+    auto& sub_platform = device_->parentImpl();
+    zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+    const zinvulvk::SemaphoreCreateInfo create_info{};
+    const auto s = d.createSemaphore(create_info, alloc, *loader);
+    semaphore = zisc::cast<VkSemaphore>(s);
+  }
+  else {
+    semaphore = free_semaphore_list_.back();
+    free_semaphore_list_.pop_back();
+  }
+  return semaphore;
+}
+
+/*!
+  \details The fence is copied under the lock and waited without the lock,
+  so the other threads can submit to the queue meanwhile. The fence isn't
+  reset until all waiting threads wake up. If the device is lost, the
+  submissions aren't retired and this function returns without the
+  completion
+
+  \param [in] number No description.
+  */
+void VulkanDevice::Queue::wait(const uint64b number) noexcept
+{
+  if ((completedNumber() < number) && !isLost()) {
+    VkFence fence = VK_NULL_HANDLE;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      ZISC_ASSERT(number <= submitted_number_, "The submission doesn't exist.");
+      const uint64b completed = completedNumber();
+      if (completed < number) {
+        fence = fence_list_[number - completed - 1];
+        ++num_of_waiters_;
+      }
+    }
+    if (fence != VK_NULL_HANDLE) {
+      zinvulvk::Device d{device_->device()};
+      const auto loader = device_->dispatcher().loaderImpl();
+      const auto r = d.waitForFences(1,
+                                     zisc::treatAs<const zinvulvk::Fence*>(&fence),
+                                     VK_TRUE,
+                                     (std::numeric_limits<uint64b>::max)(),
+                                     *loader);
+      std::unique_lock<std::mutex> lock{mutex_};
+      --num_of_waiters_;
+      if (r == zinvulvk::Result::eSuccess) {
+        retire(number);
+      }
+      else if (r == zinvulvk::Result::eErrorDeviceLost) {
+        is_lost_.store(true, std::memory_order_release);
+        printf("[Error]: The device is lost.\n");
+      }
+      else {
+        //! \todo Handle exception
+        printf("[Warning]: Waiting for a fence failed.\n");
+      }
+      recycleFences();
+    }
+  }
+}
+
+/*!
+  \details The mutex must be locked by the caller
+  */
+void VulkanDevice::Queue::recycleFences() noexcept
+{
+  if ((num_of_waiters_ == 0) && !retired_fence_list_.empty()) {
+    zinvulvk::Device d{device_->device()};
+    const auto loader = device_->dispatcher().loaderImpl();
+    const auto fences = zisc::treatAs<const zinvulvk::Fence*>(
+        retired_fence_list_.data());
+    const auto n = zisc::cast<uint32b>(retired_fence_list_.size());
+    const auto r = d.resetFences(n, fences, *loader);
+    if (r != zinvulvk::Result::eSuccess) {
+      //! \todo Handle exception
+      printf("[Warning]: Resetting fences failed.\n");
+    }
+    free_fence_list_.insert(free_fence_list_.end(),
+                            retired_fence_list_.begin(),
+                            retired_fence_list_.end());
+    retired_fence_list_.clear();
+  }
+}
+
+/*!
+  \details The fences of a queue are signaled in submission order,
+  so all submissions up to the number are completed.
+  The mutex must be locked by the caller
+
+  \param [in] number No description.
+  */
+void VulkanDevice::Queue::retire(const uint64b number) noexcept
+{
+  const uint64b completed = completedNumber();
+  if (completed < number) {
+    const auto n = zisc::cast<std::size_t>(number - completed);
+    const auto end = fence_list_.begin() + zisc::cast<std::ptrdiff_t>(n);
+    retired_fence_list_.insert(retired_fence_list_.end(), fence_list_.begin(), end);
+    fence_list_.erase(fence_list_.begin(), end);
+    recycleFences();
+    // Recycle the command buffers which are owned by the queue
+    const auto command_end = command_list_.begin() + zisc::cast<std::ptrdiff_t>(n);
+    for (auto command = command_list_.begin(); command != command_end; ++command) {
+      if (*command != VK_NULL_HANDLE)
+        free_command_list_.emplace_back(*command);
+    }
+    command_list_.erase(command_list_.begin(), command_end);
+    // Recycle the semaphores which were waited by the submissions
+    auto semaphore = used_semaphore_list_.begin();
+    for (; (semaphore != used_semaphore_list_.end()) &&
+           (semaphore->first <= number); ++semaphore)
+      free_semaphore_list_.emplace_back(semaphore->second);
+    used_semaphore_list_.erase(used_semaphore_list_.begin(), semaphore);
+    completed_number_.store(number, std::memory_order_release);
+  }
+}
+
+/*!
+  \details The submission waits for the semaphores which were added before.
+  A null command buffer makes an empty submission.
+  The mutex must be locked by the caller
+
+  \param [in] command_buffer No description.
+  \param [in] is_owned No description.
+  \param [in] signal_semaphore No description.
+  \return No description
+  */
+uint64b VulkanDevice::Queue::submitImpl(const VkCommandBuffer& command_buffer,
+                                        const bool is_owned,
+                                        const VkSemaphore& signal_semaphore)
+{
+  zinvulvk::Device d{device_->device()};
+  const auto loader = device_->dispatcher().loaderImpl();
+  zinvulvk::Fence fence;
+  if (free_fence_list_.empty()) {
+    auto& sub_platform = device_->parentImpl();
+    zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+    const zinvulvk::FenceCreateInfo create_info{};
+    fence = d.createFence(create_info, alloc, *loader);
+  }
+  else {
+    fence = zinvulvk::Fence{free_fence_list_.back()};
+    free_fence_list_.pop_back();
+  }
+
+  const zinvulvk::CommandBuffer command{command_buffer};
+  const zinvulvk::Semaphore signal{signal_semaphore};
+  const auto num_of_waits = zisc::cast<uint32b>(wait_semaphore_list_.size());
+  const zisc::pmr::vector<zinvulvk::PipelineStageFlags> stage_list{
+      num_of_waits,
+      zinvulvk::PipelineStageFlagBits::eAllCommands,
+      zisc::pmr::vector<zinvulvk::PipelineStageFlags>::allocator_type{
+          device_->memoryResource()}};
+  const zinvulvk::SubmitInfo submit_info{
+      num_of_waits,
+      zisc::treatAs<const zinvulvk::Semaphore*>(wait_semaphore_list_.data()),
+      stage_list.data(),
+      command ? 1u : 0u,
+      &command,
+      signal ? 1u : 0u,
+      &signal};
+  zinvulvk::Queue q{queue_};
+  q.submit(submit_info, fence, *loader);
+  fence_list_.emplace_back(zisc::cast<VkFence>(fence));
+  command_list_.emplace_back(is_owned ? command_buffer : VK_NULL_HANDLE);
+
+  const uint64b number = ++submitted_number_;
+  for (const auto semaphore : wait_semaphore_list_)
+    used_semaphore_list_.emplace_back(number, semaphore);
+  wait_semaphore_list_.clear();
+  return number;
+}
+
+/*!
+  \details The command buffers are allocated from the pool of the queue,
+  so that the recording is synchronized by the mutex of the queue.
+  The mutex must be locked by the caller
+
+  \return No description
+  */
+VkCommandBuffer VulkanDevice::Queue::takeCommandBuffer()
+{
+  VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+  if (free_command_list_.empty()) {
+    zinvulvk::Device d{device_->device()};
+    const auto loader = device_->dispatcher().loaderImpl();
+    if (!zinvulvk::CommandPool{command_pool_}) {
+      auto& sub_platform = device_->parentImpl();
+      zinvulvk::AllocationCallbacks alloc{sub_platform.makeAllocator()};
+      const zinvulvk::CommandPoolCreateInfo create_info{
+          zinvulvk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+          zinvulvk::CommandPoolCreateFlagBits::eTransient,
+          device_->queueFamilyIndex()};
+      auto command_pool = d.createCommandPool(create_info, alloc, *loader);
+      command_pool_ = zisc::cast<VkCommandPool>(command_pool);
+    }
+    const zinvulvk::CommandBufferAllocateInfo alloc_info{
+        zinvulvk::CommandPool{command_pool_},
+        zinvulvk::CommandBufferLevel::ePrimary,
+        1};
+    zinvulvk::CommandBuffer command;
+    const auto r = d.allocateCommandBuffers(std::addressof(alloc_info),
+                                            std::addressof(command),
+                                            *loader);
+    if (r != zinvulvk::Result::eSuccess) {
+      //! \todo Handle exception
+      printf("[Warning]: Command buffer allocation failed.\n");
+    }
+    command_buffer = zisc::cast<VkCommandBuffer>(command);
+  }
+  else {
+    command_buffer = free_command_list_.back();
+    free_command_list_.pop_back();
+  }
+  return command_buffer;
+}
+
 } // namespace zinvul
@@ -17,8 +17,12 @@
 
 // Standard C++ library
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 // Vulkan
 #include <vulkan/vulkan.h>
@@ -26,11 +30,14 @@
 #include <vk_mem_alloc.h>
 // Zisc
 #include "zisc/memory.hpp"
+#include "zisc/non_copyable.hpp"
 #include "zisc/std_memory_resource.hpp"
 // Zinvul
 #include "utility/vulkan_dispatch_loader.hpp"
 #include "zinvul/buffer.hpp"
+#include "zinvul/command_list.hpp"
 #include "zinvul/device.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
 
@@ -38,6 +45,8 @@ namespace zinvul {
 
 // Forward declaration
 class DeviceInfo;
+template <typename> class VulkanBuffer;
+class VulkanCommandList;
 class VulkanDeviceInfo;
 class VulkanSubPlatform;
 
@@ -57,13 +66,21 @@ class VulkanDevice : public Device
 
 
   //! Allocate a device memory
-  void allocateMemory(const std::size_t size,
+  bool allocateMemory(const std::size_t size,
                       const BufferUsage buffer_usage,
                       void* user_data,
                       VkBuffer* buffer,
                       VmaAllocation* vm_allocation,
                       VmaAllocationInfo* alloc_info);
 
+  //! Allocate a range of a frame block of the frame pool
+  bool allocateFrameMemory(const std::size_t size,
+                           const BufferUsage buffer_usage,
+                           VkBuffer* buffer,
+                           VmaAllocation* vm_allocation,
+                           VmaAllocationInfo* alloc_info,
+                           std::size_t* offset);
+
 //  //! Allocate a memory of a buffer
 //  template <DescriptorType kDescriptor, typename Type>
 //  void allocate(const std::size_t size,
@@ -73,17 +90,22 @@ class VulkanDevice : public Device
 //  template <std::size_t kDimension>
 //  std::array<uint32b, 3> calcWorkGroupSize(
 //      const std::array<uint32b, kDimension>& works) const noexcept;
-//
-//  //! Return the command pool
-//  vk::CommandPool& commandPool(const QueueType queue_type) noexcept;
-//
-//  //! Return the command pool
-//  const vk::CommandPool& commandPool(const QueueType queue_type) const noexcept;
+
+  //! Return the command pool of the queue family
+  VkCommandPool& commandPool() noexcept;
+
+  //! Return the command pool of the queue family
+  const VkCommandPool& commandPool() const noexcept;
+
+  //! Copy a region of the src buffer to the dst buffer on the queue
+  Fence copyBuffer(const VkBuffer& src,
+                   const VkBuffer& dst,
+                   const VkBufferCopy& region,
+                   const uint32b queue_index);
 
   //! Deallocate a device memory
   void deallocateMemory(VkBuffer* buffer,
-                        VmaAllocation* vm_allocation,
-                        VmaAllocationInfo* alloc_info) noexcept;
+                        VmaAllocation* vm_allocation) noexcept;
 
   //! Return the underlying vulkan device
   VkDevice& device() noexcept;
@@ -106,6 +128,16 @@ class VulkanDevice : public Device
   //! Return the invalid queue index in queue families
   static constexpr uint32b invalidQueueIndex() noexcept;
 
+  //! Make the queue wait for the command of the fence before the next commands
+  void enqueueWait(const uint32b queue_index,
+                   const Fence& fence) noexcept override;
+
+  //! Check if the command of the given fence is completed
+  bool isCompleted(const Fence& fence) const noexcept override;
+
+  //! Check if the device is lost
+  bool isLost() const noexcept;
+
 //  //! Return the local-work size for the work dimension
 //  template <std::size_t kDimension>
 //  const std::array<uint32b, 3>& localWorkSize() const noexcept;
@@ -114,6 +146,13 @@ class VulkanDevice : public Device
   template <typename Type>
   SharedBuffer<Type> makeBuffer(const BufferUsage flag);
 
+  //! Make a command list
+  SharedCommandList makeCommandList();
+
+  //! Make a buffer which is sub-allocated from the frame pool
+  template <typename Type>
+  SharedBuffer<Type> makeFrameBuffer(const BufferUsage flag);
+
 //  //! Make a kernel
 //  template <std::size_t kDimension, typename Function, typename ...ArgumentTypes>
 //  UniqueKernel<kDimension, ArgumentTypes...> makeKernel(
@@ -132,6 +171,16 @@ class VulkanDevice : public Device
   //! Return the peak memory usage of the heap of the given number
   std::size_t peakMemoryUsage(const std::size_t number) const noexcept override;
 
+  //! Read a region of the device buffer through a staging buffer
+  void readBuffer(const VkBuffer& src,
+                  const std::size_t offset,
+                  const std::size_t size,
+                  void* data,
+                  const uint32b queue_index);
+
+  //! Release all frame buffers at once
+  void resetFramePool() noexcept;
+
   //! Return the current memory usage of the heap of the given number
   std::size_t totalMemoryUsage(const std::size_t number) const noexcept override;
 
@@ -139,20 +188,24 @@ class VulkanDevice : public Device
 //  void setShaderModule(const zisc::pmr::vector<uint32b>& spirv_code,
 //                       const std::size_t index) noexcept;
 
-  //! Submit a command
-//  void submit(const QueueType queue_type,
-//              const uint32b queue_index,
-//              const vk::CommandBuffer& command) const noexcept;
-
-//  //! Wait this thread until all commands in the device are completed
-//  void waitForCompletion() const noexcept override;
-//
-//  //! Wait this thread until all commands in the queues are completed
-//  void waitForCompletion(const QueueType queue_type) const noexcept override;
-//
-//  //! Wait this thread until all commands in the queue are completed
-//  void waitForCompletion(const QueueType queue_type,
-//                         const uint32b queue_index) const noexcept override;
+  //! Submit a command buffer to the queue
+  Fence submit(const uint32b queue_index, const VkCommandBuffer& command_buffer);
+
+  //! Wait this thread until all commands in the device are completed
+  void waitForCompletion() const noexcept override;
+
+  //! Wait this thread until all commands in the queue are completed
+  void waitForCompletion(const uint32b queue_index) const noexcept override;
+
+  //! Wait this thread until the command of the given fence is completed
+  void waitForCompletion(const Fence& fence) const noexcept override;
+
+  //! Write data to a region of the device buffer through a staging buffer
+  void writeBuffer(const void* data,
+                   const std::size_t size,
+                   const VkBuffer& dst,
+                   const std::size_t offset,
+                   const uint32b queue_index);
 
  protected:
   //! Destroy the device
@@ -162,6 +215,10 @@ class VulkanDevice : public Device
   void initData() override;
 
  private:
+  template <typename> friend class VulkanBuffer;
+  friend VulkanCommandList;
+
+
   /*!
     \brief No brief description
 
@@ -190,19 +247,240 @@ class VulkanDevice : public Device
         VkDeviceSize size);
   };
 
+  /*!
+    \brief A device-only buffer which can be moved to host memory
+
+    When a device-only allocation exceeds the memory budget of the heap, the
+    least recently used buffers of the heap are evicted to host memory.
+    A buffer which is recorded in a command list isn't evicted until the
+    commands are cleared, since the list refers the buffer handle. Likewise a
+    buffer isn't evicted while its owner transfers the elements.
+    */
+  class EvictableBuffer
+  {
+   public:
+    //! Finalize the buffer
+    virtual ~EvictableBuffer() noexcept;
+
+    //! Move the memory of the buffer to host memory
+    virtual void evict() = 0;
+
+   private:
+    friend VulkanDevice;
+
+
+    mutable std::atomic<uint64b> last_use_{0};
+    std::size_t heap_index_ = 0;
+    std::size_t memory_size_ = 0;
+    mutable std::size_t num_of_transfers_ = 0; //!< Guarded by the budget mutex
+    bool is_evicting_ = false; //!< Guarded by the budget mutex
+  };
+
+  /*!
+    \brief A buffer which is a range of a frame block
+
+    The device tracks the live frame buffers, so that the ranges are
+    invalidated when the frame pool is reset.
+    */
+  class FrameBuffer
+  {
+   public:
+    //! Finalize the buffer
+    virtual ~FrameBuffer() noexcept;
+
+    //! Release the range of the buffer
+    virtual void invalidateFrameRange() noexcept = 0;
+  };
+
+  /*!
+    \brief A buffer which is referred by a command list
+
+    The buffer is only compared by the address, so an entry is harmless even
+    if the buffer is destroyed before the list is cleared.
+    */
+  struct PinnedBuffer
+  {
+    const EvictableBuffer* buffer_;
+    const VulkanCommandList* command_list_;
+  };
+
+  /*!
+    \brief The submission state of a queue
+
+    A vulkan fence is signaled per submission. Since the fences of a queue
+    are signaled in submission order, the fence of a submission is found from
+    the number of completed submissions. The fences of completed submissions
+    are reset and reused once no thread waits for a fence. A host thread
+    waits for a fence without the lock, so the other threads can submit
+    meanwhile. A queue waits for another queue with a semaphore which is
+    signaled by an empty submission of the other queue.
+    */
+  class Queue : private zisc::NonCopyable<Queue>
+  {
+   public:
+    //! Initialize the queue state
+    Queue(VulkanDevice* device, VkQueue queue) noexcept;
+
+
+    //! Add a semaphore which the next submission waits for
+    void addWaitSemaphore(const VkSemaphore& semaphore) noexcept;
+
+    //! Return the number of completed submissions
+    uint64b completedNumber() const noexcept;
+
+    //! Wait for all submissions and destroy the fences
+    void destroy() noexcept;
+
+    //! Submit a copy command and return the number of the submission
+    uint64b copyBuffer(const VkBuffer& src,
+                       const VkBuffer& dst,
+                       const VkBufferCopy& region);
+
+    //! Check if the submission of the given number is completed
+    bool isCompleted(const uint64b number) noexcept;
+
+    //! Check if the device is lost while waiting for the queue
+    bool isLost() const noexcept;
+
+    //! Submit a command buffer and return the number of the submission
+    uint64b submit(const VkCommandBuffer& command_buffer);
+
+    //! Submit an empty batch which signals the semaphore after the submissions
+    uint64b signal(const VkSemaphore& semaphore);
+
+    //! Return the number of submissions
+    uint64b submittedNumber() const noexcept;
+
+    //! Take a semaphore which is owned by the queue
+    VkSemaphore takeSemaphore();
+
+    //! Wait this thread until the submission of the given number is completed
+    void wait(const uint64b number) noexcept;
+
+   private:
+    //! Reset the retired fences for reuse if no thread waits for them
+    void recycleFences() noexcept;
+
+    //! Retire the fences of the submissions up to the given number
+    void retire(const uint64b number) noexcept;
+
+    //! Submit a command buffer with a fence
+    uint64b submitImpl(const VkCommandBuffer& command_buffer,
+                       const bool is_owned,
+                       const VkSemaphore& signal_semaphore);
+
+    //! Take a command buffer which is owned by the queue
+    VkCommandBuffer takeCommandBuffer();
+
+
+    VulkanDevice* device_;
+    VkQueue queue_;
+    VkCommandPool command_pool_ = VK_NULL_HANDLE;
+    zisc::pmr::vector<VkFence> fence_list_;
+    zisc::pmr::vector<VkFence> free_fence_list_;
+    zisc::pmr::vector<VkFence> retired_fence_list_; //!< Signaled, not reset yet
+    zisc::pmr::vector<VkCommandBuffer> command_list_;
+    zisc::pmr::vector<VkCommandBuffer> free_command_list_;
+    zisc::pmr::vector<VkSemaphore> wait_semaphore_list_; //!< For the next submission
+    zisc::pmr::vector<std::pair<uint64b, VkSemaphore>> used_semaphore_list_;
+    zisc::pmr::vector<VkSemaphore> free_semaphore_list_;
+    mutable std::mutex mutex_;
+    std::atomic<uint64b> completed_number_;
+    std::atomic<bool> is_lost_;
+    uint64b submitted_number_ = 0;
+    uint32b num_of_waiters_ = 0;
+  };
+
+  /*!
+    \brief A host visible buffer which is used for transfers
+    */
+  struct StagingBuffer
+  {
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    VmaAllocation vm_allocation_ = VK_NULL_HANDLE;
+    VmaAllocationInfo vm_alloc_info_;
+    BufferUsage usage_;
+  };
+
+  /*!
+    \brief A memory block which frame buffers are sub-allocated from
+    */
+  struct FrameBlock
+  {
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    VmaAllocation vm_allocation_ = VK_NULL_HANDLE;
+    VmaAllocationInfo vm_alloc_info_;
+  };
+
+  /*!
+    \brief A linear allocator of frame buffers of a buffer usage
+
+    Frame buffers are allocated by bumping the used size of the last block.
+    A new block is added if the last block is full. All frame buffers are
+    released at once by resetting the used size.
+    */
+  struct FramePool
+  {
+    zisc::pmr::vector<FrameBlock> block_list_;
+    std::size_t used_size_ = 0;
+    std::size_t reserved_size_ = 0;
+  };
+
+
+  //! Add a buffer which is evicted when the heap exceeds the memory budget
+  void addEvictableBuffer(EvictableBuffer* buffer,
+                          const VmaAllocationInfo& alloc_info);
+
+  //! Add a buffer which is invalidated when the frame pool is reset
+  void addFrameBuffer(FrameBuffer* buffer);
+
+  //! Keep the buffer in device memory while the owner transfers the elements
+  void beginBufferTransfer(const EvictableBuffer* buffer);
+
+  //! Return the size of a memory block of a buffer pool in bytes
+  static constexpr std::size_t bufferPoolBlockSize() noexcept;
+
+  //! Destroy the buffer pools
+  void destroyBufferPools() noexcept;
+
+  //! Destroy the blocks of the frame pools
+  void destroyFramePools() noexcept;
+
+  //! Destroy all staging buffers in the pool
+  void destroyStagingBuffers() noexcept;
+
+  //! Finish the transfer of the buffer
+  void endBufferTransfer(const EvictableBuffer* buffer) noexcept;
+
+  //! Move the buffers to host memory
+  void evictBuffers(const zisc::pmr::vector<EvictableBuffer*>& buffer_list);
 
   //! Find the index of the optimal queue familty
   uint32b findQueueFamily() const noexcept;
 
+  //! Return the alignment of a frame buffer range in bytes
+  std::size_t frameBufferAlignment() const noexcept;
+
+  //! Return the index of the given buffer usage
+  static std::size_t getBufferUsageIndex(const BufferUsage buffer_usage) noexcept;
+
   //! Get Vulkan function pointers used in VMA
   VmaVulkanFunctions getVmaVulkanFunctions() noexcept;
 
-//  //! Return a queue
-//  vk::Queue getQueue(const QueueType queue_type,
-//                     const uint32b queue_index) const noexcept;
-//
-//  //! Initialize a command pool
-//  void initCommandPool() noexcept;
+  //! Return the submission state of the queue
+  Queue& getQueue(const uint32b queue_index) const noexcept;
+
+  //! Return the VMA memory usage of the given buffer usage
+  static VmaMemoryUsage getVmaMemoryUsage(const BufferUsage buffer_usage) noexcept;
+
+  //! Check if the buffer is referred by a command list
+  bool isPinned(const EvictableBuffer* buffer) const noexcept;
+
+  //! Initialize the buffer pools
+  void initBufferPools();
+
+  //! Initialize a command pool
+  void initCommandPool();
 
   //! Initialize a device
   void initDevice();
@@ -216,12 +494,37 @@ class VulkanDevice : public Device
   //! Initialize a queue family index list
   void initQueueFamilyIndexList() noexcept;
 
+  //! Initialize the submission states of the queues
+  void initQueueList() noexcept;
+
   //! Initialize a vulkan memory allocator
   void initMemoryAllocator();
 
   //! Make a device memory allocation notifier
   VmaDeviceMemoryCallbacks makeAllocationNotifier() noexcept;
 
+  //! Mark the buffer as used for the eviction order
+  void markBufferUsed(const EvictableBuffer* buffer) noexcept;
+
+  //! Make a create info of a buffer
+  VkBufferCreateInfo makeBufferCreateInfo(const std::size_t size) const noexcept;
+
+  //! Return the maximum size of a buffer which is sub-allocated from a pool
+  static constexpr std::size_t maxPoolBufferSize() noexcept;
+
+  //! Return the maximum number of staging buffers which are kept in the pool
+  static constexpr std::size_t maxNumOfStagingBuffers() noexcept;
+
+  //! Return the minimum size of a frame block in bytes
+  static constexpr std::size_t minFrameBlockSize() noexcept;
+
+  //! Return the minimum size of a staging buffer in bytes
+  static constexpr std::size_t minStagingBufferSize() noexcept;
+
+  //! Keep the buffer in device memory while the command list refers it
+  void pinBuffer(const EvictableBuffer* buffer,
+                 const VulkanCommandList* command_list);
+
   //! Return the sub-platform
   VulkanSubPlatform& parentImpl() noexcept;
 
@@ -231,13 +534,49 @@ class VulkanDevice : public Device
   //! Return an index of a queue family
   uint32b queueFamilyIndex() const noexcept;
 
+  //! Remove the buffer from the eviction candidates
+  void removeEvictableBuffer(EvictableBuffer* buffer) noexcept;
+
+  //! Remove the buffer from the live frame buffers
+  void removeFrameBuffer(FrameBuffer* buffer) noexcept;
+
+  //! Evict buffers until the allocation fits in the memory budget
+  bool reserveDeviceMemory(const VkBufferCreateInfo& buffer_create_info,
+                           const VmaAllocationCreateInfo& alloc_create_info);
+
+  //! Return a staging buffer to the pool
+  void returnStagingBuffer(const StagingBuffer& staging_buffer) noexcept;
+
+  //! Take the least recently used buffer of the heap out of the candidates
+  EvictableBuffer* takeEvictionCandidate(const std::size_t heap_index) noexcept;
+
+  //! Take a staging buffer which has at least the given size from the pool
+  StagingBuffer takeStagingBuffer(const std::size_t size,
+                                  const BufferUsage usage);
+
+  //! Release the buffers which the command list refers
+  void unpinBuffers(const VulkanCommandList* command_list) noexcept;
+
 
   VkDevice device_ = VK_NULL_HANDLE;
   VmaAllocator vm_allocator_ = VK_NULL_HANDLE;
   zisc::pmr::unique_ptr<zisc::pmr::vector<zisc::Memory::Usage>> heap_usage_list_;
   zisc::pmr::unique_ptr<VulkanDispatchLoader> dispatcher_;
 //  zisc::pmr::vector<vk::ShaderModule> shader_module_list_;
-//  zisc::pmr::vector<vk::CommandPool> command_pool_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<zisc::pmr::unique_ptr<Queue>>> queue_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<StagingBuffer>> staging_buffer_list_;
+  std::mutex staging_mutex_;
+  std::array<VmaPool, 4> buffer_pool_list_{{VK_NULL_HANDLE, VK_NULL_HANDLE,
+                                            VK_NULL_HANDLE, VK_NULL_HANDLE}};
+  zisc::pmr::unique_ptr<zisc::pmr::vector<FramePool>> frame_pool_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<FrameBuffer*>> frame_buffer_list_;
+  std::mutex frame_mutex_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<EvictableBuffer*>> evictable_buffer_list_;
+  zisc::pmr::unique_ptr<zisc::pmr::vector<PinnedBuffer>> pinned_buffer_list_;
+  std::mutex budget_mutex_;
+  std::condition_variable budget_condition_;
+  std::atomic<uint64b> use_number_{0};
+  VkCommandPool command_pool_ = VK_NULL_HANDLE;
   uint32b queue_family_index_ = invalidQueueIndex();
   std::array<std::array<uint32b, 3>, 3> work_group_size_list_;
 };
@@ -17,8 +17,11 @@
 
 #include "vulkan_kernel.hpp"
 // Standard C++ library
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
 #include <string_view>
 #include <type_traits>
@@ -31,6 +34,7 @@
 // Zinvul
 #include "vulkan_buffer.hpp"
 #include "vulkan_device.hpp"
+#include "zinvul/fence.hpp"
 #include "zinvul/kernel.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -62,8 +66,11 @@ VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 }
 
 /*!
-  \details No detailed description
+  \details A vulkan kernel doesn't have a compute pipeline yet, so it can't be
+  recorded. The function reports the error and aborts instead of leaving the
+  command list without the launch
 
+  \param [in,out] command_list No description.
   \param [in] args No description.
   \param [in] launch_options No description.
   */
@@ -71,8 +78,39 @@ template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes
 inline
 void
 VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+record(CommandList* command_list,
+       BufferRef<ArgTypes>... args,
+       const LaunchOptions& launch_options)
+{
+  if (hasGlobalOffset(launch_options)) {
+    printf("[Error]: Vulkan kernels don't support a global offset.\n");
+    std::abort();
+  }
+  printf("[Error]: Vulkan kernels can't be recorded.\n");
+  std::abort();
+}
+
+/*!
+  \details A vulkan kernel doesn't have a compute pipeline yet, so it can't be
+  dispatched. The function reports the error and aborts instead of returning
+  a fence which would be regarded as completed
+
+  \param [in] args No description.
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+Fence
+VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
 run(BufferRef<ArgTypes>... args, const LaunchOptions& launch_options)
 {
+  if (hasGlobalOffset(launch_options)) {
+    printf("[Error]: Vulkan kernels don't support a global offset.\n");
+    std::abort();
+  }
+  printf("[Error]: Vulkan kernels can't be dispatched.\n");
+  std::abort();
 }
 
 /*!
@@ -99,6 +137,28 @@ initData(const InitParameters& params)
 {
 }
 
+/*!
+  \details A global offset would need a push constant which the kernels
+  don't have, so it's rejected explicitly
+
+  \param [in] launch_options No description.
+  \return No description
+  */
+template <std::size_t kDimension, typename ...FuncArgTypes, typename ...ArgTypes>
+inline
+bool
+VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes...>::
+hasGlobalOffset(const LaunchOptions& launch_options) noexcept
+{
+  const auto& offset = launch_options.globalOffset();
+  const bool result = std::any_of(offset.begin(), offset.end(),
+  [](const uint32b o) noexcept
+  {
+    return o != 0;
+  });
+  return result;
+}
+
 ///*!
 //  */
 //template <std::size_t kDimension, typename ...ArgumentTypes, typename ...BufferArgs>
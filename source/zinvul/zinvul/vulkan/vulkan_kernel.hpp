@@ -22,6 +22,7 @@
 // Vulkan
 #include <vulkan/vulkan.h>
 // Zinvul
+#include "zinvul/fence.hpp"
 #include "zinvul/kernel.hpp"
 #include "zinvul/zinvul_config.hpp"
 #include "zinvul/utility/id_data.hpp"
@@ -31,6 +32,7 @@ namespace zinvul {
 
 // Forward declaration
 template <typename Type> class Buffer;
+class CommandList;
 class VulkanDevice;
 template <std::size_t kDimension, typename FuncArgTypes, typename ...ArgTypes>
 class VulkanKernel;
@@ -65,9 +67,14 @@ class VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes..
   ~VulkanKernel() noexcept override;
 
 
-  //! Execute a kernel
-  void run(BufferRef<ArgTypes>... args,
-           const LaunchOptions& launch_options) override;
+  //! Abort since a vulkan kernel can't be recorded
+  void record(CommandList* command_list,
+              BufferRef<ArgTypes>... args,
+              const LaunchOptions& launch_options) override;
+
+  //! Abort since a vulkan kernel can't be dispatched
+  Fence run(BufferRef<ArgTypes>... args,
+            const LaunchOptions& launch_options) override;
 
  protected:
   //! Clear the contents of the kernel
@@ -77,6 +84,9 @@ class VulkanKernel<kDimension, KernelInitParameters<FuncArgTypes...>, ArgTypes..
   void initData(const InitParameters& params) override;
 
  private:
+  //! Check if the launch options have a non-zero global offset
+  static bool hasGlobalOffset(const LaunchOptions& launch_options) noexcept;
+
 //  //! Bind buffers
 //  void bindBuffers(std::add_lvalue_reference_t<BufferArgs>... args) noexcept;
 //
@@ -109,6 +109,17 @@ const VkInstance& VulkanSubPlatform::instance() const noexcept
   return *instance_ref_;
 }
 
+/*!
+  \details No detailed description
+
+  \return No description
+  */
+inline
+double VulkanSubPlatform::memoryBudgetRatio() const noexcept
+{
+  return memory_budget_ratio_;
+}
+
 } // namespace zinvul
 
 #endif // ZINVUL_VULKAN_SUB_PLATFORM_INL_HPP
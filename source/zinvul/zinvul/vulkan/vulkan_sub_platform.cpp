@@ -14,10 +14,10 @@
 
 #include "vulkan_sub_platform.hpp"
 // Standard C++ library
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <iostream>
-#include <map>
 #include <memory>
 #include <string_view>
 #include <type_traits>
@@ -186,6 +186,7 @@ void VulkanSubPlatform::destroyData() noexcept
   */
 void VulkanSubPlatform::initData(PlatformOptions& platform_options)
 {
+  memory_budget_ratio_ = platform_options.vulkanMemoryBudgetRatio();
   initDispatcher(platform_options);
   if (!dispatcher().isAvailable()) {
     if (isDebugMode())
@@ -203,13 +204,10 @@ void VulkanSubPlatform::initData(PlatformOptions& platform_options)
   \details No detailed description
 
   \param [in,out] mem_resource No description.
-  \param [in] mem_map No description.
   */
 VulkanSubPlatform::AllocatorData::AllocatorData(
-    zisc::pmr::memory_resource* mem_resource,
-    MemoryMap&& mem_map) noexcept :
-        mem_resource_{mem_resource},
-        mem_map_{std::move(mem_map)}
+    zisc::pmr::memory_resource* mem_resource) noexcept :
+        mem_resource_{mem_resource}
 {
 }
 
@@ -230,11 +228,16 @@ auto VulkanSubPlatform::Callbacks::allocateMemory(
 {
   ZISC_ASSERT(user_data != nullptr, "The user data is null.");
   auto alloc_data = zisc::cast<AllocatorData*>(user_data);
-  void* memory = alloc_data->mem_resource_->allocate(size, alignment);
-  //
-  const std::size_t address = zisc::treatAs<std::size_t>(memory);
-  const auto mem_data = std::make_pair(size, alignment);
-  alloc_data->mem_map_.emplace(std::make_pair(address, mem_data));
+  // The header is put in the padding before the aligned memory
+  const std::size_t block_alignment = std::max(alignment, alignof(MemoryHeader));
+  const std::size_t offset = ((sizeof(MemoryHeader) + block_alignment - 1) /
+                              block_alignment) * block_alignment;
+  void* block = alloc_data->mem_resource_->allocate(offset + size, block_alignment);
+  void* memory = zisc::cast<uint8b*>(block) + offset;
+  auto header = getHeader(memory);
+  header->size_ = size;
+  header->alignment_ = block_alignment;
+  header->offset_ = offset;
   return memory;
 }
 
@@ -251,15 +254,27 @@ void VulkanSubPlatform::Callbacks::freeMemory(
   ZISC_ASSERT(user_data != nullptr, "The user data is null.");
   auto alloc_data = zisc::cast<AllocatorData*>(user_data);
   if (memory) {
-    const std::size_t address = zisc::treatAs<std::size_t>(memory);
-    const auto mem = alloc_data->mem_map_.find(address);
-    ZISC_ASSERT(mem != alloc_data->mem_map_.end(), "The mem is null.");
-    const auto& data = mem->second;
-    alloc_data->mem_resource_->deallocate(memory, data.first, data.second);
-    alloc_data->mem_map_.erase(mem);
+    const MemoryHeader header = *getHeader(memory);
+    void* block = zisc::cast<uint8b*>(memory) - header.offset_;
+    alloc_data->mem_resource_->deallocate(block,
+                                          header.offset_ + header.size_,
+                                          header.alignment_);
   }
 }
 
+/*!
+  \details No detailed description
+
+  \param [in] memory No description.
+  \return No description
+  */
+auto VulkanSubPlatform::Callbacks::getHeader(void* memory) noexcept
+    -> MemoryHeader*
+{
+  auto header = zisc::cast<MemoryHeader*>(memory) - 1;
+  return header;
+}
+
 /*!
   \details No detailed description
 
@@ -454,12 +469,8 @@ auto VulkanSubPlatform::Callbacks::reallocateMemory(
     memory = allocateMemory(user_data, size, alignment, scope);
   // Copy data
   if (original_memory && memory) {
-    auto alloc_data = zisc::cast<AllocatorData*>(user_data);
-    const std::size_t address = zisc::treatAs<std::size_t>(original_memory);
-    const auto mem = alloc_data->mem_map_.find(address);
-    ZISC_ASSERT(mem != alloc_data->mem_map_.end(), "The mem is null.");
-    const auto& data = mem->second;
-    std::memcpy(memory, original_memory, data.first);
+    const std::size_t s = std::min(getHeader(original_memory)->size_, size);
+    std::memcpy(memory, original_memory, s);
   }
   // Deallocate the original memory
   if (original_memory)
@@ -505,10 +516,7 @@ void VulkanSubPlatform::initAllocator() noexcept
 {
   auto mem_resource = memoryResource();
   zisc::pmr::polymorphic_allocator<AllocatorData> alloc{mem_resource};
-  allocator_data_ = zisc::pmr::allocateUnique<AllocatorData>(
-      alloc,
-      mem_resource,
-      MemoryMap{MemoryMap::allocator_type{mem_resource}});
+  allocator_data_ = zisc::pmr::allocateUnique<AllocatorData>(alloc, mem_resource);
 }
 
 /*!
@@ -17,7 +17,6 @@
 
 // Standard C++ library
 #include <cstddef>
-#include <map>
 #include <memory>
 #include <string_view>
 #include <type_traits>
@@ -88,6 +87,9 @@ class VulkanSubPlatform : public SubPlatform
   //! Make a unique device
   SharedDevice makeDevice(const DeviceInfo& device_info) override;
 
+  //! Return the ratio of the memory budget of the driver which devices use
+  double memoryBudgetRatio() const noexcept;
+
   //! Return the number of available devices
   std::size_t numOfDevices() const noexcept override;
 
@@ -105,22 +107,32 @@ class VulkanSubPlatform : public SubPlatform
   void initData(PlatformOptions& platform_options) override;
 
  private:
-  using MemoryMap = zisc::pmr::map<std::size_t, std::pair<size_t, size_t>>;
-
   /*!
-    \brief No brief description
+    \brief The memory resource of the host allocations of the driver
 
-    No detailed description.
+    The allocations don't share any state, so the callbacks are thread safe
+    as long as the memory resource is thread safe.
     */
   class AllocatorData : private zisc::NonCopyable<AllocatorData>
   {
    public:
     //! Initialize the allocator data
-    AllocatorData(zisc::pmr::memory_resource* mem_resource,
-                  MemoryMap&& memory_map) noexcept;
+    AllocatorData(zisc::pmr::memory_resource* mem_resource) noexcept;
 
     zisc::pmr::memory_resource* mem_resource_;
-    MemoryMap mem_map_; //!< \todo Make this thread safe
+  };
+
+  /*!
+    \brief The bookkeeping of a host allocation
+
+    The header is placed right before the memory which is returned to the
+    driver, so the memory is freed without looking up a table.
+    */
+  struct MemoryHeader
+  {
+    std::size_t size_; //!< The size which is requested by the driver
+    std::size_t alignment_; //!< The alignment of the underlying block
+    std::size_t offset_; //!< The offset of the memory from the underlying block
   };
 
   /*!
@@ -179,6 +191,9 @@ class VulkanSubPlatform : public SubPlatform
         VkInternalAllocationType type,
         VkSystemAllocationScope scope);
 
+    //! Return the header of a memory block
+    static MemoryHeader* getHeader(void* memory) noexcept;
+
     //! Print a debug message
     static DebugMessengerReturnType printDebugMessage(
         VkDebugUtilsMessageSeverityFlagBitsEXT severity_flags,
@@ -225,6 +240,7 @@ class VulkanSubPlatform : public SubPlatform
   zisc::pmr::unique_ptr<zisc::pmr::vector<VkPhysicalDevice>> device_list_;
   zisc::pmr::unique_ptr<zisc::pmr::vector<VulkanDeviceInfo>> device_info_list_;
   char engine_name_[32] = "Zinvul";
+  double memory_budget_ratio_ = 0.9;
 };
 
 } // namespace zinvul
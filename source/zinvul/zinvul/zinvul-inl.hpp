@@ -24,15 +24,18 @@
 #include "zisc/utility.hpp"
 // Zinvul
 #include "buffer.hpp"
+#include "command_list.hpp"
 #include "device.hpp"
 //#include "kernel.hpp"
 //#include "kernel_set.hpp"
 //#include "kernel_arg_parser.hpp"
 #include "cpu/cpu_buffer.hpp"
+#include "cpu/cpu_command_list.hpp"
 #include "cpu/cpu_device.hpp"
 //#include "cpu/cpu_kernel.hpp"
 #if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
 #include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_command_list.hpp"
 #include "vulkan/vulkan_device.hpp"
 //#include "vulkan/vulkan_kernel.hpp"
 #endif // ZINVUL_ENABLE_VULKAN_SUB_PLATFORM
@@ -73,6 +76,37 @@ SharedBuffer<Type> makeBuffer(Device* device, const BufferUsage flag)
   return buffer;
 }
 
+/*!
+  \details No detailed description
+
+  \param [in,out] device No description.
+  \return No description
+  */
+inline
+SharedCommandList makeCommandList(Device* device)
+{
+  SharedCommandList command_list;
+  switch (device->type()) {
+   case SubPlatformType::kCpu: {
+    auto d = zisc::cast<CpuDevice*>(device);
+    command_list = d->makeCommandList();
+    break;
+   }
+#if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
+   case SubPlatformType::kVulkan: {
+    auto d = zisc::cast<VulkanDevice*>(device);
+    command_list = d->makeCommandList();
+    break;
+   }
+#endif // ZINVUL_ENABLE_VULKAN_SUB_PLATFORM
+   default: {
+    ZISC_ASSERT(false, "Error: Unsupported device type is specified.");
+    break;
+   }
+  }
+  return command_list;
+}
+
 ///*!
 //  */
 //template <DescriptorType kDescriptor1, DescriptorType kDescriptor2, typename Type>
@@ -19,16 +19,22 @@
 #include <cstddef>
 // Zinvul
 #include "buffer.hpp"
+#include "command_list.hpp"
 #include "device.hpp"
+#include "fence.hpp"
 #include "platform.hpp"
 #include "platform_options.hpp"
+#include "split_launcher.hpp"
+#include "task_graph.hpp"
 //#include "kernel_arg_parser.hpp"
 //#include "kernel_set.hpp"
 #include "cpu/cpu_buffer.hpp"
+#include "cpu/cpu_command_list.hpp"
 #include "cpu/cpu_device.hpp"
 //#include "cpu/cpu_kernel.hpp"
 #if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
 #include "vulkan/vulkan_buffer.hpp"
+#include "vulkan/vulkan_command_list.hpp"
 #include "vulkan/vulkan_device.hpp"
 //#include "vulkan/vulkan_kernel.hpp"
 #endif // ZINVUL_ENABLE_VULKAN_SUB_PLATFORM
@@ -42,6 +48,9 @@ namespace zinvul {
 template <typename Type>
 SharedBuffer<Type> makeBuffer(Device* device, const BufferUsage flag);
 
+//! Make a command list
+SharedCommandList makeCommandList(Device* device);
+
 ////! Copy a src buffer to a dst buffer
 //template <DescriptorType kDescriptor1, DescriptorType kDescriptor2, typename Type>
 //void copy(const Buffer<kDescriptor1, Type>& src,
@@ -65,6 +65,57 @@ enum class BufferUsage : uint32b
   kDeviceToHost = 0b1u << 3,
 };
 
+/*!
+  \brief The placement of the memory of cpu buffers on NUMA nodes
+
+  No detailed description.
+  */
+enum class CpuMemoryPolicy : uint32b
+{
+  kFirstTouch = 0, //!< Place a page on the node of the thread which touches it first
+  kInterleave, //!< Interleave pages across all nodes
+  kWorkerLocal //!< Place pages on the node of the worker which owns the matching work range
+};
+
+/*!
+  \brief The placement of the cpu worker threads on the cores of the host
+
+  No detailed description.
+  */
+enum class CpuCorePolicy : uint32b
+{
+  kAny = 0, //!< Leave the placement to the scheduler of the OS
+  kPhysicalCore, //!< Pin a worker to each physical core, fast cores first
+  kLogicalCore //!< Pin a worker to each logical core, physical cores first
+};
+
+/*!
+  \brief The use of huge pages for the memory of large cpu buffers
+
+  No detailed description.
+  */
+enum class CpuHugePagePolicy : uint32b
+{
+  kNone = 0, //!< Use the normal pages
+  kTransparent, //!< Advise the kernel to back the memory with transparent huge pages
+  kExplicit //!< Map the memory from the reserved huge pages, transparent huge pages on failure
+};
+
+// Kernel
+
+/*!
+  \brief The order in which cpu workers traverse the work-groups of a launch
+
+  No detailed description.
+  */
+enum class TraversalOrder : uint32b
+{
+  kRowMajor = 0, //!< Traverse the work-groups in x, y and z order
+  kTiled, //!< Traverse rectangular tiles of work-groups in row-major order
+  kMorton, //!< Traverse the tiles along a Morton (Z-order) curve
+  kHilbert //!< Traverse the tiles along a Hilbert curve
+};
+
 /*!
   \brief config values in zinvul
 
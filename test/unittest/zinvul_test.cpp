@@ -13,12 +13,19 @@
   */
 
 // Standard C++ library
-//#include <algorithm>
-//#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 //#include <cstring>
 //#include <iostream>
 #include <memory>
-//#include <string>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
 // GoogleTest
 #include "gtest/gtest.h"
@@ -29,7 +36,18 @@
 #include "zisc/utility.hpp"
 // Zinvul
 #include "zinvul/zinvul.hpp"
+#include "zinvul/cpu/cpu_buffer.hpp"
+#include "zinvul/cpu/cpu_device.hpp"
+#include "zinvul/cpu/cpu_device_info.hpp"
+#include "zinvul/cpu/utility/huge_page_memory_resource.hpp"
+#include "zinvul/cpu/utility/numa_topology.hpp"
+#include "zinvul/cpu/utility/task_batch_tuner.hpp"
+#include "zinvul/cpu/utility/work_traversal.hpp"
+#include "zinvul/cppcl/synchronization.hpp"
+#include "zinvul/cppcl/utility.hpp"
 #if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
+#include "zinvul/vulkan/vulkan_buffer.hpp"
+#include "zinvul/vulkan/vulkan_device.hpp"
 #include "zinvul/vulkan/vulkan_sub_platform.hpp"
 #include "zinvul/vulkan/utility/vulkan.hpp"
 #include "zinvul/vulkan/utility/vulkan_dispatch_loader.hpp"
@@ -37,6 +55,1215 @@
 //#include "zinvul/kernel_set/experiment.hpp"
 //#include "test.hpp"
 
+namespace {
+
+/*!
+  \details No detailed description
+
+  \param [in] platform No description.
+  \return No description
+  */
+std::size_t getCpuDeviceIndex(const zinvul::Platform& platform) noexcept
+{
+  std::size_t index = 0;
+  const auto& device_info_list = platform.deviceInfoList();
+  for (index = 0; index < device_info_list.size(); ++index) {
+    const auto& info = device_info_list[index];
+    if (info->type() == zinvul::SubPlatformType::kCpu)
+      break;
+  }
+  return index;
+}
+
+/*!
+  \brief A platform and its cpu device which a test runs on
+  */
+struct CpuTestDevice
+{
+  zinvul::UniquePlatform platform_;
+  zinvul::SharedDevice device_;
+};
+
+/*!
+  \details The function sets the options of the test on the options of the
+  platform. The device is null if the cpu sub-platform isn't available
+
+  \tparam Function No description.
+  \param [in] mem_resource No description.
+  \param [in] platform_name No description.
+  \param [in] set_options No description.
+  \return No description
+  */
+template <typename Function>
+CpuTestDevice makeCpuDevice(zisc::pmr::memory_resource* mem_resource,
+                            std::string_view platform_name,
+                            Function&& set_options)
+{
+  zinvul::PlatformOptions platform_options{mem_resource};
+  platform_options.setPlatformName(platform_name);
+  set_options(platform_options);
+
+  CpuTestDevice test_device;
+  test_device.platform_ = zinvul::makePlatform(mem_resource);
+  test_device.platform_->initialize(platform_options);
+  if (test_device.platform_->hasSubPlatform(zinvul::SubPlatformType::kCpu)) {
+    const std::size_t index = getCpuDeviceIndex(*test_device.platform_);
+    test_device.device_ = test_device.platform_->makeDevice(index);
+  }
+  return test_device;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  \param [in] platform_name No description.
+  \return No description
+  */
+CpuTestDevice makeCpuDevice(zisc::pmr::memory_resource* mem_resource,
+                            std::string_view platform_name)
+{
+  return makeCpuDevice(mem_resource, platform_name,
+                       [](zinvul::PlatformOptions&) noexcept {});
+}
+
+#if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
+
+/*!
+  \brief A platform and its vulkan device which a test runs on
+  */
+struct VulkanTestDevice
+{
+  zinvul::UniquePlatform platform_;
+  zinvul::SharedDevice device_;
+};
+
+/*!
+  \details The function sets the options of the test on the options of the
+  platform. The device is null if the vulkan sub-platform isn't available
+
+  \tparam Function No description.
+  \param [in] mem_resource No description.
+  \param [in] platform_name No description.
+  \param [in] set_options No description.
+  \return No description
+  */
+template <typename Function>
+VulkanTestDevice makeVulkanDevice(zisc::pmr::memory_resource* mem_resource,
+                                  std::string_view platform_name,
+                                  Function&& set_options)
+{
+  zinvul::PlatformOptions platform_options{mem_resource};
+  platform_options.setPlatformName(platform_name);
+  platform_options.enableVulkanSubPlatform(true);
+  platform_options.enableDebugMode(true);
+  set_options(platform_options);
+
+  VulkanTestDevice test_device;
+  test_device.platform_ = zinvul::makePlatform(mem_resource);
+  test_device.platform_->initialize(platform_options);
+  if (test_device.platform_->hasSubPlatform(zinvul::SubPlatformType::kVulkan)) {
+    std::size_t index = 0;
+    const auto& device_info_list = test_device.platform_->deviceInfoList();
+    for (index = 0; index < device_info_list.size(); ++index) {
+      const auto& info = device_info_list[index];
+      if (info->type() == zinvul::SubPlatformType::kVulkan)
+        break;
+    }
+    test_device.device_ = test_device.platform_->makeDevice(index);
+  }
+  return test_device;
+}
+
+/*!
+  \details No detailed description
+
+  \param [in] mem_resource No description.
+  \param [in] platform_name No description.
+  \return No description
+  */
+VulkanTestDevice makeVulkanDevice(zisc::pmr::memory_resource* mem_resource,
+                                  std::string_view platform_name)
+{
+  return makeVulkanDevice(mem_resource, platform_name,
+                          [](zinvul::PlatformOptions&) noexcept {});
+}
+
+#endif // ZINVUL_ENABLE_VULKAN_SUB_PLATFORM
+
+} // namespace
+
+TEST(CpuSubPlatformTest, SubmitTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "SubmitTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuTaskBatchSize(3);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 3> work_size{{17, 13, 5}};
+  constexpr std::size_t num_of_works = work_size[0] * work_size[1] * work_size[2];
+  std::vector<std::atomic<uint32b>> counter_list(num_of_works);
+  auto command = [&counter_list, &work_size]()
+  {
+    namespace cl = zinvul::cl;
+    const std::size_t x = cl::get_global_id(0);
+    const std::size_t y = cl::get_global_id(1);
+    const std::size_t z = cl::get_global_id(2);
+    const std::size_t index = x + work_size[0] * (y + work_size[1] * z);
+    ++counter_list[index];
+  };
+  const auto fence = cpu_device->submit(work_size, 0, 0, command);
+  fence.wait();
+
+  for (std::size_t i = 0; i < num_of_works; ++i)
+    ASSERT_EQ(1, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+}
+
+TEST(CpuSubPlatformTest, WorkGroupBarrierTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "WorkGroupBarrierTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuWorkGroupSize(64);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  ASSERT_EQ(64, device->deviceInfo().workGroupSize());
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  constexpr uint32b num_of_works = 64 * 32;
+  std::vector<uint32b> input_list(num_of_works, 0);
+  std::vector<uint32b> output_list(num_of_works, 0);
+  // Each work-item reads the value which is written by the mirrored work-item
+  auto command = [&input_list, &output_list]()
+  {
+    namespace cl = zinvul::cl;
+    const std::size_t global_id = cl::get_global_id(0);
+    const std::size_t local_id = cl::get_local_id(0);
+    const std::size_t local_size = cl::get_local_size(0);
+    input_list[global_id] = zisc::cast<uint32b>(global_id);
+    cl::barrier(cl::CLK_LOCAL_MEM_FENCE);
+    const std::size_t mirror = global_id - local_id + (local_size - local_id - 1);
+    output_list[global_id] = input_list[mirror];
+  };
+  const std::array<uint32b, 1> work_size{{num_of_works}};
+  const auto fence = cpu_device->submit(work_size, 0, 0, command);
+  fence.wait();
+
+  for (uint32b i = 0; i < num_of_works; ++i) {
+    const uint32b mirror = (i / 64) * 64 + (63 - (i % 64));
+    ASSERT_EQ(mirror, output_list[i]) << "Work-item " << i << " isn't synchronized.";
+  }
+}
+
+TEST(CpuSubPlatformTest, LocalMemoryTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "LocalMemoryTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuWorkGroupSize(64);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  constexpr uint32b num_of_works = 64 * 32;
+  std::vector<uint32b> output_list(num_of_works, 0);
+  // The work-items of a group exchange values through the local memory
+  auto command = [&output_list]()
+  {
+    namespace cl = zinvul::cl;
+    auto local_memory = cl::inner::WorkGroup::getLocalMemory();
+    auto storage = zisc::cast<uint32b*>(local_memory);
+    const std::size_t global_id = cl::get_global_id(0);
+    const std::size_t local_id = cl::get_local_id(0);
+    const std::size_t local_size = cl::get_local_size(0);
+    storage[local_id] = zisc::cast<uint32b>(global_id);
+    cl::barrier(cl::CLK_LOCAL_MEM_FENCE);
+    output_list[global_id] = storage[local_size - local_id - 1];
+  };
+  const std::array<uint32b, 1> work_size{{num_of_works}};
+  const auto fence = cpu_device->submit(work_size, 64 * sizeof(uint32b), 0, command);
+  fence.wait();
+
+  for (uint32b i = 0; i < num_of_works; ++i) {
+    const uint32b mirror = (i / 64) * 64 + (63 - (i % 64));
+    ASSERT_EQ(mirror, output_list[i]) << "Work-item " << i << " isn't shared.";
+  }
+}
+
+TEST(CpuSubPlatformTest, LockStepTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "LockStepTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuWorkGroupSize(16);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 2> work_size{{30, 7}};
+  constexpr std::size_t num_of_works = work_size[0] * work_size[1];
+  std::vector<std::atomic<uint32b>> counter_list(num_of_works);
+  std::atomic<uint32b> num_of_invalid_lanes{0};
+  // Each invocation processes the adjacent work-items of x dimension
+  auto command = [&counter_list, &num_of_invalid_lanes, &work_size]()
+  {
+    namespace cl = zinvul::cl;
+    const uint32b lane_size = cl::get_lane_size();
+    const auto x = cl::get_global_lane_id(0);
+    const auto y = cl::get_global_lane_id(1);
+    for (uint32b lane = 0; lane < lane_size; ++lane) {
+      if ((x[lane] != x[0] + lane) || (y[lane] != y[0]))
+        ++num_of_invalid_lanes;
+      if ((x[lane] < work_size[0]) && (y[lane] < work_size[1]))
+        ++counter_list[x[lane] + work_size[0] * y[lane]];
+    }
+  };
+  auto fence = cpu_device->submitLockStep(work_size, 0, 0, command);
+  fence.wait();
+  ASSERT_EQ(0, num_of_invalid_lanes.load()) << "The lane IDs are invalid.";
+  for (std::size_t i = 0; i < num_of_works; ++i)
+    ASSERT_EQ(1, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+
+  // The ordinary execution has a lane
+  fence = cpu_device->submit(work_size, 0, 0, command);
+  fence.wait();
+  for (std::size_t i = 0; i < num_of_works; ++i)
+    ASSERT_EQ(2, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+}
+
+TEST(CpuSubPlatformTest, TaskBatchTunerTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  using zinvul::uint32b;
+  using zinvul::uint64b;
+  constexpr uint32b initial_size = 32;
+  constexpr uint32b max_size = 256;
+  constexpr uint64b target_time = 50'000;
+  zinvul::TaskBatchTuner tuner{initial_size, max_size, target_time, &mem_resource};
+  const int light_id = 0;
+  const int heavy_id = 0;
+  ASSERT_EQ(initial_size, tuner.batchSize(&light_id)) <<
+      "The batch size of an unknown kernel isn't the initial size.";
+
+  // A group of the light kernel takes 100 ns, so 500 groups take the target
+  tuner.update(&light_id, 1000, 1000 * 100);
+  ASSERT_EQ(126, tuner.batchSize(&light_id)) <<
+      "The batch size isn't the geometric mean of the current and the ideal.";
+  ASSERT_EQ(initial_size, tuner.batchSize(&heavy_id)) <<
+      "The batch sizes of kernels aren't independent.";
+  for (uint32b i = 0; i < 3; ++i)
+    tuner.update(&light_id, 1000, 1000 * 100);
+  ASSERT_EQ(max_size, tuner.batchSize(&light_id)) <<
+      "The batch size isn't clamped to the max.";
+
+  // A group of the heavy kernel takes 20 us, so 2.5 groups take the target
+  tuner.update(&heavy_id, 64, 64 * 20'000);
+  ASSERT_EQ(9, tuner.batchSize(&heavy_id)) <<
+      "The batch size of the heavy kernel doesn't shrink.";
+  for (uint32b i = 0; i < 8; ++i)
+    tuner.update(&heavy_id, 64, 64 * 20'000);
+  ASSERT_LE(2, tuner.batchSize(&heavy_id)) << "The batch size doesn't converge.";
+  ASSERT_GE(3, tuner.batchSize(&heavy_id)) << "The batch size doesn't converge.";
+
+  // A group which exceeds the target alone is batched one by one
+  tuner.update(&heavy_id, 1, 1'000'000'000);
+  tuner.update(&heavy_id, 1, 1'000'000'000);
+  ASSERT_EQ(1, tuner.batchSize(&heavy_id)) << "The batch size isn't clamped to 1.";
+  // An empty measurement is ignored
+  tuner.update(&heavy_id, 0, 0);
+  ASSERT_EQ(1, tuner.batchSize(&heavy_id)) << "An empty measurement isn't ignored.";
+}
+
+TEST(CpuSubPlatformTest, AdaptiveTaskBatchTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "AdaptiveTaskBatchTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuTaskBatchSize(32);
+    options.setCpuTaskBatchTime(50);
+    options.enableCpuAdaptiveTaskBatch(true);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  // The work is completed while the batch size changes between the launches
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 1> work_size{{1 << 14}};
+  std::vector<std::atomic<uint32b>> counter_list(work_size[0]);
+  const int kernel_id = 0;
+  auto command = [&counter_list]()
+  {
+    ++counter_list[zinvul::cl::get_global_id(0)];
+  };
+  constexpr uint32b num_of_launches = 3;
+  for (uint32b i = 0; i < num_of_launches; ++i) {
+    auto fence = cpu_device->submit(work_size, 0, 0, &kernel_id, command);
+    fence.wait();
+    const std::size_t batch_size = cpu_device->taskBatchSize(&kernel_id);
+    ASSERT_LE(1, batch_size) << "The batch size is out of range.";
+    ASSERT_GE(zinvul::CpuSubPlatform::maxTaskBatchSize(), batch_size) <<
+        "The batch size is out of range.";
+  }
+  for (std::size_t i = 0; i < work_size[0]; ++i) {
+    ASSERT_EQ(num_of_launches, counter_list[i].load()) <<
+        "Work-item " << i << " isn't executed.";
+  }
+}
+
+TEST(CpuSubPlatformTest, TaskGraphTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "TaskGraphTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuNumOfQueues(3);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+  ASSERT_EQ(3, device->numOfQueues()) << "The number of queues is wrong.";
+
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 1> work_size{{1024}};
+  constexpr std::size_t n = work_size[0];
+  auto a = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  a->setSize(n);
+  auto b = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  b->setSize(n);
+  auto c = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  c->setSize(n);
+  auto d = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceToHost);
+  d->setSize(n);
+  auto mem_a = a->mapMemory();
+  auto mem_b = b->mapMemory();
+  auto mem_c = c->mapMemory();
+
+  zinvul::TaskGraph graph{device.get(), std::addressof(mem_resource)};
+  using Graph = zinvul::TaskGraph;
+  // Two independent tasks
+  const std::size_t t0 = graph.addTask([cpu_device, &work_size, &mem_a](const uint32b q)
+  {
+    return cpu_device->submit(work_size, 0, q, [&mem_a]()
+    {
+      const uint32b i = zinvul::cl::get_global_id(0);
+      mem_a[i] = i;
+    });
+  }, {Graph::write(*a)});
+  const std::size_t t1 = graph.addTask([cpu_device, &work_size, &mem_b](const uint32b q)
+  {
+    return cpu_device->submit(work_size, 0, q, [&mem_b]()
+    {
+      const uint32b i = zinvul::cl::get_global_id(0);
+      mem_b[i] = 2 * i;
+    });
+  }, {Graph::write(*b)});
+  // A task which joins them
+  const std::size_t t2 = graph.addTask([cpu_device, &work_size, &mem_a, &mem_b, &mem_c](const uint32b q)
+  {
+    return cpu_device->submit(work_size, 0, q, [&mem_a, &mem_b, &mem_c]()
+    {
+      const uint32b i = zinvul::cl::get_global_id(0);
+      mem_c[i] = mem_a[i] + mem_b[i];
+    });
+  }, {Graph::read(*a), Graph::read(*b), Graph::write(*c)});
+  const std::size_t t3 = graph.addCopy(*c, d.get(), n, 0, 0);
+  ASSERT_EQ(4, graph.numOfTasks()) << "The number of tasks is wrong.";
+
+  std::size_t num_of_dependencies = 0;
+  graph.dependencies(t1, &num_of_dependencies);
+  ASSERT_EQ(0, num_of_dependencies) << "The independent task has dependencies.";
+  const uint32b* dependencies = graph.dependencies(t2, &num_of_dependencies);
+  ASSERT_EQ(2, num_of_dependencies) << "The join task doesn't depend on the both tasks.";
+  ASSERT_EQ(t0, dependencies[0]) << "The dependency of the join task is wrong.";
+  ASSERT_EQ(t1, dependencies[1]) << "The dependency of the join task is wrong.";
+  dependencies = graph.dependencies(t3, &num_of_dependencies);
+  ASSERT_EQ(1, num_of_dependencies) << "The copy task has wrong dependencies.";
+  ASSERT_EQ(t2, dependencies[0]) << "The dependency of the copy task is wrong.";
+
+  for (uint32b iteration = 0; iteration < 2; ++iteration) {
+    graph.run();
+    graph.waitForCompletion();
+    ASSERT_NE(graph.queueIndex(t0), graph.queueIndex(t1)) <<
+        "The independent tasks are submitted to the same queue.";
+    std::vector<uint32b> result(n);
+    d->read(result.data(), n, 0, 0);
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(3 * i, result[i]) << "The element " << i << " is wrong.";
+  }
+}
+
+TEST(CpuSubPlatformTest, CommandListTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "CommandListTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 1> work_size{{1024}};
+  constexpr std::size_t n = work_size[0];
+  auto src = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  src->setSize(n);
+  auto dst = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceToHost);
+  dst->setSize(n);
+  auto mem = src->mapMemory();
+  for (std::size_t i = 0; i < n; ++i)
+    mem[i] = 0;
+
+  auto command_list = zinvul::makeCommandList(device.get());
+  ASSERT_EQ(zinvul::SubPlatformType::kCpu, command_list->type()) <<
+      "The command list type is wrong.";
+  auto cpu_list = zisc::cast<zinvul::CpuCommandList*>(command_list.get());
+  cpu_list->addKernel(work_size, 0, nullptr, false, [&mem]()
+  {
+    const uint32b i = zinvul::cl::get_global_id(0);
+    mem[i] += i;
+  });
+  command_list->recordCopy(*src, dst.get(), n, 0, 0);
+  ASSERT_EQ(2, command_list->numOfCommands()) << "The commands aren't recorded.";
+
+  // The recorded commands are executed in order at each replay
+  constexpr uint32b num_of_replays = 3;
+  for (uint32b i = 0; i < num_of_replays; ++i)
+    command_list->replay(0);
+  command_list->waitForCompletion();
+  ASSERT_TRUE(command_list->isClosed()) << "The command list isn't closed.";
+  std::vector<uint32b> result(n);
+  dst->read(result.data(), n, 0, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    ASSERT_EQ(num_of_replays * i, result[i]) << "The element " << i << " is wrong.";
+
+  command_list->clear();
+  ASSERT_FALSE(command_list->isClosed()) << "The command list isn't reopened.";
+  ASSERT_EQ(0, command_list->numOfCommands()) << "The commands aren't cleared.";
+  const auto fence = command_list->replay(0);
+  ASSERT_FALSE(fence) << "An empty command list is submitted.";
+}
+
+TEST(CpuSubPlatformTest, BatchLaunchTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "BatchLaunchTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 2> work_size{{30, 7}};
+  constexpr std::size_t num_of_works = work_size[0] * work_size[1];
+  std::vector<std::atomic<uint32b>> counter_list(num_of_works);
+  // An invocation processes the work-groups in the range
+  auto command = [&counter_list, &work_size](const uint32b begin,
+                                             const uint32b end)
+  {
+    namespace cl = zinvul::cl;
+    for (uint32b id = begin; id < end; ++id) {
+      cl::inner::WorkGroup::setWorkGroupId(id);
+      const uint32b lane_size = cl::get_lane_size();
+      const auto x = cl::get_global_lane_id(0);
+      const auto y = cl::get_global_lane_id(1);
+      for (uint32b lane = 0; lane < lane_size; ++lane) {
+        if ((x[lane] < work_size[0]) && (y[lane] < work_size[1]))
+          ++counter_list[x[lane] + work_size[0] * y[lane]];
+      }
+    }
+  };
+  const uint32b lane_size = zinvul::cl::inner::WorkGroup::lockStepLaneSize();
+  auto fence = cpu_device->submitBatch(work_size, lane_size, 0, nullptr, command);
+  fence.wait();
+  for (std::size_t i = 0; i < num_of_works; ++i)
+    ASSERT_EQ(1, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+
+  // A recorded batch command is executed in the same way
+  auto command_list = zinvul::makeCommandList(device.get());
+  auto cpu_list = zisc::cast<zinvul::CpuCommandList*>(command_list.get());
+  cpu_list->addBatchKernel(work_size, 1, nullptr, command);
+  command_list->replay(0);
+  command_list->waitForCompletion();
+  for (std::size_t i = 0; i < num_of_works; ++i)
+    ASSERT_EQ(2, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+}
+
+TEST(CpuSubPlatformTest, TraversalOrderTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "TraversalOrderTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuWorkGroupSize(16);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  // The consecutive cells of a Hilbert curve are adjacent
+  constexpr uint32b curve_order = 3;
+  constexpr uint32b curve_size = 1u << curve_order;
+  std::vector<std::array<uint32b, 2>> curve(curve_size * curve_size);
+  for (uint32b y = 0; y < curve_size; ++y) {
+    for (uint32b x = 0; x < curve_size; ++x) {
+      const auto i = zinvul::WorkTraversal::hilbertIndex(x, y, curve_order);
+      curve[i] = {{x, y}};
+    }
+  }
+  for (std::size_t i = 1; i < curve.size(); ++i) {
+    const uint32b d = std::max(curve[i][0], curve[i - 1][0]) -
+                      std::min(curve[i][0], curve[i - 1][0]) +
+                      std::max(curve[i][1], curve[i - 1][1]) -
+                      std::min(curve[i][1], curve[i - 1][1]);
+    ASSERT_EQ(1, d) << "The Hilbert curve isn't continuous at " << i << ".";
+  }
+
+  // Every work-item is executed once in any order
+  constexpr std::array<uint32b, 2> work_size{{100, 70}};
+  constexpr std::size_t num_of_works = work_size[0] * work_size[1];
+  std::vector<std::atomic<uint32b>> counter_list(num_of_works);
+  auto command = [&counter_list, &work_size]()
+  {
+    const auto x = zinvul::cl::get_global_id(0);
+    const auto y = zinvul::cl::get_global_id(1);
+    if ((x < work_size[0]) && (y < work_size[1]))
+      ++counter_list[x + work_size[0] * y];
+  };
+  constexpr std::array<zinvul::TraversalOrder, 4> order_list{{
+      zinvul::TraversalOrder::kRowMajor,
+      zinvul::TraversalOrder::kTiled,
+      zinvul::TraversalOrder::kMorton,
+      zinvul::TraversalOrder::kHilbert}};
+  constexpr std::array<uint32b, 2> tile_size{{16, 8}};
+  for (std::size_t n = 0; n < order_list.size(); ++n) {
+    const zinvul::WorkLayout work_layout{order_list[n], tile_size};
+    auto fence = cpu_device->submit(work_size, 0, 0, nullptr, work_layout, command);
+    fence.wait();
+    for (std::size_t i = 0; i < num_of_works; ++i) {
+      ASSERT_EQ(n + 1, counter_list[i].load()) << "Work-item " << i <<
+          " isn't executed once in the order " << n << ".";
+    }
+  }
+}
+
+TEST(CpuSubPlatformTest, WorkGroupContextTest)
+{
+  using zinvul::uint32b;
+  using zinvul::cl::inner::WorkGroup;
+  namespace cl = zinvul::cl;
+  constexpr std::array<uint32b, 3> num_of_groups{{3, 4, 5}};
+  constexpr std::array<uint32b, 3> local_work_size{{8, 2, 1}};
+  WorkGroup::setWorkGroupSize(num_of_groups);
+  WorkGroup::setLocalWorkSize(local_work_size);
+  WorkGroup::setLaneSize(1);
+  WorkGroup::setLocalWorkId(3);
+
+  // The incremental ids match the ids which are expanded from linear ids
+  constexpr uint32b total = num_of_groups[0] * num_of_groups[1] * num_of_groups[2];
+  std::array<std::array<uint32b, 3>, total> expected_list;
+  for (uint32b id = 0; id < total; ++id) {
+    WorkGroup::setWorkGroupId(id);
+    for (uint32b d = 0; d < 3; ++d)
+      expected_list[id][d] = zisc::cast<uint32b>(cl::get_global_id(d));
+  }
+  WorkGroup::setWorkGroupId(0);
+  for (uint32b id = 0; id < total; ++id) {
+    if (0 < id)
+      WorkGroup::nextWorkGroupId();
+    for (uint32b d = 0; d < 3; ++d) {
+      const uint32b expected = zisc::cast<uint32b>(cl::get_group_id(d)) *
+                               local_work_size[d] +
+                               zisc::cast<uint32b>(cl::get_local_id(d));
+      ASSERT_EQ(expected, expected_list[id][d]) <<
+          "The global id of the work-group " << id << " is wrong.";
+      ASSERT_EQ(expected_list[id][d], cl::get_global_id(d)) <<
+          "The work-group id " << id << " isn't advanced correctly.";
+    }
+  }
+}
+
+TEST(CpuSubPlatformTest, GlobalOffsetTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "GlobalOffsetTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuWorkGroupSize(16);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  using zinvul::uint32b;
+  // A range is split into two sub-range launches
+  constexpr std::array<uint32b, 2> range_size{{100, 70}};
+  constexpr std::size_t num_of_works = range_size[0] * range_size[1];
+  std::vector<std::atomic<uint32b>> counter_list(num_of_works);
+  constexpr uint32b split = 30;
+  constexpr std::array<std::array<uint32b, 2>, 2> offset_list{{{{0, 0}},
+                                                               {{0, split}}}};
+  constexpr std::array<std::array<uint32b, 2>, 2> size_list{{
+      {{range_size[0], split}},
+      {{range_size[0], range_size[1] - split}}}};
+  constexpr std::array<zinvul::TraversalOrder, 2> order_list{{
+      zinvul::TraversalOrder::kRowMajor,
+      zinvul::TraversalOrder::kTiled}};
+  std::atomic<uint32b> num_of_wrong_offsets{0};
+  for (std::size_t n = 0; n < offset_list.size(); ++n) {
+    const auto& offset = offset_list[n];
+    const auto& work_size = size_list[n];
+    auto command = [&counter_list, &num_of_wrong_offsets, &offset, &work_size,
+                    &range_size]()
+    {
+      namespace cl = zinvul::cl;
+      if ((cl::get_global_offset(0) != offset[0]) ||
+          (cl::get_global_offset(1) != offset[1]))
+        ++num_of_wrong_offsets;
+      const auto x = cl::get_global_id(0);
+      const auto y = cl::get_global_id(1);
+      if ((x < offset[0] + work_size[0]) && (y < offset[1] + work_size[1]))
+        ++counter_list[x + range_size[0] * y];
+    };
+    zinvul::WorkLayout work_layout{order_list[n], std::array<uint32b, 2>{{16, 8}}};
+    work_layout.setGlobalOffset(offset);
+    auto fence = cpu_device->submit(work_size, 0, 0, nullptr, work_layout, command);
+    fence.wait();
+  }
+  ASSERT_EQ(0, num_of_wrong_offsets.load()) << "The global offset is wrong.";
+  for (std::size_t i = 0; i < num_of_works; ++i) {
+    ASSERT_EQ(1, counter_list[i].load()) << "Work-item " << i <<
+        " isn't executed once.";
+  }
+}
+
+TEST(CpuSubPlatformTest, SplitLaunchTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "SplitLaunchTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(2);
+    options.setCpuWorkGroupSize(16);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  // Two devices process the parts of a range
+  using zinvul::uint32b;
+  constexpr std::array<uint32b, 2> work_size{{64, 90}};
+  constexpr std::size_t num_of_works = work_size[0] * work_size[1];
+  constexpr std::size_t num_of_devices = 2;
+  std::array<zinvul::SharedDevice, num_of_devices> device_list;
+  std::array<zinvul::SharedBuffer<uint32b>, num_of_devices> buffer_list;
+  zinvul::SplitLauncher launcher{&mem_resource};
+  for (std::size_t i = 0; i < num_of_devices; ++i) {
+    device_list[i] = (i == 0) ? device
+                              : platform->makeDevice(getCpuDeviceIndex(*platform));
+    buffer_list[i] = device_list[i]->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceToHost);
+    buffer_list[i]->setSize(num_of_works);
+    launcher.addDevice(device_list[i].get(), zisc::cast<double>(i + 1));
+  }
+  ASSERT_EQ(num_of_devices, launcher.numOfDevices()) << "Adding devices failed.";
+
+  auto launch = [&device_list, &buffer_list, &work_size](
+      const std::size_t device_index,
+      const std::array<uint32b, 2>& offset,
+      const std::array<uint32b, 2>& size)
+  {
+    auto device = zisc::cast<zinvul::CpuDevice*>(device_list[device_index].get());
+    auto buffer = zisc::cast<zinvul::CpuBuffer<uint32b>*>(buffer_list[device_index].get());
+    uint32b* output = buffer->data();
+    auto command = [output, offset, size, &work_size]()
+    {
+      const auto x = zinvul::cl::get_global_id(0);
+      const auto y = zinvul::cl::get_global_id(1);
+      if ((x < offset[0] + size[0]) && (y < offset[1] + size[1])) {
+        const std::size_t i = x + work_size[0] * y;
+        output[i] = zisc::cast<uint32b>(i);
+      }
+    };
+    zinvul::WorkLayout work_layout;
+    work_layout.setGlobalOffset(offset);
+    return device->submit(size, 0, 0, nullptr, work_layout, command);
+  };
+
+  std::vector<uint32b> result(num_of_works);
+  for (std::size_t n = 0; n < 3; ++n) {
+    std::fill(result.begin(), result.end(), 0u);
+    launcher.run(work_size, launch);
+    // The parts cover the range in the order of the devices
+    uint32b end = 0;
+    for (std::size_t i = 0; i < num_of_devices; ++i) {
+      uint32b part_begin = 0,
+              part_end = 0;
+      launcher.getPart(i, &part_begin, &part_end);
+      ASSERT_EQ(end, part_begin) << "The part " << i << " isn't contiguous.";
+      end = part_end;
+      ASSERT_LT(0.0, launcher.throughput(i)) << "The throughput isn't learned.";
+      if (part_begin < part_end) {
+        ASSERT_LT(0, launcher.executionTime(i).count()) <<
+            "The execution time isn't recorded.";
+      }
+      launcher.gather(i, *buffer_list[i], result.data());
+    }
+    ASSERT_EQ(work_size[1], end) << "The parts don't cover the range.";
+    for (std::size_t i = 0; i < num_of_works; ++i)
+      ASSERT_EQ(i, result[i]) << "The gathered element " << i << " is wrong.";
+  }
+}
+
+TEST(CpuSubPlatformTest, NumaTopologyTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  using zinvul::uint32b;
+  {
+    zisc::pmr::vector<uint32b> id_list{&mem_resource};
+    zinvul::NumaTopology::parseIdList("0-3,8,10-11\n", &id_list);
+    const std::vector<uint32b> expected{0, 1, 2, 3, 8, 10, 11};
+    ASSERT_EQ(expected.size(), id_list.size()) << "Parsing the id list failed.";
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(expected[i], id_list[i]) << "Parsing the id list failed.";
+  }
+
+  zinvul::NumaTopology topology{&mem_resource};
+  topology.fetch();
+  ASSERT_LE(std::size_t{1}, topology.numOfNodes()) << "Fetching the topology failed.";
+  // The workers are assigned to the nodes in order
+  constexpr std::size_t num_of_workers = 7;
+  for (std::size_t i = 1; i < num_of_workers; ++i) {
+    const std::size_t prev = topology.getWorkerNode(i - 1, num_of_workers);
+    const std::size_t node = topology.getWorkerNode(i, num_of_workers);
+    ASSERT_LE(prev, node) << "The worker nodes aren't in order.";
+    ASSERT_LT(node, topology.numOfNodes()) << "The worker node is out of range.";
+  }
+
+  // The buffers are available with any memory policy
+  auto [platform, device] = makeCpuDevice(&mem_resource, "NumaTopologyTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+    options.setCpuMemoryPolicy(zinvul::CpuMemoryPolicy::kWorkerLocal);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  constexpr std::size_t n = 1 << 16;
+  auto buffer = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  buffer->setSize(n);
+  std::vector<uint32b> host_data(n);
+  for (std::size_t i = 0; i < n; ++i)
+    host_data[i] = zisc::cast<uint32b>(i);
+  buffer->write(host_data.data(), n, 0, 0);
+  std::vector<uint32b> result(n);
+  buffer->read(result.data(), n, 0, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " is invalid.";
+}
+
+TEST(CpuSubPlatformTest, CoreTopologyTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  using zinvul::uint32b;
+  zinvul::NumaTopology topology{&mem_resource};
+  topology.fetch();
+  const std::size_t num_of_physical_cores = topology.numOfPhysicalCores();
+  ASSERT_LE(std::size_t{1}, topology.numOfPerformanceCores()) <<
+      "Fetching the cores failed.";
+  ASSERT_LE(topology.numOfPerformanceCores(), num_of_physical_cores) <<
+      "The number of performance cores is wrong.";
+  ASSERT_LE(num_of_physical_cores, topology.numOfLogicalCores()) <<
+      "The number of physical cores is wrong.";
+  // The physical cores are sorted from the fastest
+  constexpr uint32b max_capacity = zinvul::NumaTopology::maxCoreCapacity();
+  ASSERT_EQ(max_capacity, topology.coreCapacity(0)) <<
+      "The first core isn't the fastest.";
+  std::vector<uint32b> id_list;
+  for (std::size_t i = 0; i < topology.numOfLogicalCores(); ++i) {
+    const uint32b capacity = topology.coreCapacity(i);
+    ASSERT_LT(0u, capacity) << "The capacity of the core " << i << " is wrong.";
+    ASSERT_LE(capacity, max_capacity) << "The capacity of the core " << i << " is wrong.";
+    if ((0 < i) && (i < num_of_physical_cores)) {
+      ASSERT_LE(capacity, topology.coreCapacity(i - 1)) <<
+          "The physical cores aren't sorted.";
+    }
+    id_list.emplace_back(topology.coreId(i));
+  }
+  std::sort(id_list.begin(), id_list.end());
+  ASSERT_TRUE(std::adjacent_find(id_list.begin(), id_list.end()) == id_list.end()) <<
+      "The logical cores are duplicated.";
+
+  // A worker runs on each physical core
+  auto [platform, device] = makeCpuDevice(&mem_resource, "CoreTopologyTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuCorePolicy(zinvul::CpuCorePolicy::kPhysicalCore);
+    options.enableCpuNumaPinning(false);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  const auto device_info = zisc::cast<const zinvul::CpuDeviceInfo*>(&device->deviceInfo());
+  ASSERT_EQ(num_of_physical_cores, device_info->numOfPhysicalCores()) <<
+      "The device info doesn't have the cores.";
+  ASSERT_EQ(topology.isSmt(), device_info->isSmt()) <<
+      "The device info doesn't have the cores.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+  ASSERT_EQ(num_of_physical_cores, cpu_device->numOfThreads()) <<
+      "The number of workers isn't the number of physical cores.";
+
+  constexpr std::array<uint32b, 1> work_size{{1 << 14}};
+  std::vector<std::atomic<uint32b>> counter_list(work_size[0]);
+  auto command = [&counter_list]()
+  {
+    const auto id = zinvul::cl::get_global_id(0);
+    if (id < counter_list.size())
+      ++counter_list[id];
+  };
+  auto fence = cpu_device->submit(work_size, 0, 0, command);
+  fence.wait();
+  for (std::size_t i = 0; i < counter_list.size(); ++i)
+    ASSERT_EQ(1, counter_list[i].load()) << "Work-item " << i << " isn't executed once.";
+}
+
+TEST(CpuSubPlatformTest, MemoryRegistryTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "MemoryRegistryTest");
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  const auto& registry = device->memoryRegistry();
+
+  using zinvul::uint32b;
+  constexpr std::size_t n = 1024;
+  auto buffer1 = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  buffer1->id().setName("small \"buffer\"");
+  buffer1->id().setFileInfo(__FILE__, __LINE__);
+  buffer1->setSize(n);
+  auto buffer2 = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  buffer2->id().setName("large buffer");
+  buffer2->setSize(4 * n);
+  ASSERT_EQ(std::size_t{2}, registry.numOfEntries()) << "Registering failed.";
+  const std::size_t total_size = sizeof(uint32b) * (buffer1->capacity() +
+                                                    buffer2->capacity());
+  ASSERT_EQ(total_size, registry.totalSize()) << "The total size is wrong.";
+  ASSERT_EQ(total_size, device->totalMemoryUsage(0)) <<
+      "The registry doesn't match the memory usage.";
+
+  zisc::pmr::vector<zinvul::MemoryRegistry::Entry> entry_list{
+      zisc::pmr::vector<zinvul::MemoryRegistry::Entry>::allocator_type{&mem_resource}};
+  registry.getTopEntries(1, &entry_list);
+  ASSERT_EQ(std::size_t{1}, entry_list.size()) << "Getting the top entries failed.";
+  ASSERT_EQ(std::string_view{"large buffer"}, entry_list[0].name()) <<
+      "The largest buffer isn't the top.";
+  ASSERT_EQ(sizeof(uint32b) * buffer2->capacity(), entry_list[0].size_) <<
+      "The size of the entry is wrong.";
+
+  std::ostringstream json;
+  registry.writeJson(json);
+  const std::string snapshot = json.str();
+  ASSERT_NE(std::string::npos, snapshot.find("\"name\": \"small \\\"buffer\\\"\"")) <<
+      "The name isn't escaped: " << snapshot;
+  ASSERT_NE(std::string::npos, snapshot.find("\"usage\": \"host_only\"")) <<
+      "The usage isn't written: " << snapshot;
+  ASSERT_LT(snapshot.find("large buffer"), snapshot.find("small")) <<
+      "The buffers aren't sorted by the size: " << snapshot;
+
+  // The peak composition is kept after the buffers are destroyed
+  buffer2.reset();
+  ASSERT_EQ(std::size_t{1}, registry.numOfEntries()) << "Removing failed.";
+  ASSERT_EQ(total_size, registry.peakSize()) << "The peak size is wrong.";
+  registry.getPeakEntries(&entry_list);
+  ASSERT_EQ(std::size_t{2}, entry_list.size()) << "The peak composition is wrong.";
+  // A changed entry keeps its size at the peak
+  const std::size_t size1 = sizeof(uint32b) * buffer1->capacity();
+  buffer1->setSize(n / 2);
+  buffer1->shrinkToFit();
+  registry.getPeakEntries(&entry_list);
+  ASSERT_EQ(std::size_t{2}, entry_list.size()) << "The peak composition is wrong.";
+  std::size_t peak_size = 0;
+  for (const auto& entry : entry_list)
+    peak_size += entry.size_;
+  ASSERT_EQ(total_size, peak_size) << "The peak composition is wrong.";
+  ASSERT_TRUE(std::any_of(entry_list.begin(), entry_list.end(),
+  [size1](const zinvul::MemoryRegistry::Entry& entry)
+  {
+    return entry.size_ == size1;
+  })) << "The entry at the peak isn't kept.";
+  // A long file name keeps its tail
+  const std::string file_name = std::string(200, 'x') + "/memory_registry_test.cpp";
+  buffer1->id().setFileInfo(file_name.c_str(), __LINE__);
+  buffer1->setSize(n);
+  registry.getTopEntries(1, &entry_list);
+  ASSERT_EQ(zinvul::MemoryRegistry::kMaxNameLength - 1, entry_list[0].fileName().size()) <<
+      "The file name isn't truncated.";
+  ASSERT_EQ(file_name.size() - entry_list[0].fileName().size(),
+            file_name.rfind(entry_list[0].fileName())) <<
+      "The tail of the file name isn't kept.";
+  buffer1->clear();
+  ASSERT_EQ(std::size_t{0}, registry.totalSize()) << "Clearing failed.";
+  ASSERT_EQ(std::size_t{0}, device->totalMemoryUsage(0)) <<
+      "The memory usage isn't released.";
+}
+
+TEST(CpuSubPlatformTest, HugePageTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  // Large allocations are mapped with the alignment of a huge page
+  {
+    using zinvul::HugePageMemoryResource;
+    constexpr std::size_t page_size = HugePageMemoryResource::hugePageSize();
+    HugePageMemoryResource resource{zinvul::CpuHugePagePolicy::kExplicit,
+                                    page_size,
+                                    &mem_resource};
+    void* small = resource.allocate(page_size / 2, alignof(std::max_align_t));
+    void* large = resource.allocate(3 * page_size / 2, alignof(std::max_align_t));
+    ASSERT_FALSE(resource.isMapped(small)) << "A small allocation is mapped.";
+#if defined(Z_LINUX)
+    ASSERT_TRUE(resource.isMapped(large)) << "A large allocation isn't mapped.";
+    const auto address = reinterpret_cast<std::uintptr_t>(large);
+    ASSERT_EQ(0u, address % page_size) << "The memory isn't aligned to a huge page.";
+#endif // Z_LINUX
+    std::fill_n(zisc::cast<char*>(large), 3 * page_size / 2, 'z');
+    resource.deallocate(large, 3 * page_size / 2, alignof(std::max_align_t));
+    resource.deallocate(small, page_size / 2, alignof(std::max_align_t));
+    ASSERT_EQ(std::size_t{0}, resource.numOfMappedBlocks()) << "Unmapping failed.";
+  }
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "HugePageTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuHugePagePolicy(zinvul::CpuHugePagePolicy::kTransparent);
+    options.setCpuHugePageThreshold(1024 * 1024);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  using zinvul::uint32b;
+  constexpr std::size_t n = 1024 * 1024;
+  auto buffer = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  buffer->setSize(n);
+  {
+    auto mem = buffer->mapMemory();
+    for (std::size_t i = 0; i < n; ++i)
+      mem[i] = zisc::cast<uint32b>(i);
+  }
+#if defined(Z_LINUX)
+  auto cpu_buffer = zisc::cast<zinvul::CpuBuffer<uint32b>*>(buffer.get());
+  const auto address = reinterpret_cast<std::uintptr_t>(cpu_buffer->data());
+  ASSERT_EQ(0u, address % zinvul::HugePageMemoryResource::hugePageSize()) <<
+      "The buffer isn't backed by huge pages.";
+#endif // Z_LINUX
+  {
+    auto mem = buffer->mapMemory();
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(zisc::cast<uint32b>(i), mem[i]) << "Buffer memory is broken.";
+  }
+}
+
+TEST(CpuSubPlatformTest, BufferAlignmentTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "BufferAlignmentTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuBufferAlignment(100);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+  constexpr std::size_t alignment = 128;
+  ASSERT_EQ(alignment, cpu_device->bufferAlignment()) <<
+      "The alignment isn't rounded up to power of 2.";
+
+  using zinvul::uint8b;
+  std::array<zinvul::SharedBuffer<uint8b>, 4> buffer_list;
+  for (std::size_t i = 0; i < buffer_list.size(); ++i) {
+    auto& buffer = buffer_list[i];
+    buffer = device->makeBuffer<uint8b>(zinvul::BufferUsage::kDeviceOnly);
+    buffer->setSize(2 * i + 1);
+    auto cpu_buffer = zisc::cast<zinvul::CpuBuffer<uint8b>*>(buffer.get());
+    const auto address = reinterpret_cast<std::uintptr_t>(cpu_buffer->data());
+    ASSERT_EQ(0u, address % alignment) << "The buffer data isn't aligned.";
+  }
+  buffer_list[0]->setSize(4 * alignment);
+  auto cpu_buffer = zisc::cast<zinvul::CpuBuffer<uint8b>*>(buffer_list[0].get());
+  const auto address = reinterpret_cast<std::uintptr_t>(cpu_buffer->data());
+  ASSERT_EQ(0u, address % alignment) << "The reallocated data isn't aligned.";
+}
+
+TEST(CpuSubPlatformTest, FenceTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "FenceTest",
+  [](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setCpuNumOfThreads(4);
+  });
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+  auto cpu_device = zisc::cast<zinvul::CpuDevice*>(device.get());
+
+  ASSERT_TRUE(zinvul::Fence{}.isCompleted()) << "The null fence isn't signaled.";
+
+  using zinvul::uint32b;
+  constexpr uint32b num_of_commands = 8;
+  constexpr std::array<uint32b, 1> work_size{{256}};
+  std::atomic<uint32b> counter{0};
+  std::array<uint32b, num_of_commands> order_list;
+  std::array<zinvul::Fence, num_of_commands> fence_list;
+  for (uint32b i = 0; i < num_of_commands; ++i) {
+    // The command is copied into the queue
+    auto command = [&counter, &order_list, i]()
+    {
+      if (zinvul::cl::get_global_id(0) == 0)
+        order_list[i] = counter++;
+    };
+    fence_list[i] = cpu_device->submit(work_size, 0, 0, command);
+    ASSERT_EQ(i + 1, fence_list[i].number()) << "The submission number is wrong.";
+  }
+  fence_list[num_of_commands - 1].wait();
+
+  for (uint32b i = 0; i < num_of_commands; ++i) {
+    ASSERT_TRUE(fence_list[i].isCompleted()) << "Command " << i << " isn't completed.";
+    ASSERT_EQ(i, order_list[i]) << "Command " << i << " isn't executed in order.";
+  }
+  cpu_device->waitForCompletion();
+}
+
+TEST(CpuSubPlatformTest, BufferTransferTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "BufferTransferTest");
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  using zinvul::uint32b;
+  constexpr std::size_t n = 1024;
+  auto src = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostToDevice);
+  src->setSize(n);
+  auto dst = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceToHost);
+  dst->setSize(n);
+  ASSERT_EQ(zinvul::SubPlatformType::kCpu, src->type()) << "The buffer type is wrong.";
+
+  std::vector<uint32b> host_data(n);
+  for (std::size_t i = 0; i < n; ++i)
+    host_data[i] = zisc::cast<uint32b>(i);
+  src->write(host_data.data(), n, 0, 0);
+  // Copy the first half of the src to the second half of the dst
+  const auto fence = src->copyTo(dst.get(), n / 2, 0, n / 2, 0);
+  fence.wait();
+  // Copy the second half with a ranged write
+  dst->write(host_data.data() + n / 2, n / 2, 0, 0);
+
+  std::vector<uint32b> result(n / 2);
+  dst->read(result.data(), n / 2, n / 2, 0);
+  for (std::size_t i = 0; i < n / 2; ++i)
+    ASSERT_EQ(host_data[i], result[i]) << "The copied element " << i << " is wrong.";
+  dst->read(result.data(), n / 2, 0, 0);
+  for (std::size_t i = 0; i < n / 2; ++i)
+    ASSERT_EQ(host_data[n / 2 + i], result[i]) << "The written element " << i << " is wrong.";
+}
+
+TEST(CpuSubPlatformTest, MappedMemoryTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "MappedMemoryTest");
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  using zinvul::uint32b;
+  constexpr std::size_t n = 1024;
+  auto buffer = device->makeBuffer<uint32b>(zinvul::BufferUsage::kHostOnly);
+  buffer->setSize(n);
+  ASSERT_TRUE(buffer->isHostVisible()) << "The buffer isn't host visible.";
+
+  {
+    auto mem = buffer->mapMemory();
+    ASSERT_TRUE(mem) << "Buffer mapping failed.";
+    ASSERT_EQ(n, mem.size()) << "The size of the mapped memory is wrong.";
+    for (std::size_t i = 0; i < mem.size(); ++i)
+      mem[i] = zisc::cast<uint32b>(3 * i);
+  }
+
+  const auto* const_buffer = buffer.get();
+  auto mem = const_buffer->mapMemory();
+  ASSERT_TRUE(mem) << "Buffer mapping failed.";
+  std::vector<uint32b> result(n);
+  buffer->read(result.data(), n, 0, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(3 * i, mem[i]) << "The mapped element " << i << " is wrong.";
+    ASSERT_EQ(mem[i], result[i]) << "The read element " << i << " is wrong.";
+  }
+  mem.unmap();
+  ASSERT_FALSE(mem) << "Buffer unmapping failed.";
+}
+
+TEST(CpuSubPlatformTest, BufferCapacityTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+
+  auto [platform, device] = makeCpuDevice(&mem_resource, "BufferCapacityTest");
+  ASSERT_TRUE(device) << "CPU initialization failed.";
+
+  using zinvul::uint32b;
+  constexpr std::size_t n = 1024;
+  auto buffer = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  buffer->reserve(n);
+  ASSERT_EQ(std::size_t{0}, buffer->size()) << "Reserving changed the size.";
+  ASSERT_LE(n, buffer->capacity()) << "Reserving failed.";
+
+  std::vector<uint32b> host_data(n);
+  for (std::size_t i = 0; i < n; ++i)
+    host_data[i] = zisc::cast<uint32b>(i);
+  buffer->setSize(n);
+  buffer->write(host_data.data(), n, 0, 0);
+  const std::size_t cap = buffer->capacity();
+
+  // Shrinking and growing within the capacity keep the memory
+  buffer->setSize(n / 4);
+  ASSERT_EQ(cap, buffer->capacity()) << "Shrinking reallocated the memory.";
+  buffer->setSize(n);
+  ASSERT_EQ(cap, buffer->capacity()) << "Growing reallocated the memory.";
+
+  buffer->setSize(n / 4);
+  buffer->shrinkToFit();
+  ASSERT_EQ(n / 4, buffer->capacity()) << "Shrinking to fit failed.";
+  std::vector<uint32b> result(n / 4);
+  buffer->read(result.data(), n / 4, 0, 0);
+  for (std::size_t i = 0; i < n / 4; ++i)
+    ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " isn't kept.";
+}
+
 #if defined(ZINVUL_ENABLE_VULKAN_SUB_PLATFORM)
 
 TEST(VulkanSubPlatformTest, GetInstanceProcAddrOptionTest)
@@ -137,6 +1364,149 @@ TEST(VulkanSubPlatformTest, InstanceOptionTest)
   dispatch_loader.reset();
 }
 
+TEST(VulkanSubPlatformTest, BufferEvictionTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+  using zinvul::uint32b;
+  using BufferType = zinvul::VulkanBuffer<uint32b>;
+  constexpr std::size_t n = 16 * 1024 * 1024;
+  constexpr std::size_t memory_size = sizeof(uint32b) * n;
+
+  // Measure the usage of the heap of device-only buffers
+  double budget_ratio = 0.0;
+  {
+    auto [platform, device] = makeVulkanDevice(&mem_resource, "BufferEvictionTest");
+    ASSERT_TRUE(device) << "Vulkan initialization failed.";
+    auto vulkan_device = zisc::cast<zinvul::VulkanDevice*>(device.get());
+    auto probe = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+    probe->setSize(1);
+
+    const auto& mem_props = vulkan_device->deviceInfoData().memoryProperties().properties1_;
+    bool has_host_heap = false;
+    for (uint32b i = 0; i < mem_props.memoryHeapCount; ++i) {
+      if (!(mem_props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+        has_host_heap = true;
+    }
+    // A device without a host heap doesn't evict buffers
+    if (!has_host_heap || !probe->isDeviceLocal())
+      return;
+    const auto& info = zisc::cast<BufferType*>(probe.get())->allocationInfo();
+    const std::size_t heap_index = mem_props.memoryTypes[info.memoryType].heapIndex;
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budget_list;
+    vmaGetBudget(vulkan_device->memoryAllocator(), budget_list.data());
+    const auto& budget = budget_list[heap_index];
+    // The budget fits only one of the buffers
+    budget_ratio = zisc::cast<double>(budget.usage + (3 * memory_size) / 2) /
+                   zisc::cast<double>(budget.budget);
+    if (1.0 < budget_ratio)
+      return;
+  }
+
+  auto [platform, device] = makeVulkanDevice(&mem_resource, "BufferEvictionTest",
+  [budget_ratio](zinvul::PlatformOptions& options) noexcept
+  {
+    options.setVulkanMemoryBudgetRatio(budget_ratio);
+  });
+  ASSERT_TRUE(device) << "Vulkan initialization failed.";
+  auto probe = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  probe->setSize(1);
+
+  std::vector<uint32b> host_data;
+  host_data.resize(n);
+  std::iota(host_data.begin(), host_data.end(), 0u);
+  auto buffer1 = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  buffer1->setSize(n);
+  ASSERT_TRUE(buffer1->isDeviceLocal()) << "The buffer isn't in device memory.";
+  buffer1->write(host_data.data(), n, 0, 0);
+
+  // The allocation of the second buffer evicts the least recently used one
+  auto buffer2 = device->makeBuffer<uint32b>(zinvul::BufferUsage::kDeviceOnly);
+  buffer2->setSize(n);
+  ASSERT_TRUE(buffer2->isDeviceLocal()) << "The buffer isn't in device memory.";
+  ASSERT_FALSE(buffer1->isDeviceLocal()) << "The buffer isn't evicted.";
+
+  std::vector<uint32b> result;
+  result.resize(n);
+  buffer1->read(result.data(), n, 0, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " isn't kept.";
+}
+
+TEST(VulkanSubPlatformTest, FramePoolTest)
+{
+  zisc::SimpleMemoryResource mem_resource;
+  auto [platform, device] = makeVulkanDevice(&mem_resource, "FramePoolTest");
+  ASSERT_TRUE(device) << "Vulkan initialization failed.";
+  auto vulkan_device = zisc::cast<zinvul::VulkanDevice*>(device.get());
+
+  using zinvul::uint32b;
+  using BufferType = zinvul::VulkanBuffer<uint32b>;
+  constexpr std::size_t n = 1024;
+  std::vector<uint32b> host_data;
+  host_data.resize(n);
+  std::iota(host_data.begin(), host_data.end(), 0u);
+  std::vector<uint32b> result;
+  result.resize(n);
+
+  const std::array<zinvul::BufferUsage, 4> usage_list{{
+      zinvul::BufferUsage::kDeviceOnly,
+      zinvul::BufferUsage::kHostOnly,
+      zinvul::BufferUsage::kHostToDevice,
+      zinvul::BufferUsage::kDeviceToHost}};
+  for (const auto usage : usage_list) {
+    // Small buffers of a usage are sub-allocated from the pool of the usage
+    auto a = device->makeBuffer<uint32b>(usage);
+    a->setSize(n);
+    auto b = device->makeBuffer<uint32b>(usage);
+    b->setSize(n);
+    {
+      const auto& info_a = zisc::cast<BufferType*>(a.get())->allocationInfo();
+      const auto& info_b = zisc::cast<BufferType*>(b.get())->allocationInfo();
+      ASSERT_EQ(info_a.deviceMemory, info_b.deviceMemory)
+          << "The buffers aren't allocated from the pool.";
+    }
+    a->write(host_data.data(), n, 0, 0);
+    a->read(result.data(), n, 0, 0);
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " is wrong.";
+
+    // Frame buffers are ranges of a frame block
+    auto frame_a = vulkan_device->makeFrameBuffer<uint32b>(usage);
+    frame_a->setSize(n);
+    auto frame_b = vulkan_device->makeFrameBuffer<uint32b>(usage);
+    frame_b->setSize(n);
+    auto frame_buffer_a = zisc::cast<BufferType*>(frame_a.get());
+    auto frame_buffer_b = zisc::cast<BufferType*>(frame_b.get());
+    ASSERT_TRUE(frame_buffer_a->isFrameBuffer()) << "The buffer isn't a frame buffer.";
+    ASSERT_EQ(frame_buffer_a->buffer(), frame_buffer_b->buffer())
+        << "The frame buffers aren't in the same block.";
+    ASSERT_LE(frame_buffer_a->offset() + sizeof(uint32b) * n, frame_buffer_b->offset())
+        << "The frame buffers overlap.";
+    frame_b->write(host_data.data(), n, 0, 0);
+    frame_b->read(result.data(), n, 0, 0);
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " is wrong.";
+
+    // The reset clears the live frame buffers
+    vulkan_device->resetFramePool();
+    for (const auto* frame_buffer : {frame_buffer_a, frame_buffer_b}) {
+      ASSERT_EQ(0u, frame_buffer->size()) << "The frame buffer isn't cleared.";
+      ASSERT_EQ(0u, frame_buffer->capacity()) << "The frame buffer isn't cleared.";
+      ASSERT_EQ(VK_NULL_HANDLE, frame_buffer->buffer())
+          << "The frame buffer refers the frame block.";
+    }
+
+    // A cleared frame buffer is allocated from the reset pool again
+    frame_a->setSize(n);
+    ASSERT_EQ(0u, frame_buffer_a->offset()) << "The frame pool isn't reset.";
+    frame_a->write(host_data.data(), n, 0, 0);
+    frame_a->read(result.data(), n, 0, 0);
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(host_data[i], result[i]) << "The element " << i << " is wrong.";
+    vulkan_device->resetFramePool();
+  }
+}
+
 #endif // ZINVUL_ENABLE_VULKAN_SUB_PLATFORM
 
 //TEST(Experiment, ZinvulTest)